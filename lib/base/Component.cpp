@@ -22,12 +22,15 @@
 
 #include <chrono>
 #include <exception>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 #include <thread>
 
 #include <boost/interprocess/exceptions.hpp>
 
+#include "../../lib/shmemdf/Interrupt.h"
+#include "../../lib/utility/IOFormat.h"
 #include "../../lib/utility/ZMQHelpers.h"
 
 namespace oat {
@@ -39,12 +42,19 @@ volatile sig_atomic_t quit = 0;
 static void sigHandler(int)
 {
     quit = 1;
+
+    // Release threads blocked on shared memory nodes
+    oat::interruptWaits();
 }
 
 Component::Component()
 {
     // Install Ctrl-c signal handler
     std::signal(SIGINT, sigHandler);
+
+    // Affinity to return helper threads to when they are not pinned
+    if (sched_getaffinity(0, sizeof(initial_cpus_), &initial_cpus_) != 0)
+        CPU_ZERO(&initial_cpus_);
 }
 
 void Component::run()
@@ -55,6 +65,12 @@ void Component::run()
 
 void Component::runComponent()
 {
+    if (scheduling_.mlock)
+        lockProcessMemory(name());
+
+    if (!scheduling_.process.isDefault())
+        applyThreadScheduling(scheduling_.process, initial_cpus_, name());
+
     try {
 
         // TODO: throw "could not connect to node?"
@@ -62,17 +78,67 @@ void Component::runComponent()
             return;
 
         bool end_of_stream = false;
-        while (!end_of_stream && !quit) {
-            end_of_stream = process();
+        if (profiler_) {
+            Profiler::set_current(profiler_.get());
+            while (!end_of_stream && !quit) {
+                profiler_->beginIteration();
+                end_of_stream = process();
+                profiler_->endIteration();
+            }
+            Profiler::set_current(nullptr);
+        } else {
+            while (!end_of_stream && !quit) {
+                end_of_stream = process();
+            }
         }
 
     } catch (const boost::interprocess::interprocess_exception &ex) {
 
+        Profiler::set_current(nullptr);
+
         // Error code 1 indicates a SIGINT during a call to wait(),
         // which is normal behavior
         if (ex.get_error_code() != 1)
             throw;
     }
+
+    if (profiler_)
+        writeProfile();
+}
+
+void Component::set_profile(const std::string &path)
+{
+    profiler_.reset(new Profiler);
+    profile_path_ = path;
+}
+
+void Component::writeProfile() const
+{
+    const std::string json = profiler_->toJSON(name());
+
+    if (profile_path_.empty()) {
+        std::cout << json << "\n";
+        return;
+    }
+
+    std::ofstream file(profile_path_);
+    if (!file.is_open()) {
+        std::cerr << oat::whoWarn(name(), "could not write profile to "
+                                  + profile_path_ + ".\n");
+        return;
+    }
+
+    file << json << "\n";
+}
+
+void Component::scheduleHelperThread()
+{
+    // Helper threads inherit the scheduling of the thread that created them,
+    // so they must be reset even if they have no policy of their own
+    if (scheduling_.process.isDefault() && scheduling_.helper.isDefault())
+        return;
+
+    applyThreadScheduling(scheduling_.helper, initial_cpus_, name());
 }
 
 } /* namespace oat */
@@ -25,11 +25,14 @@
 #include <string>
 #include <cstring>
 #include <map>
+#include <memory>
 
 #include <boost/program_options.hpp>
 #include <zmq.hpp>
 
 #include "Globals.h"
+#include "Profiler.h"
+#include "Scheduling.h"
 
 namespace oat {
 
@@ -76,6 +79,21 @@ public:
      */
     virtual oat::ComponentType type(void) const = 0;
 
+    /**
+     * @brief Set the CPU affinity, real-time priority and memory locking of
+     * the component's threads. Applied when the processing loop starts.
+     * @param scheduling Scheduling of the processing and helper threads.
+     */
+    void set_scheduling(const Scheduling &scheduling) { scheduling_ = scheduling; }
+
+    /**
+     * @brief Time each iteration of the processing loop, split into source
+     * wait, source critical section, compute, sink wait and sink critical
+     * section, and write the resulting histograms as JSON on exit.
+     * @param path File to write the profile to. Standard output if empty.
+     */
+    void set_profile(const std::string &path);
+
 protected:
 
     /**
@@ -95,6 +113,26 @@ protected:
      * @return Return code. 0 = More. 1 = End of stream.
      */
     virtual int process(void) = 0;
+
+    /**
+     * @brief Apply the helper thread scheduling to the calling thread. Helper
+     * threads (control, display, file writing) call this when they start.
+     */
+    void scheduleHelperThread(void);
+
+    /**
+     * @brief Processing loop profile.
+     * @return Profile, or nullptr if profiling is disabled.
+     */
+    const Profiler *profiler(void) const { return profiler_.get(); }
+
+private:
+    Scheduling scheduling_;
+    cpu_set_t initial_cpus_; //!< CPU affinity at construction
+    std::unique_ptr<Profiler> profiler_;
+    std::string profile_path_;
+
+    void writeProfile(void) const;
 };
 }      /* namespace oat */
 #endif /* OAT_COMPONENT_H */
@@ -28,7 +28,11 @@
 #include <boost/program_options.hpp>
 #include <zmq.hpp>
 
+#include "../shmemdf/Helpers.h"
+#include "../utility/ProgramOptions.h"
 #include "../utility/TOMLSanitize.h"
+#include "Component.h"
+#include "Scheduling.h"
 
 namespace oat {
 
@@ -64,6 +68,18 @@ public:
                 ;
         }
 
+        // Thread scheduling, which can also be set in the config file
+        auto sched_options = oat::config::schedulingOptions();
+        opts.add(sched_options);
+        for (auto &o : sched_options.options())
+            config_keys_.push_back(o->long_name());
+
+        // Processing loop profiling
+        auto profile_options = oat::config::profileOptions();
+        opts.add(profile_options);
+        for (auto &o : profile_options.options())
+            config_keys_.push_back(o->long_name());
+
         // Get type-specific options
         auto local_options = options();
         opts.add(local_options);
@@ -83,6 +99,17 @@ public:
         auto config_table = oat::config::getConfigTable(vm);
         oat::config::checkKeys(config_keys_, config_table);
 
+        // Scheduling must be known before applyConfiguration(), which may
+        // start helper threads
+        auto component = dynamic_cast<Component *>(this);
+        if (component != nullptr) {
+            component->set_scheduling(getScheduling(vm, config_table));
+
+            std::string profile_path;
+            if (oat::config::getValue(vm, config_table, "profile", profile_path))
+                component->set_profile(profile_path);
+        }
+
         // Concrete component uses configuration map to configure itself
         applyConfiguration(vm, config_table);
     }
@@ -103,8 +130,66 @@ protected:
     virtual void applyConfiguration(const po::variables_map &vm,
                                     const config::OptionTable &config_table) = 0;
 
+    /**
+     * @brief Get the source synchronization options added to options() by
+     * oat::config::syncOptions().
+     * @param vm Pre-parse program option map.
+     * @param config_table Parsed TOML options table.
+     */
+    static SyncConfig getSyncConfig(const po::variables_map &vm,
+                                    const config::OptionTable &config_table)
+    {
+        SyncConfig s;
+
+        std::string key;
+        if (oat::config::getValue(vm, config_table, "sync", key)) {
+            if (key == "count")
+                s.key = SyncKey::COUNT;
+            else if (key == "usec")
+                s.key = SyncKey::MICROSECONDS;
+            else if (key != "none")
+                throw std::runtime_error("Unrecognized sync value '" + key
+                                         + "'.");
+        }
+
+        int64_t tolerance = 0;
+        oat::config::getNumericValue<int64_t>(
+            vm, config_table, "sync-tolerance", tolerance, 0);
+        s.tolerance = tolerance;
+
+        int window = s.window;
+        oat::config::getNumericValue<int>(
+            vm, config_table, "sync-window", window, 1);
+        s.window = window;
+
+        return s;
+    }
+
     // Allowable configuration keys
     std::vector<std::string> config_keys_;
+
+private:
+    static Scheduling getScheduling(const po::variables_map &vm,
+                                    const config::OptionTable &config_table)
+    {
+        Scheduling s;
+        oat::config::getArray<int>(vm, config_table, "cpu", s.process.cpus);
+        oat::config::getNumericValue<int>(
+            vm, config_table, "rt-priority", s.process.rt_priority, 0, 99);
+        oat::config::getArray<int>(vm, config_table, "helper-cpu", s.helper.cpus);
+        oat::config::getNumericValue<int>(
+            vm, config_table, "helper-rt-priority", s.helper.rt_priority, 0, 99);
+        oat::config::getValue<bool>(vm, config_table, "mlock", s.mlock);
+
+        auto cpus = s.process.cpus;
+        cpus.insert(cpus.end(), s.helper.cpus.begin(), s.helper.cpus.end());
+        for (auto c : cpus)
+            if (c < 0 || c >= CPU_SETSIZE)
+                throw std::runtime_error("CPU " + std::to_string(c)
+                                         + " is not valid.");
+
+        return s;
+    }
 };
 
 }      /* namespace oat */
@@ -29,6 +29,7 @@
 
 #include <boost/interprocess/exceptions.hpp>
 
+#include "../../lib/shmemdf/Interrupt.h"
 #include "../../lib/utility/ZMQHelpers.h"
 
 namespace oat {
@@ -63,6 +64,8 @@ void ControllableComponent::run()
 
 void ControllableComponent::runController(const char *endpoint)
 {
+    scheduleHelperThread();
+
     zmq::context_t ctx(1);
 
     try {
@@ -86,6 +89,10 @@ void ControllableComponent::runController(const char *endpoint)
                 auto command = oat::recvString(ctrl_socket);
                 quit = control(command);
 
+                // Release threads blocked on shared memory nodes
+                if (quit)
+                    oat::interruptWaits();
+
             } else {
                 // If we did not get a reply on this socket
                 // REQUEST_TIMEOUT_MS, tear it down and make a new one
@@ -115,6 +122,8 @@ int ControllableComponent::control(const std::string &command)
 {
     if (command == "quit" || command == "Quit") {
         return 1;
+    } else if (command == "stats" && profiler()) {
+        std::cout << profiler()->toJSON(name()) << std::endl;
     } else {
 
         // Check that command is in hash
@@ -134,6 +143,8 @@ std::string ControllableComponent::whoAmI()
     whoami << "\"type\":" << std::to_string(static_cast<uint16_t>(type())) << ",";
 
     auto cmds = commands();
+    if (profiler())
+        cmds.emplace("stats", "Print the processing loop profile as JSON.");
     if (!cmds.empty()) {
 
         whoami << "\"commands\":{";
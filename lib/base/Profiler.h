@@ -0,0 +1,360 @@
+//******************************************************************************
+//* File:   Profiler.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_PROFILER_H
+#define OAT_PROFILER_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+#include "../datatypes/Sample.h"
+
+namespace oat {
+
+// A component's processing thread can be profiled to find out where each
+// iteration of its processing loop spends its time. Sources and sinks report
+// when they start and stop waiting and when their critical sections begin and
+// end to the profiler of the calling thread, if there is one, and the
+// remainder of each iteration is counted as compute time. Unlike the node
+// telemetry shown by oat-stats, which is kept per node, the profile is kept
+// per component and its stages never overlap: time spent waiting on a sink
+// while holding a source is counted as sink wait time, and so on.
+//
+// The profiler also collects the latency trace of each sample that the
+// component publishes (see Sample::stamp()): the time between consecutive
+// stamps, i.e. the latency of each hop, and the time from the first stamp to
+// the last. Stamps are taken on the steady clock, so the trace is only
+// meaningful for components that run on the same host.
+
+/**
+ * @brief Histogram of durations in log-linear bins, as in HDR histograms.
+ * Each power of two is split into 2^SUB_BITS bins, so durations are resolved
+ * to within ~6%. Written by a single thread and read by any thread without
+ * locking.
+ */
+class ProfileHistogram {
+public:
+
+    static constexpr size_t SUB_BITS {4};
+    static constexpr size_t SUB_BINS {1 << SUB_BITS};
+    static constexpr size_t MAX_BITS {36}; //!< Durations up to ~68 sec
+    static constexpr size_t NUM_BINS {(MAX_BITS - SUB_BITS + 1) * SUB_BINS};
+
+    ProfileHistogram()
+    {
+        for (auto &b : bins_)
+            b.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Add a duration. Must only be called by one thread.
+     */
+    void add(const uint64_t ns)
+    {
+        increment(bins_[bin(ns)]);
+        increment(count_);
+        total_ns_.store(total_ns_.load(std::memory_order_relaxed) + ns,
+                        std::memory_order_relaxed);
+        if (ns > max_ns_.load(std::memory_order_relaxed))
+            max_ns_.store(ns, std::memory_order_relaxed);
+    }
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t total_ns() const { return total_ns_.load(std::memory_order_relaxed); }
+    uint64_t max_ns() const { return max_ns_.load(std::memory_order_relaxed); }
+    uint64_t bin_count(const size_t i) const
+    {
+        return bins_[i].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Upper edge of the bin that contains a percentile.
+     * @param p Percentile, between 0 and 1.
+     * @return Duration in nanoseconds, or 0 if the histogram is empty.
+     */
+    uint64_t percentile_ns(const double p) const
+    {
+        const uint64_t n = count();
+        if (n == 0)
+            return 0;
+
+        uint64_t cum = 0;
+        for (size_t i = 0; i < NUM_BINS; i++) {
+            cum += bin_count(i);
+            if (cum >= p * n)
+                return std::min(upper_ns(i), max_ns());
+        }
+
+        return max_ns();
+    }
+
+    static size_t bin(uint64_t ns)
+    {
+        ns = std::min<uint64_t>(ns, (1ull << MAX_BITS) - 1);
+        if (ns < SUB_BINS)
+            return ns;
+
+        const size_t msb = 63 - __builtin_clzll(ns);
+        const size_t shift = msb - SUB_BITS;
+        return (shift + 1) * SUB_BINS + ((ns >> shift) & (SUB_BINS - 1));
+    }
+
+    static uint64_t lower_ns(const size_t i)
+    {
+        if (i < SUB_BINS)
+            return i;
+
+        const size_t shift = i / SUB_BINS - 1;
+        return (SUB_BINS + i % SUB_BINS) << shift;
+    }
+
+    static uint64_t upper_ns(const size_t i)
+    {
+        return i < SUB_BINS ? i + 1 : lower_ns(i) + (1ull << (i / SUB_BINS - 1));
+    }
+
+private:
+
+    static void increment(std::atomic<uint64_t> &a)
+    {
+        a.store(a.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> bins_[NUM_BINS];
+    std::atomic<uint64_t> count_ {0};
+    std::atomic<uint64_t> total_ns_ {0};
+    std::atomic<uint64_t> max_ns_ {0};
+};
+
+/**
+ * @brief Times each iteration of a component's processing loop, broken into
+ * stages. See Component::set_profile().
+ */
+class Profiler {
+public:
+
+    enum Stage : size_t {
+        SOURCE_WAIT = 0,  //!< Blocked in a source's wait()
+        SOURCE_CRITICAL,  //!< Between a source's wait() and post()
+        COMPUTE,          //!< Everything else
+        SINK_WAIT,        //!< Blocked in a sink's wait()
+        SINK_CRITICAL,    //!< Between a sink's wait() and post()
+        NUM_STAGES
+    };
+
+    /**
+     * @brief The profiler of the calling thread.
+     * @return Profiler, or nullptr if the thread is not being profiled.
+     */
+    static Profiler *current() { return currentRef(); }
+
+    /**
+     * @brief Profile the calling thread.
+     * @param profiler Profiler, or nullptr to stop profiling.
+     */
+    static void set_current(Profiler *profiler) { currentRef() = profiler; }
+
+    void beginIteration()
+    {
+        const uint64_t now = nowNs();
+        for (auto &s : stage_ns_)
+            s = 0;
+        iteration_begin_ns_ = now;
+        last_ns_ = now;
+        in_iteration_ = true;
+    }
+
+    void endIteration()
+    {
+        const uint64_t now = nowNs();
+        flush(now);
+        in_iteration_ = false;
+
+        for (size_t i = 0; i < NUM_STAGES; i++)
+            stages_[i].add(stage_ns_[i]);
+        iterations_.add(now - iteration_begin_ns_);
+    }
+
+    // Events reported by sources and sinks. A wait that completes is
+    // followed by beginCritical().
+    void beginWait(const bool sink) { transition(); waiting_ = sink ? 2 : 1; }
+    void endWait() { transition(); waiting_ = 0; }
+    void beginCritical(const bool sink)
+    {
+        transition();
+        (sink ? sink_holds_ : source_holds_)++;
+    }
+    void endCritical(const bool sink)
+    {
+        transition();
+        auto &holds = sink ? sink_holds_ : source_holds_;
+        if (holds > 0)
+            holds--;
+    }
+
+    /**
+     * @brief Add the latency trace of a sample that has just been stamped.
+     * Must only be called by the profiled thread.
+     */
+    void traceSample(const Sample &sample)
+    {
+        const size_t n = sample.num_stamps();
+        if (n < 2)
+            return;
+
+        for (size_t i = 1; i < n; i++)
+            hops_[i - 1].add(sample.stamp_ns(i) - sample.stamp_ns(i - 1));
+        end_to_end_.add(sample.stamp_ns(n - 1) - sample.stamp_ns(0));
+    }
+
+    const ProfileHistogram &stage(const Stage s) const { return stages_[s]; }
+    const ProfileHistogram &iterations() const { return iterations_; }
+    const ProfileHistogram &hop(const size_t i) const { return hops_[i]; }
+    const ProfileHistogram &endToEnd() const { return end_to_end_; }
+
+    static const char *stageName(const Stage s)
+    {
+        static const char *names[NUM_STAGES] = {"source_wait",
+                                                "source_critical",
+                                                "compute",
+                                                "sink_wait",
+                                                "sink_critical"};
+        return names[s];
+    }
+
+    /**
+     * @brief Serialize the histograms as JSON. Safe to call from any thread
+     * while the profiled thread is running.
+     * @param name Component name.
+     */
+    std::string toJSON(const std::string &name) const
+    {
+        std::stringstream json;
+        json << "{\"name\":\"" << name << "\",";
+        json << "\"iteration\":";
+        histogramJSON(json, iterations_);
+        json << ",\"stages\":{";
+        for (size_t i = 0; i < NUM_STAGES; i++) {
+            json << (i > 0 ? "," : "") << "\""
+                 << stageName(static_cast<Stage>(i)) << "\":";
+            histogramJSON(json, stages_[i]);
+        }
+        json << "}";
+
+        // Latency of each hop, counted from the frame server
+        if (end_to_end_.count() > 0) {
+            json << ",\"latency\":{\"end_to_end\":";
+            histogramJSON(json, end_to_end_);
+            json << ",\"hops\":[";
+            for (size_t i = 0; i < NUM_HOPS && hops_[i].count() > 0; i++) {
+                json << (i > 0 ? "," : "");
+                histogramJSON(json, hops_[i]);
+            }
+            json << "]}";
+        }
+        json << "}";
+
+        return json.str();
+    }
+
+private:
+
+    static Profiler *&currentRef()
+    {
+        static thread_local Profiler *profiler = nullptr;
+        return profiler;
+    }
+
+    static uint64_t nowNs()
+    {
+        using namespace std::chrono;
+        return duration_cast<nanoseconds>(
+                   steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Stage that the thread is in. Waits take precedence over critical
+    // sections, and sink critical sections over source ones.
+    Stage stage() const
+    {
+        if (waiting_ != 0)
+            return waiting_ == 2 ? SINK_WAIT : SOURCE_WAIT;
+        if (sink_holds_ > 0)
+            return SINK_CRITICAL;
+        if (source_holds_ > 0)
+            return SOURCE_CRITICAL;
+        return COMPUTE;
+    }
+
+    void flush(const uint64_t now)
+    {
+        if (in_iteration_)
+            stage_ns_[stage()] += now - last_ns_;
+        last_ns_ = now;
+    }
+
+    void transition() { flush(nowNs()); }
+
+    static void histogramJSON(std::stringstream &json, const ProfileHistogram &h)
+    {
+        json << "{\"count\":" << h.count()
+             << ",\"total_us\":" << h.total_ns() / 1e3
+             << ",\"mean_us\":" << (h.count() ? h.total_ns() / 1e3 / h.count() : 0.0)
+             << ",\"p50_us\":" << h.percentile_ns(0.5) / 1e3
+             << ",\"p90_us\":" << h.percentile_ns(0.9) / 1e3
+             << ",\"p99_us\":" << h.percentile_ns(0.99) / 1e3
+             << ",\"p999_us\":" << h.percentile_ns(0.999) / 1e3
+             << ",\"max_us\":" << h.max_ns() / 1e3
+             << ",\"bins\":[";
+
+        // Non-empty bins as [lower edge in ns, count]
+        bool first = true;
+        for (size_t i = 0; i < ProfileHistogram::NUM_BINS; i++) {
+            const uint64_t n = h.bin_count(i);
+            if (n == 0)
+                continue;
+            json << (first ? "" : ",") << "[" << ProfileHistogram::lower_ns(i)
+                 << "," << n << "]";
+            first = false;
+        }
+        json << "]}";
+    }
+
+    ProfileHistogram stages_[NUM_STAGES];
+    ProfileHistogram iterations_;
+
+    // Sample latency trace
+    static constexpr size_t NUM_HOPS {Sample::MAX_STAMPS - 1};
+    ProfileHistogram hops_[NUM_HOPS];
+    ProfileHistogram end_to_end_;
+
+    // State of the current iteration. Only used by the profiled thread.
+    uint64_t stage_ns_[NUM_STAGES] {0};
+    uint64_t iteration_begin_ns_ {0}, last_ns_ {0};
+    bool in_iteration_ {false};
+    int waiting_ {0}; //!< 0: not waiting, 1: on a source, 2: on a sink
+    int source_holds_ {0}, sink_holds_ {0};
+};
+
+}      /* namespace oat */
+#endif /* OAT_PROFILER_H */
@@ -0,0 +1,72 @@
+//******************************************************************************
+//* File:   Scheduling.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#include "Scheduling.h"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include <pthread.h>
+#include <sys/mman.h>
+
+#include "../../lib/utility/IOFormat.h"
+
+namespace oat {
+
+void applyThreadScheduling(const ThreadScheduling &s,
+                           const cpu_set_t &fallback_cpus,
+                           const std::string &who)
+{
+    cpu_set_t cpus;
+    if (s.cpus.empty()) {
+        cpus = fallback_cpus;
+    } else {
+        CPU_ZERO(&cpus);
+        for (auto c : s.cpus)
+            CPU_SET(c, &cpus);
+    }
+
+    int rc = CPU_COUNT(&cpus) == 0
+           ? 0 : pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    if (rc != 0)
+        std::cerr << oat::whoWarn(who, "could not set CPU affinity: "
+                     + std::string(std::strerror(rc)) + ".\n");
+
+    struct sched_param param;
+    param.sched_priority = s.rt_priority;
+    rc = pthread_setschedparam(pthread_self(),
+                               s.rt_priority > 0 ? SCHED_FIFO : SCHED_OTHER,
+                               &param);
+    if (rc != 0)
+        std::cerr << oat::whoWarn(who, "could not set real-time priority "
+                     + std::to_string(s.rt_priority) + ": "
+                     + std::strerror(rc) + ". Check CAP_SYS_NICE or "
+                     "RLIMIT_RTPRIO.\n");
+}
+
+void lockProcessMemory(const std::string &who)
+{
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+        std::cerr << oat::whoWarn(who, "could not lock memory into RAM: "
+                     + std::string(std::strerror(errno)) + ". Check "
+                     "RLIMIT_MEMLOCK.\n");
+}
+
+} /* namespace oat */
@@ -0,0 +1,76 @@
+//******************************************************************************
+//* File:   Scheduling.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_SCHEDULING_H
+#define OAT_SCHEDULING_H
+
+#include <string>
+#include <vector>
+
+#include <sched.h>
+
+namespace oat {
+
+/**
+ * @brief CPU affinity and real-time priority of a thread.
+ */
+struct ThreadScheduling {
+
+    std::vector<int> cpus;  //!< CPUs the thread may run on. Empty for any.
+    int rt_priority {0};    //!< SCHED_FIFO priority, 0 for SCHED_OTHER
+
+    bool isDefault() const { return cpus.empty() && rt_priority == 0; }
+};
+
+/**
+ * @brief Scheduling of a component's threads. The processing thread runs
+ * Component::process(). Helper threads (control, display, file writing) are
+ * scheduled separately so that they can be kept off of the processing
+ * thread's CPUs.
+ */
+struct Scheduling {
+
+    ThreadScheduling process;
+    ThreadScheduling helper;
+    bool mlock {false}; //!< Lock all process memory into RAM
+};
+
+/**
+ * @brief Apply a scheduling policy to the calling thread. Failures, usually
+ * due to missing privileges, are reported as warnings.
+ * @param s Scheduling policy.
+ * @param fallback_cpus CPU mask to use if the policy does not specify CPUs.
+ * Threads inherit the CPUs of the thread that created them, so this is used
+ * to return a helper thread to the CPUs the process started with. If it
+ * is empty, affinity is left unchanged.
+ * @param who Name used in warnings.
+ */
+void applyThreadScheduling(const ThreadScheduling &s,
+                           const cpu_set_t &fallback_cpus,
+                           const std::string &who);
+
+/**
+ * @brief Lock all current and future pages of the process into RAM.
+ * Failures are reported as warnings.
+ * @param who Name used in warnings.
+ */
+void lockProcessMemory(const std::string &who);
+
+}      /* namespace oat */
+#endif /* OAT_SCHEDULING_H */
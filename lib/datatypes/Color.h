@@ -30,24 +30,54 @@ enum PixelColor {
     PIX_BINARY = 0,
     PIX_GREY,
     PIX_BGR, // Default
-    PIX_HSV
+    PIX_HSV,
+    PIX_BAYER_RG, // Raw 8-bit Bayer mosaics, named by their top-left 2x2 block
+    PIX_BAYER_GB,
+    PIX_BAYER_GR,
+    PIX_BAYER_BG,
+    PIX_GREY12, // 12-bit greyscale in the low bits of 16-bit pixels
+    PIX_GREY16
 };
 
 // Used conversion structures
-static const int color_2_cvtype[4]{CV_8UC1, CV_8UC1, CV_8UC3, CV_8UC3};
-static const int color_2_bytes[4]{1, 1, 3, 3};
+static const int color_2_cvtype[10]{CV_8UC1, CV_8UC1, CV_8UC3, CV_8UC3,
+                                    CV_8UC1, CV_8UC1, CV_8UC1, CV_8UC1,
+                                    CV_16UC1, CV_16UC1};
+static const int color_2_bytes[10]{1, 1, 3, 3, 1, 1, 1, 1, 2, 2};
+static const int color_2_bits[10]{8, 8, 8, 8, 8, 8, 8, 8, 12, 16};
 
-static const int color_2_imread_code[4]{
-    -2, cv::IMREAD_GRAYSCALE, cv::IMREAD_COLOR, -2};
+// Image files hold raw Bayer mosaics as greyscale
+static const int color_2_imread_code[10]{
+    -2, cv::IMREAD_GRAYSCALE, cv::IMREAD_COLOR, -2,
+    cv::IMREAD_GRAYSCALE, cv::IMREAD_GRAYSCALE,
+    cv::IMREAD_GRAYSCALE, cv::IMREAD_GRAYSCALE,
+    cv::IMREAD_ANYDEPTH, cv::IMREAD_ANYDEPTH};
 
 // Arguments are from/to PixelColors
 // -1 = No conversion needed
 // -2 = Conversion not possible
-static const int color_conv_table[4][4]{
-    {-1, -1, cv::COLOR_GRAY2BGR, -2}, // From BINARY
-    {-1, -1, cv::COLOR_GRAY2BGR, -2}, // From GREY
-    {cv::COLOR_BGR2GRAY, cv::COLOR_BGR2GRAY, -1, cv::COLOR_BGR2HSV}, // From BGR
-    {-2, -2, cv::COLOR_HSV2BGR, -1}, // From HSV
+// -3 = Scale to 8-bit, see convert_color()
+//
+// OpenCV names Bayer patterns by the second and third pixels of its second
+// row rather than by the top-left 2x2 block, e.g. an RGGB mosaic is
+// cv::COLOR_BayerBG
+static const int color_conv_table[10][10]{
+    // BINARY, GREY, BGR, HSV, BAYER_RG, BAYER_GB, BAYER_GR, BAYER_BG, GREY12, GREY16
+    {-1, -1, cv::COLOR_GRAY2BGR, -2, -2, -2, -2, -2, -2, -2}, // From BINARY
+    {-1, -1, cv::COLOR_GRAY2BGR, -2, -2, -2, -2, -2, -2, -2}, // From GREY
+    {cv::COLOR_BGR2GRAY, cv::COLOR_BGR2GRAY, -1, cv::COLOR_BGR2HSV,
+     -2, -2, -2, -2, -2, -2}, // From BGR
+    {-2, -2, cv::COLOR_HSV2BGR, -1, -2, -2, -2, -2, -2, -2}, // From HSV
+    {-2, cv::COLOR_BayerBG2GRAY, cv::COLOR_BayerBG2BGR, -2,
+     -1, -2, -2, -2, -2, -2}, // From BAYER_RG
+    {-2, cv::COLOR_BayerGR2GRAY, cv::COLOR_BayerGR2BGR, -2,
+     -2, -1, -2, -2, -2, -2}, // From BAYER_GB
+    {-2, cv::COLOR_BayerGB2GRAY, cv::COLOR_BayerGB2BGR, -2,
+     -2, -2, -1, -2, -2, -2}, // From BAYER_GR
+    {-2, cv::COLOR_BayerRG2GRAY, cv::COLOR_BayerRG2BGR, -2,
+     -2, -2, -2, -1, -2, -2}, // From BAYER_BG
+    {-2, -3, -2, -2, -2, -2, -2, -2, -1, -2}, // From GREY12
+    {-2, -3, -2, -2, -2, -2, -2, -2, -2, -1}, // From GREY16
 };
 
 inline std::string color_str(const oat::PixelColor col)
@@ -57,6 +87,12 @@ inline std::string color_str(const oat::PixelColor col)
         case PIX_GREY : return "GREY";
         case PIX_BGR : return "BGR";
         case PIX_HSV : return "HSV";
+        case PIX_BAYER_RG : return "BAYER_RG";
+        case PIX_BAYER_GB : return "BAYER_GB";
+        case PIX_BAYER_GR : return "BAYER_GR";
+        case PIX_BAYER_BG : return "BAYER_BG";
+        case PIX_GREY12 : return "GREY12";
+        case PIX_GREY16 : return "GREY16";
         default : throw std::runtime_error("Invalid color.");
     }
 }
@@ -71,6 +107,18 @@ inline oat::PixelColor str_color(const std::string &s)
         return PIX_BGR;
     else if (s == "HSV")
         return PIX_HSV;
+    else if (s == "BAYER_RG")
+        return PIX_BAYER_RG;
+    else if (s == "BAYER_GB")
+        return PIX_BAYER_GB;
+    else if (s == "BAYER_GR")
+        return PIX_BAYER_GR;
+    else if (s == "BAYER_BG")
+        return PIX_BAYER_BG;
+    else if (s == "GREY12")
+        return PIX_GREY12;
+    else if (s == "GREY16")
+        return PIX_GREY16;
     else
         throw std::runtime_error("Invalid color.");
 }
@@ -85,6 +133,16 @@ inline int color_bytes(oat::PixelColor col)
     return color_2_bytes[col];
 }
 
+inline int color_bits(oat::PixelColor col)
+{
+    return color_2_bits[col];
+}
+
+inline bool is_bayer(oat::PixelColor col)
+{
+    return col >= PIX_BAYER_RG && col <= PIX_BAYER_BG;
+}
+
 inline int color_conv_code(oat::PixelColor from, oat::PixelColor to)
 {
     auto code =  color_conv_table[from][to];
@@ -94,6 +152,30 @@ inline int color_conv_code(oat::PixelColor from, oat::PixelColor to)
     return code;
 }
 
+/**
+ * @brief Convert pixels between colors, including conversions that change the
+ * bit depth, which cv::cvtColor() cannot do. If dst already has the size and
+ * type of the result, it is written in place.
+ * @param src Pixels of color from.
+ * @param dst Pixels of color to.
+ * @param from Source color.
+ * @param to Destination color.
+ */
+inline void convert_color(cv::InputArray src,
+                          cv::OutputArray dst,
+                          oat::PixelColor from,
+                          oat::PixelColor to)
+{
+    const int code = color_conv_code(from, to);
+
+    if (code == -1)
+        src.copyTo(dst);
+    else if (code == -3)
+        src.getMat().convertTo(dst, CV_8U, 1.0 / (1 << (color_bits(from) - 8)));
+    else
+        cv::cvtColor(src, dst, code);
+}
+
 inline int imread_code(oat::PixelColor col)
 {
     auto code = color_2_imread_code[col];
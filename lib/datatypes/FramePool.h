@@ -0,0 +1,243 @@
+//******************************************************************************
+//* File:   FramePool.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_FRAMEPOOL_H
+#define	OAT_FRAMEPOOL_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+#include <opencv2/core/mat.hpp>
+
+#include "Color.h"
+#include "Frame.h"
+
+namespace oat {
+
+/**
+ * @brief Fixed number of reusable frame buffers for temporaries in processing
+ * loops. Buffers are keyed by rows, cols and type. Once a buffer of each shape
+ * that a loop needs has been allocated, acquire() returns a free buffer of
+ * that shape without allocating. Acquiring and releasing buffers is lock-free.
+ */
+class FramePool {
+
+    static constexpr size_t DEFAULT_CAPACITY {8};
+    static constexpr size_t ALIGNMENT {64};
+
+    struct FreeDeleter {
+        void operator()(uint8_t *p) const { std::free(p); }
+    };
+
+    struct Slot {
+        std::atomic<bool> busy {false};
+        uint64_t key {0}; //!< Shape of the buffer. Only changed by its owner.
+        size_t bytes {0};
+        std::unique_ptr<uint8_t, FreeDeleter> data;
+        oat::Sample sample;
+    };
+
+public:
+
+    /**
+     * @brief A buffer acquired from the pool. Returns the buffer to the pool
+     * when destroyed.
+     */
+    class Lease {
+    public:
+
+        Lease(Lease &&other)
+        : slot_(other.slot_)
+        , frame_(other.frame_)
+        {
+            other.slot_ = nullptr;
+        }
+
+        Lease(const Lease &) = delete;
+        Lease &operator=(const Lease &) = delete;
+
+        ~Lease()
+        {
+            if (slot_ != nullptr)
+                slot_->busy.store(false, std::memory_order_release);
+        }
+
+        /**
+         * @brief Frame backed by the pooled buffer. Operations that write to
+         * it must not change its shape, or OpenCV will allocate a new buffer.
+         */
+        oat::Frame &frame() { return frame_; }
+
+    private:
+        friend class FramePool;
+
+        Lease(Slot *slot,
+              const int rows,
+              const int cols,
+              const int type,
+              const oat::PixelColor color)
+        : slot_(slot)
+        , frame_(rows, cols, type, color, slot->data.get(), &slot->sample)
+        {
+            // Nothing
+        }
+
+        Slot *slot_;
+        oat::Frame frame_;
+    };
+
+    explicit FramePool(const size_t capacity = DEFAULT_CAPACITY)
+    : capacity_(capacity)
+    , slots_(new Slot[capacity])
+    {
+        // Nothing
+    }
+
+    /**
+     * @brief Grow the pool, e.g. when temporaries are drawn from it by
+     * several threads. Must not be called while any buffer is leased.
+     * @param capacity Minimum number of buffers.
+     */
+    void reserve(const size_t capacity)
+    {
+        if (capacity <= capacity_)
+            return;
+
+        std::unique_ptr<Slot[]> slots(new Slot[capacity]);
+        for (size_t i = 0; i < capacity_; i++) {
+            slots[i].key = slots_[i].key;
+            slots[i].bytes = slots_[i].bytes;
+            slots[i].data = std::move(slots_[i].data);
+        }
+
+        slots_ = std::move(slots);
+        capacity_ = capacity;
+    }
+
+    /**
+     * @brief Number of buffers in the pool.
+     */
+    size_t capacity() const { return capacity_; }
+
+    /**
+     * @brief Acquire a buffer.
+     * @param rows Number of frame rows.
+     * @param cols Number of frame columns.
+     * @param type OpenCV matrix type, e.g. CV_8UC3.
+     * @param color Pixel color of the returned frame.
+     * @return Lease on a buffer of the requested shape.
+     */
+    Lease acquire(const int rows,
+                  const int cols,
+                  const int type,
+                  const oat::PixelColor color = oat::PIX_BGR)
+    {
+        const uint64_t k = key(rows, cols, type);
+
+        // Free buffer of the right shape
+        for (size_t i = 0; i < capacity_; i++) {
+            Slot &s = slots_[i];
+            if (claim(s)) {
+                if (s.key == k)
+                    return Lease(&s, rows, cols, type, color);
+                release(s);
+            }
+        }
+
+        // Reshape an empty slot, or any free slot if there are none. Only
+        // happens during warm-up or if the loop needs more shapes than the
+        // pool has slots.
+        const size_t bytes
+            = static_cast<size_t>(rows) * cols * CV_ELEM_SIZE(type);
+
+        for (int pass = 0; pass < 2; pass++) {
+            for (size_t i = 0; i < capacity_; i++) {
+                Slot &s = slots_[i];
+                if ((pass == 1 || s.key == 0) && claim(s)) {
+                    if (pass == 0 && s.key != 0) {
+                        release(s);
+                        continue;
+                    }
+                    reshape(s, k, bytes);
+                    return Lease(&s, rows, cols, type, color);
+                }
+            }
+        }
+
+        throw std::runtime_error("All frame pool buffers are in use.");
+    }
+
+    /**
+     * @brief Number of buffer allocations made by the pool so far.
+     */
+    uint64_t allocations() const
+    {
+        return allocations_.load(std::memory_order_relaxed);
+    }
+
+private:
+
+    static uint64_t key(const int rows, const int cols, const int type)
+    {
+        // 0 is reserved for empty slots
+        return (static_cast<uint64_t>(rows) << 40)
+             | (static_cast<uint64_t>(cols) << 16)
+             | (static_cast<uint64_t>(type) + 1);
+    }
+
+    static bool claim(Slot &s)
+    {
+        return !s.busy.load(std::memory_order_relaxed)
+               && !s.busy.exchange(true, std::memory_order_acquire);
+    }
+
+    static void release(Slot &s)
+    {
+        s.busy.store(false, std::memory_order_release);
+    }
+
+    void reshape(Slot &s, const uint64_t k, const size_t bytes)
+    {
+        if (bytes > s.bytes) {
+
+            void *p = nullptr;
+            if (posix_memalign(&p, ALIGNMENT, bytes) != 0) {
+                release(s);
+                throw std::bad_alloc();
+            }
+
+            s.data.reset(static_cast<uint8_t *>(p));
+            s.bytes = bytes;
+            allocations_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        s.key = k;
+    }
+
+    size_t capacity_;
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<uint64_t> allocations_ {0};
+};
+
+}      /* namespace oat */
+#endif /* OAT_FRAMEPOOL_H */
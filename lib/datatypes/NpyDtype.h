@@ -0,0 +1,128 @@
+//******************************************************************************
+//* File:   NpyDtype.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_NPYDTYPE_H
+#define	OAT_NPYDTYPE_H
+
+#include <cstddef>
+
+namespace oat {
+
+// Compile time queries of flat numpy structured dtype strings, e.g.
+// "[('tick', '<u8'), ('pos_xy', 'f8', (2))]", so that binary records can be
+// checked against the dtype that describes them in .npy headers. Each field
+// is a name, a type whose size in bytes is its trailing number, and an
+// optional element count. Nested dtypes are not supported.
+namespace npy {
+
+namespace detail {
+
+constexpr bool isDigit(const char c) { return c >= '0' && c <= '9'; }
+
+constexpr size_t parseInt(const char *s, const size_t acc = 0)
+{
+    return isDigit(*s) ? parseInt(s + 1, acc * 10 + (*s - '0')) : acc;
+}
+
+constexpr const char *skipTo(const char *s, const char c)
+{
+    return *s == '\0' || *s == c ? s : skipTo(s + 1, c);
+}
+
+// Size in bytes of a type such as <u8, f8 or a10
+constexpr size_t typeBytes(const char *t)
+{
+    return isDigit(*t) ? parseInt(t) : typeBytes(t + 1);
+}
+
+// Fields start at "('". The name is followed by the type, in quotes, and
+// then either the field's closing parenthesis or its element count.
+constexpr const char *name(const char *f) { return f + 2; }
+
+constexpr const char *type(const char *f)
+{
+    return skipTo(skipTo(name(f), '\'') + 1, '\'') + 1;
+}
+
+constexpr const char *typeEnd(const char *f)
+{
+    return skipTo(type(f), '\'') + 1;
+}
+
+constexpr size_t count(const char *f)
+{
+    return *typeEnd(f) == ',' ? parseInt(skipTo(typeEnd(f), '(') + 1) : 1;
+}
+
+constexpr const char *fieldEnd(const char *f)
+{
+    return *typeEnd(f) == ','
+        ? skipTo(skipTo(typeEnd(f), ')') + 1, ')') + 1
+        : skipTo(typeEnd(f), ')') + 1;
+}
+
+constexpr size_t fieldBytes(const char *f)
+{
+    return typeBytes(type(f)) * count(f);
+}
+
+constexpr const char *firstField(const char *s) { return skipTo(s, '('); }
+constexpr const char *nextField(const char *f) { return skipTo(fieldEnd(f), '('); }
+
+constexpr bool nameIs(const char *a, const char *n)
+{
+    return *n == '\0' ? *a == '\''
+                      : *a == *n && nameIs(a + 1, n + 1);
+}
+
+constexpr size_t bytesFrom(const char *f)
+{
+    return *f == '\0' ? 0 : fieldBytes(f) + bytesFrom(nextField(f));
+}
+
+// Offset of the named field, or (size_t)-1 if there is none
+constexpr size_t offsetFrom(const char *f, const char *n, const size_t offset)
+{
+    return *f == '\0' ? static_cast<size_t>(-1)
+         : nameIs(name(f), n) ? offset
+         : offsetFrom(nextField(f), n, offset + fieldBytes(f));
+}
+
+}  // namespace detail
+
+/**
+ * @brief Number of bytes in each record of a dtype.
+ */
+constexpr size_t bytes(const char *dtype)
+{
+    return detail::bytesFrom(detail::firstField(dtype));
+}
+
+/**
+ * @brief Byte offset of a field within each record of a dtype.
+ * @return Offset, or (size_t)-1 if the dtype has no such field.
+ */
+constexpr size_t offset(const char *dtype, const char *name)
+{
+    return detail::offsetFrom(detail::firstField(dtype), name, 0);
+}
+
+}  // namespace npy
+}      /* namespace oat */
+#endif /* OAT_NPYDTYPE_H */
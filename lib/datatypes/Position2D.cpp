@@ -21,78 +21,38 @@
 
 namespace oat {
 
-const char Position2D::NPY_DTYPE[]{"[('tick', '<u8'),"
-                                    "('usec', '<u8'),"
-                                    "('unit', '<i4'),"
-                                    "('pos_ok', '<i1'),"
-                                    "('pos_xy', 'f8', (2)),"
-                                    "('vel_ok', '<i1'),"
-                                    "('vel_xy', 'f8', (2)),"
-                                    "('head_ok', '<i1'),"
-                                    "('head_xy', 'f8', (2)),"
-                                    "('reg_ok', '<i1'),"
-                                    "('reg', 'a10')]"};
+constexpr char Position2D::NPY_DTYPE[];
 
-// TODO: This feels horrible...
-std::vector<char> packPosition(const Position2D &p)
+void packPosition(const Position2D &p, char *buffer)
 {
-    std::vector<char> pack;
-    pack.reserve(oat::Position2D::NPY_DTYPE_BYTES);
+    PackedPosition2D r;
 
-    auto sc = p.sample_.count();
-    auto val = reinterpret_cast<char*>(&sc);
-    pack.insert(pack.end(), val, val + sizeof (sc));
+    r.tick = p.sample_.count();
+    r.usec = p.sample_usec();
+    r.unit = static_cast<int32_t>(p.unit_of_length_);
 
-    auto su = p.sample_usec();
-    val = reinterpret_cast<char*>(&su);
-    pack.insert(pack.end(), val, val + sizeof (su));
+    r.pos_ok = p.position_valid ? 1 : 0;
+    r.pos_xy[0] = p.position.x;
+    r.pos_xy[1] = p.position.y;
 
-    auto u = static_cast<int>(p.unit_of_length_);
-    val = reinterpret_cast<char*>(&u);
-    pack.insert(pack.end(), val, val + sizeof (u));
+    r.vel_ok = p.velocity_valid ? 1 : 0;
+    r.vel_xy[0] = p.velocity.x;
+    r.vel_xy[1] = p.velocity.y;
 
-    // Position
-    char pok = p.position_valid ? 1 : 0;
-    pack.insert(pack.end(), &pok, &pok + 1);
+    r.head_ok = p.heading_valid ? 1 : 0;
+    r.head_xy[0] = p.heading.x;
+    r.head_xy[1] = p.heading.y;
 
-    auto px = p.position.x;
-    val = reinterpret_cast<char*>(&px);
-    pack.insert(pack.end(), val, val + sizeof (px));
+    r.reg_ok = p.region_valid ? 1 : 0;
+    std::memcpy(r.reg, p.region, sizeof(r.reg));
 
-    auto py = p.position.y;
-    val = reinterpret_cast<char*>(&py);
-    pack.insert(pack.end(), val, val + sizeof (px));
-
-    // Velocity
-    char vok = p.velocity_valid ? 1 : 0;
-    pack.insert(pack.end(), &vok, &vok + 1);
-
-    auto vx = p.velocity.x;
-    val = reinterpret_cast<char*>(&vx);
-    pack.insert(pack.end(), val, val + sizeof (vx));
-
-    auto vy = p.velocity.y;
-    val = reinterpret_cast<char*>(&vy);
-    pack.insert(pack.end(), val, val + sizeof (vx));
-
-    // Heading
-    char hok = p.heading_valid ? 1 : 0;
-    pack.insert(pack.end(), &hok, &hok + 1);
-
-    auto hx = p.heading.x;
-    val = reinterpret_cast<char*>(&hx);
-    pack.insert(pack.end(), val, val + sizeof (hx));
-
-    auto hy = p.heading.y;
-    val = reinterpret_cast<char*>(&hy);
-    pack.insert(pack.end(), val, val + sizeof (hx));
-
-    // Region
-    char rok = p.region_valid ? 1 : 0;
-    pack.insert(pack.end(), &rok, &rok + 1);
-    pack.insert(pack.end(), p.region, p.region + oat::Position2D::REGION_LEN);
+    std::memcpy(buffer, &r, sizeof(r));
+}
 
-    return pack;
+void packPositions(const Position2D *p, const size_t n, char *buffer)
+{
+    for (size_t i = 0; i < n; i++)
+        packPosition(p[i], buffer + i * sizeof(PackedPosition2D));
 }
 
 } /* namespace oat */
@@ -20,12 +20,16 @@
 #ifndef OAT_POSITION_H
 #define	OAT_POSITION_H
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <vector>
 
 #include <opencv2/core/mat.hpp>
 #include <rapidjson/prettywriter.h>
 
+#include "NpyDtype.h"
 #include "Sample.h"
 
 namespace oat {
@@ -46,88 +50,103 @@ class Position2D;
 template <typename Writer>
 void serializePosition(const Position2D &p, Writer &w, bool verbose = false);
 
-/** 
- * @brief Pack a position object into a byte array.
- * @param Position2D Position to pack into a byte array.
- * @return Byte arrayByte array.
+/**
+ * @brief Pack a position into its binary record, which is laid out as
+ * Position2D::NPY_DTYPE.
+ * @param p Position to pack.
+ * @param buffer Destination of Position2D::NPY_DTYPE_BYTES bytes.
+ */
+void packPosition(const Position2D &p, char *buffer);
+
+/**
+ * @brief Pack an array of positions into consecutive binary records.
+ * @param p Positions to pack.
+ * @param n Number of positions.
+ * @param buffer Destination of n * Position2D::NPY_DTYPE_BYTES bytes.
  */
-std::vector<char> packPosition(const Position2D &p);
+void packPositions(const Position2D *p, size_t n, char *buffer);
 
 /**
  * Unit of length used to specify position.
  */
-enum class DistanceUnit
+enum class DistanceUnit : uint8_t
 {
     PIXELS = 0,   //!< Position measured in pixels. Origin is upper left.
     WORLD = 1     //!< Position measured in units specified via homography
 };
 
+/**
+ * @brief Position metadata that is constant for the lifetime of a position
+ * node. Position sinks publish it once using Sink<T>::set_metadata() and
+ * sources read it when they connect using Source<T>::metadata(), rather than
+ * copying it with every sample.
+ */
+struct PositionMetadata {
+
+    PositionMetadata() = default;
+
+    explicit PositionMetadata(const std::string &label)
+    {
+        strncpy(this->label, label.c_str(), sizeof(this->label));
+        this->label[sizeof(this->label) - 1] = '\0';
+    }
+
+    char label[100] {0}; //!< Position label (e.g. "anterior")
+
+    // Maps pixels to the world units of positions whose unit_of_length() is
+    // DistanceUnit::WORLD
+    // TODO: Generalize to 3D position. Replace homography with tvec and rvec
+    cv::Matx33d homography {1.0, 0, 0, 0, 1.0, 0, 0, 0, 1.0};
+};
+
+/**
+ * @brief A position sample. Positions are copied at least twice per
+ * component at kHz rates, so the record is kept to two cache lines and is
+ * copied member by member: anything that does not change from sample to
+ * sample belongs in PositionMetadata.
+ */
 class Position2D {
 
     template <typename Writer>
     friend void
     serializePosition(const Position2D &, Writer &, bool verbose);
-    friend std::vector<char> packPosition(const Position2D &);
+    friend void packPosition(const Position2D &, char *);
 
     using USec = Sample::Microseconds;
 
 public:
 
-    explicit Position2D(const std::string &label)
+    Position2D()
+    : position_valid(false)
+    , velocity_valid(false)
+    , heading_valid(false)
+    , region_valid(false)
     {
-        strncpy(label_, label.c_str(), sizeof(label_));
-        label_[sizeof(label_) - 1] = '\0';
-    }
-
-    // Copy all but label, which is specific to the component
-    // TODO: get rid of the label all together...
-    Position2D &operator=(const Position2D &p)
-    {
-
-        // Check for self assignment
-        if (this == &p)
-            return *this;
-
-        // Copy all except label_
-        unit_of_length_ = p.unit_of_length_;
-        sample_ = p.sample_;
-        position_valid = p.position_valid;
-        velocity_valid = p.velocity_valid;
-        heading_valid = p.heading_valid;
-        position = p.position;
-        velocity = p.velocity;
-        heading = p.heading;
-        region_valid = p.region_valid;
-        strncpy(region, p.region, sizeof(region));
-        region[sizeof(region) - 1] = '\0';
-
-        return *this;
+        // Nothing
     }
 
     // Accessors
-    char *label() { return label_; }
     DistanceUnit unit_of_length(void) const { return unit_of_length_; }
 
-    // Categorical position
-    static constexpr size_t REGION_LEN {10};
-    bool region_valid {false};
-    char region[REGION_LEN] {0}; //!< Categorical position label (e.g. "North West")
-
-    // Validity booleans
-    bool position_valid {false};
-    bool velocity_valid {false};
-    bool heading_valid {false};
-
     // Position data
     Point2D position;
     Velocity2D velocity;
     UnitVector2D heading;
 
-    // Homography
-    cv::Matx33d homography() const { return homography_; }
+    // Validity flags
+    bool position_valid : 1;
+    bool velocity_valid : 1;
+    bool heading_valid : 1;
+    bool region_valid : 1;
+
+    // Categorical position
+    static constexpr size_t REGION_LEN {10};
+    char region[REGION_LEN] {0}; //!< Categorical position label (e.g. "North West")
 
     // Set sample rate
     void set_sample(const Sample &val) { sample_ = val; }
+    const Sample &sample() const { return sample_; }
+    Sample &sample() { return sample_; }
     void set_rate_hz(const double rate_hz) { sample_.set_rate_hz(rate_hz); }
     double sample_period_sec() const { return sample_.period_sec().count(); }
     uint64_t sample_count(void) const { return sample_.count(); }
@@ -135,25 +154,69 @@ public:
     void incrementSampleCount() { sample_.incrementCount(); }
     void incrementSampleCount(USec us) { sample_.incrementCount(us); }
 
-    void setCoordSystem(const DistanceUnit value, const cv::Matx33d homography)
-    {
-        unit_of_length_ = value;
-        homography_ = homography;
-    }
+    /**
+     * @brief Set the unit of length. The homography that maps pixels to
+     * world units is published in the node's PositionMetadata.
+     */
+    void set_unit_of_length(const DistanceUnit value) { unit_of_length_ = value; }
 
     static constexpr size_t NPY_DTYPE_BYTES {82};
-    static const char NPY_DTYPE[];
+    static constexpr char NPY_DTYPE[] {"[('tick', '<u8'),"
+                                        "('usec', '<u8'),"
+                                        "('unit', '<i4'),"
+                                        "('pos_ok', '<i1'),"
+                                        "('pos_xy', 'f8', (2)),"
+                                        "('vel_ok', '<i1'),"
+                                        "('vel_xy', 'f8', (2)),"
+                                        "('head_ok', '<i1'),"
+                                        "('head_xy', 'f8', (2)),"
+                                        "('reg_ok', '<i1'),"
+                                        "('reg', 'a10')]"};
 
 private:
 
-    char label_[100] {0}; //!< Position label (e.g. "anterior")
+    oat::Sample sample_;
     DistanceUnit unit_of_length_ {DistanceUnit::PIXELS};
+};
 
-    oat::Sample sample_;
+static_assert(sizeof(Position2D) <= 128,
+              "Position2D should fit in two cache lines.");
 
-    // TODO: Generalize to 3D position. Replace homography_ with tvec and rvec
-    cv::Matx33d homography_ {1.0, 0, 0, 0, 1.0, 0, 0, 0, 1.0};
+/**
+ * @brief Binary record of a position, laid out as Position2D::NPY_DTYPE so
+ * that it can be copied to a numpy file as is.
+ */
+#pragma pack(push, 1)
+struct PackedPosition2D {
+    uint64_t tick;
+    uint64_t usec;
+    int32_t unit;
+    int8_t pos_ok;
+    double pos_xy[2];
+    int8_t vel_ok;
+    double vel_xy[2];
+    int8_t head_ok;
+    double head_xy[2];
+    int8_t reg_ok;
+    char reg[Position2D::REGION_LEN];
 };
+#pragma pack(pop)
+
+static_assert(npy::bytes(Position2D::NPY_DTYPE) == Position2D::NPY_DTYPE_BYTES
+              && sizeof(PackedPosition2D) == Position2D::NPY_DTYPE_BYTES,
+              "PackedPosition2D does not match Position2D::NPY_DTYPE.");
+static_assert(npy::offset(Position2D::NPY_DTYPE, "usec") == offsetof(PackedPosition2D, usec)
+              && npy::offset(Position2D::NPY_DTYPE, "unit") == offsetof(PackedPosition2D, unit)
+              && npy::offset(Position2D::NPY_DTYPE, "pos_ok") == offsetof(PackedPosition2D, pos_ok)
+              && npy::offset(Position2D::NPY_DTYPE, "pos_xy") == offsetof(PackedPosition2D, pos_xy)
+              && npy::offset(Position2D::NPY_DTYPE, "vel_ok") == offsetof(PackedPosition2D, vel_ok)
+              && npy::offset(Position2D::NPY_DTYPE, "vel_xy") == offsetof(PackedPosition2D, vel_xy)
+              && npy::offset(Position2D::NPY_DTYPE, "head_ok") == offsetof(PackedPosition2D, head_ok)
+              && npy::offset(Position2D::NPY_DTYPE, "head_xy") == offsetof(PackedPosition2D, head_xy)
+              && npy::offset(Position2D::NPY_DTYPE, "reg_ok") == offsetof(PackedPosition2D, reg_ok)
+              && npy::offset(Position2D::NPY_DTYPE, "reg") == offsetof(PackedPosition2D, reg),
+              "PackedPosition2D fields are not where Position2D::NPY_DTYPE "
+              "places them.");
 
 /**
  * @brief JSON Serializer
@@ -0,0 +1,199 @@
+//******************************************************************************
+//* File:   PositionJSON.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#include "PositionJSON.h"
+
+#include <cmath>
+#include <cstring>
+
+// Number formatting is rapidjson's own (Grisu2 for doubles) so that the
+// output matches rapidjson::Writer to the byte
+#include <rapidjson/internal/dtoa.h>
+#include <rapidjson/internal/itoa.h>
+
+#include "Position2D.h"
+#include "PositionList.h"
+
+namespace oat {
+
+constexpr size_t PositionJSON::MAX_POSITION_BYTES;
+
+// Matches serializePosition()'s writer.SetMaxDecimalPlaces(5)
+static constexpr int MAX_DECIMAL_PLACES {5};
+
+// Copy a string literal, without its null terminator
+template <size_t N>
+static inline char *put(char *c, const char (&s)[N])
+{
+    std::memcpy(c, s, N - 1);
+    return c + N - 1;
+}
+
+// rapidjson::Writer writes nothing for NaN and inf by default
+static inline char *putDouble(char *c, const double d)
+{
+    return std::isfinite(d)
+               ? rapidjson::internal::dtoa(d, c, MAX_DECIMAL_PLACES)
+               : c;
+}
+
+static inline char *putPoint(char *c, const cv::Point2d &p)
+{
+    *c++ = '[';
+    c = putDouble(c, p.x);
+    *c++ = ',';
+    c = putDouble(c, p.y);
+    *c++ = ']';
+    return c;
+}
+
+// Quoted and escaped as rapidjson::Writer::String() does. At most 6 bytes
+// per character, plus quotes.
+static inline char *putString(char *c, const char *s, const size_t max_len)
+{
+    static const char hex[] = "0123456789ABCDEF";
+
+    *c++ = '"';
+    for (size_t i = 0; i < max_len && s[i] != '\0'; i++) {
+        const unsigned char ch = static_cast<unsigned char>(s[i]);
+        switch (ch) {
+            case '"':  c = put(c, "\\\""); break;
+            case '\\': c = put(c, "\\\\"); break;
+            case '\b': c = put(c, "\\b"); break;
+            case '\f': c = put(c, "\\f"); break;
+            case '\n': c = put(c, "\\n"); break;
+            case '\r': c = put(c, "\\r"); break;
+            case '\t': c = put(c, "\\t"); break;
+            default:
+                if (ch < 0x20) {
+                    c = put(c, "\\u00");
+                    *c++ = hex[ch >> 4];
+                    *c++ = hex[ch & 0xF];
+                } else {
+                    *c++ = static_cast<char>(ch);
+                }
+        }
+    }
+    *c++ = '"';
+
+    return c;
+}
+
+static_assert(8 + 20 + 8 + 20 + 8 + 11 // tick, usec, unit
+              + 3 * (16 + 12 + 2 * 25 + 3) // pos, vel, head
+              + 16 + 8 + 6 * Position2D::REGION_LEN + 2 + 1 // reg, closing
+              <= PositionJSON::MAX_POSITION_BYTES,
+              "PositionJSON::MAX_POSITION_BYTES is too small.");
+
+PositionJSON::PositionJSON(bool verbose)
+: verbose_(verbose)
+, buffer_(MAX_POSITION_BYTES)
+{
+    // Nothing
+}
+
+char *PositionJSON::reserve(const size_t n)
+{
+    if (buffer_.size() < n)
+        buffer_.resize(n);
+
+    return buffer_.data();
+}
+
+void PositionJSON::serialize(const Position2D &p)
+{
+    char *start = reserve(MAX_POSITION_BYTES);
+    size_ = write(start, p) - start;
+}
+
+void PositionJSON::serialize(const PositionList &l)
+{
+    const size_t max_bytes
+        = 64 + l.size() * (11 + MAX_POSITION_BYTES + 1);
+    char *start = reserve(max_bytes);
+    char *c = start;
+
+    c = put(c, "{\"tick\":");
+    c = rapidjson::internal::u64toa(l.sample_count(), c);
+    c = put(c, ",\"usec\":");
+    c = rapidjson::internal::u64toa(l.sample_usec(), c);
+
+    c = put(c, ",\"ids\":[");
+    for (size_t i = 0; i < l.size(); i++) {
+        if (i > 0)
+            *c++ = ',';
+        c = rapidjson::internal::u32toa(l.id(i), c);
+    }
+
+    c = put(c, "],\"positions\":[");
+    for (size_t i = 0; i < l.size(); i++) {
+        if (i > 0)
+            *c++ = ',';
+        c = write(c, l[i]);
+    }
+    c = put(c, "]}");
+
+    size_ = c - start;
+}
+
+// Field for field the same as serializePosition(), including that head_ok
+// and reg_ok are not forced true in verbose mode
+char *PositionJSON::write(char *c, const Position2D &p) const
+{
+    c = put(c, "{\"tick\":");
+    c = rapidjson::internal::u64toa(p.sample_count(), c);
+    c = put(c, ",\"usec\":");
+    c = rapidjson::internal::u64toa(p.sample_usec(), c);
+    c = put(c, ",\"unit\":");
+    c = rapidjson::internal::i32toa(static_cast<int>(p.unit_of_length()), c);
+
+    if (p.position_valid || verbose_) {
+        c = put(c, ",\"pos_ok\":true,\"pos_xy\":");
+        c = putPoint(c, p.position);
+    } else {
+        c = put(c, ",\"pos_ok\":false");
+    }
+
+    if (p.velocity_valid || verbose_) {
+        c = put(c, ",\"vel_ok\":true,\"vel_xy\":");
+        c = putPoint(c, p.velocity);
+    } else {
+        c = put(c, ",\"vel_ok\":false");
+    }
+
+    c = p.heading_valid ? put(c, ",\"head_ok\":true")
+                        : put(c, ",\"head_ok\":false");
+    if (p.heading_valid || verbose_) {
+        c = put(c, ",\"head_xy\":");
+        c = putPoint(c, p.heading);
+    }
+
+    c = p.region_valid ? put(c, ",\"reg_ok\":true")
+                       : put(c, ",\"reg_ok\":false");
+    if (p.region_valid || verbose_) {
+        c = put(c, ",\"reg\":");
+        c = putString(c, p.region, Position2D::REGION_LEN);
+    }
+
+    *c++ = '}';
+
+    return c;
+}
+
+} /* namespace oat */
@@ -0,0 +1,82 @@
+//******************************************************************************
+//* File:   PositionJSON.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_POSITIONJSON_H
+#define	OAT_POSITIONJSON_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace oat {
+
+// Forward decl.
+class Position2D;
+class PositionList;
+
+/**
+ * @brief Compact JSON serializer for positions. Produces the same bytes as
+ * serializePosition() with a rapidjson::Writer, but writes fixed key
+ * fragments directly into a buffer that is reused from sample to sample
+ * instead of going through the generic writer for each field.
+ */
+class PositionJSON {
+public:
+
+    /**
+     * @param verbose Serialize fields even though they contain indeterminate
+     * data. See serializePosition().
+     */
+    explicit PositionJSON(bool verbose = false);
+
+    /**
+     * @brief Serialize a position, replacing the contents of the buffer.
+     * @param p Position to serialize.
+     */
+    void serialize(const Position2D &p);
+
+    /**
+     * @brief Serialize a list of positions, replacing the contents of the
+     * buffer.
+     * @param l List to serialize.
+     */
+    void serialize(const PositionList &l);
+
+    // Serialized JSON. Not null terminated.
+    const char *data() const { return buffer_.data(); }
+    size_t size() const { return size_; }
+    std::string str() const { return std::string(data(), size()); }
+
+    // Upper bound on the length of a single serialized position
+    static constexpr size_t MAX_POSITION_BYTES {512};
+
+private:
+
+    bool verbose_;
+    std::vector<char> buffer_;
+    size_t size_ {0};
+
+    // Make room for n bytes and return the start of the buffer
+    char *reserve(size_t n);
+
+    char *write(char *c, const Position2D &p) const;
+};
+
+}      /* namespace oat */
+#endif /* OAT_POSITIONJSON_H */
@@ -0,0 +1,73 @@
+//******************************************************************************
+//* File:   PositionList.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#include "PositionList.h"
+
+#include <cstring>
+
+namespace oat {
+
+// Each entry of 'positions' has the dtype of Position2D::NPY_DTYPE
+const char PositionList::NPY_DTYPE[]{"[('tick', '<u8'),"
+                                      "('usec', '<u8'),"
+                                      "('n', '<u4'),"
+                                      "('ids', '<u4', (16,)),"
+                                      "('positions', "
+                                      "[('tick', '<u8'),"
+                                      "('usec', '<u8'),"
+                                      "('unit', '<i4'),"
+                                      "('pos_ok', '<i1'),"
+                                      "('pos_xy', 'f8', (2)),"
+                                      "('vel_ok', '<i1'),"
+                                      "('vel_xy', 'f8', (2)),"
+                                      "('head_ok', '<i1'),"
+                                      "('head_xy', 'f8', (2)),"
+                                      "('reg_ok', '<i1'),"
+                                      "('reg', 'a10')], (16,))]"};
+
+static_assert(PositionList::MAX_SIZE == 16,
+              "PositionList::NPY_DTYPE assumes 16 entries.");
+
+void packPosition(const PositionList &l, char *buffer)
+{
+    PackedPositionList r;
+
+    r.tick = l.sample_count();
+    r.usec = l.sample_usec();
+    r.n = l.size();
+
+    // Unused entries are invalid positions
+    const oat::Position2D empty;
+    char *positions = reinterpret_cast<char *>(r.positions);
+    for (size_t i = 0; i < PositionList::MAX_SIZE; i++) {
+        r.ids[i] = i < r.n ? l.id(i) : 0;
+        packPosition(i < r.n ? l[i] : empty,
+                     positions + i * sizeof(PackedPosition2D));
+    }
+
+    std::memcpy(buffer, &r, sizeof(r));
+}
+
+void packPositions(const PositionList *l, const size_t n, char *buffer)
+{
+    for (size_t i = 0; i < n; i++)
+        packPosition(l[i], buffer + i * sizeof(PackedPositionList));
+}
+
+} /* namespace oat */
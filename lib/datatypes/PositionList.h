@@ -0,0 +1,185 @@
+//******************************************************************************
+//* File:   PositionList.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_POSITIONLIST_H
+#define	OAT_POSITIONLIST_H
+
+#include <cstdint>
+
+#include "Position2D.h"
+#include "Sample.h"
+
+namespace oat {
+
+// Forward decl.
+class PositionList;
+
+/**
+ * @brief Serialize a list of positions.
+ * @param l List to serialize.
+ * @param w Writer to serialize with.
+ * @param verbose Allow verbose serialization of each position.
+ */
+template <typename Writer>
+void serializePosition(const PositionList &l, Writer &w, bool verbose = false);
+
+/**
+ * @brief Pack a list of positions into its binary record, which is laid out
+ * as PositionList::NPY_DTYPE. Unused entries are packed as invalid positions
+ * so that each list has the same size.
+ * @param l List to pack.
+ * @param buffer Destination of PositionList::NPY_DTYPE_BYTES bytes.
+ */
+void packPosition(const PositionList &l, char *buffer);
+
+/**
+ * @brief Pack an array of lists into consecutive binary records.
+ * @param l Lists to pack.
+ * @param n Number of lists.
+ * @param buffer Destination of n * PositionList::NPY_DTYPE_BYTES bytes.
+ */
+void packPositions(const PositionList *l, size_t n, char *buffer);
+
+/**
+ * @brief The positions of several objects found in the same sample, e.g. by a
+ * detector that reports the K largest blobs in each frame. The list has a
+ * fixed capacity so that it can live in shared memory, but only the entries
+ * in use are copied.
+ */
+class PositionList {
+public:
+
+    static constexpr size_t MAX_SIZE {16};
+
+    PositionList() = default;
+
+    PositionList(const PositionList &l) { *this = l; }
+
+    PositionList &operator=(const PositionList &l)
+    {
+        sample_ = l.sample_;
+        size_ = l.size_;
+        for (size_t i = 0; i < size_; i++) {
+            ids_[i] = l.ids_[i];
+            positions_[i] = l.positions_[i];
+        }
+
+        return *this;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    void clear() { size_ = 0; }
+
+    /**
+     * @brief Append a position, which takes the list's sample.
+     * @param p Position.
+     * @param id Object id.
+     * @return False if the list is full, in which case the position is
+     * discarded.
+     */
+    bool push_back(const Position2D &p, const uint32_t id)
+    {
+        if (size_ == MAX_SIZE)
+            return false;
+
+        ids_[size_] = id;
+        positions_[size_] = p;
+        positions_[size_].set_sample(sample_);
+        size_++;
+
+        return true;
+    }
+
+    Position2D &operator[](const size_t i) { return positions_[i]; }
+    const Position2D &operator[](const size_t i) const { return positions_[i]; }
+    uint32_t id(const size_t i) const { return ids_[i]; }
+
+    // Sample of every position in the list
+    void set_sample(const Sample &val)
+    {
+        sample_ = val;
+        for (size_t i = 0; i < size_; i++)
+            positions_[i].set_sample(val);
+    }
+    const Sample &sample() const { return sample_; }
+    Sample &sample() { return sample_; } //!< Stamped when the list is published
+    double sample_period_sec() const { return sample_.period_sec().count(); }
+    uint64_t sample_count(void) const { return sample_.count(); }
+    uint64_t sample_usec(void) const { return sample_.microseconds().count(); }
+
+    static constexpr size_t NPY_DTYPE_BYTES
+        {8 + 8 + 4 + 4 * MAX_SIZE + Position2D::NPY_DTYPE_BYTES * MAX_SIZE};
+    static const char NPY_DTYPE[];
+
+private:
+
+    oat::Sample sample_;
+    uint32_t size_ {0};
+    uint32_t ids_[MAX_SIZE] {0};
+    Position2D positions_[MAX_SIZE];
+};
+
+/**
+ * @brief Binary record of a list of positions, laid out as
+ * PositionList::NPY_DTYPE.
+ */
+#pragma pack(push, 1)
+struct PackedPositionList {
+    uint64_t tick;
+    uint64_t usec;
+    uint32_t n;
+    uint32_t ids[PositionList::MAX_SIZE];
+    PackedPosition2D positions[PositionList::MAX_SIZE];
+};
+#pragma pack(pop)
+
+static_assert(sizeof(PackedPositionList) == PositionList::NPY_DTYPE_BYTES,
+              "PackedPositionList does not match PositionList::NPY_DTYPE.");
+
+template <typename Writer>
+void serializePosition(const PositionList &l, Writer &writer, bool verbose)
+{
+    writer.StartObject();
+
+    // Sample number
+    writer.String("tick");
+    writer.Uint64(l.sample_count());
+
+    writer.String("usec");
+    writer.Uint64(l.sample_usec());
+
+    // Object ids, in the same order as the positions
+    writer.String("ids");
+    writer.StartArray();
+    for (size_t i = 0; i < l.size(); i++)
+        writer.Uint(l.id(i));
+    writer.EndArray(l.size());
+
+    writer.String("positions");
+    writer.StartArray();
+    for (size_t i = 0; i < l.size(); i++)
+        serializePosition(l[i], writer, verbose);
+    writer.EndArray(l.size());
+
+    writer.EndObject();
+}
+
+}      /* namespace oat */
+#endif /* OAT_POSITIONLIST_H */
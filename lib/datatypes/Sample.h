@@ -23,6 +23,8 @@
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <cstdint>
+#include <limits>
 #include <ratio>
 
 #include <opencv2/core/mat.hpp>
@@ -31,6 +33,11 @@ namespace oat {
 
 /**
  * Class specifying general sample timing information.
+ *
+ * A sample also carries a short trace of steady clock stamps, one appended by
+ * each component that publishes it, so that the latency of every hop between
+ * the frame server and the last component can be measured. The trace is
+ * cleared when the sample count is incremented.
  */
 class Sample {
 
@@ -40,6 +47,8 @@ public:
     using Microseconds = std::chrono::microseconds; 
     using IEEE1394Tick = std::chrono::duration<float, std::ratio<1,8000>>;
 
+    static constexpr size_t MAX_STAMPS {6};
+
     explicit Sample()
     {
         // Nothing
@@ -54,7 +63,6 @@ public:
       period_sec_(period_sec)
     {
         assert(period_sec_.count() > 0.0);
-        rate_hz_ = 1.0 / period_sec;
     }
 
     /**
@@ -66,7 +74,6 @@ public:
       period_sec_(period_sec)
     {
         assert(period_sec_.count() > 0.0);
-        rate_hz_ = 1.0 / period_sec.count();
     }
 
     /**
@@ -76,7 +83,8 @@ public:
      * @return Current sample count
      */
     uint64_t incrementCount() {
-        microseconds_ += period_microseconds_;
+        microseconds_ += period_microseconds();
+        num_stamps_ = 0;
         return ++count_;
     }
 
@@ -90,6 +98,7 @@ public:
      */
     uint64_t incrementCount(const Microseconds usec) {
         microseconds_ = usec;
+        num_stamps_ = 0;
         return ++count_;
     }
 
@@ -101,25 +110,78 @@ public:
     void set_rate_hz(const double value) {
 
         assert(value > 0.0);
-        rate_hz_ = value;
         period_sec_ = Seconds(1.0 / value);
-        period_microseconds_ = 
-            std::chrono::duration_cast<Microseconds>(period_sec_);
     }
 
     uint64_t count() const { return count_; }
     Microseconds microseconds() const { return microseconds_; }
     Seconds period_sec() const { return period_sec_; }
-    Microseconds period_microseconds() const { return period_microseconds_; }
-    double rate_hz() const { return rate_hz_; }
+    Microseconds period_microseconds() const
+    {
+        return std::chrono::duration_cast<Microseconds>(period_sec_);
+    }
+    double rate_hz() const
+    {
+        return period_sec_.count() > 0.0 ? 1.0 / period_sec_.count() : 0.0;
+    }
+
+    /**
+     * @brief Append a stamp to the trace. Called by a SINK each time it
+     * publishes the sample. When the trace is full, the last stamp is
+     * overwritten so that the end-to-end latency is still measured, with the
+     * hops that did not fit merged into the last one.
+     *
+     * @param ns Time in nanoseconds on the steady clock.
+     */
+    void stamp(const uint64_t ns)
+    {
+        if (num_stamps_ == 0) {
+            first_stamp_ns_ = ns;
+            num_stamps_ = 1;
+            return;
+        }
+
+        // Offsets beyond ~4 sec saturate
+        const uint64_t offset = ns > first_stamp_ns_ ? ns - first_stamp_ns_ : 0;
+        const uint8_t i = num_stamps_ < MAX_STAMPS ? num_stamps_++ : MAX_STAMPS - 1;
+        stamp_offsets_ns_[i - 1] = static_cast<uint32_t>(std::min<uint64_t>(
+            offset, std::numeric_limits<uint32_t>::max()));
+    }
+
+    /**
+     * @brief Append a stamp with the current time to the trace.
+     */
+    void stamp()
+    {
+        using namespace std::chrono;
+        stamp(duration_cast<nanoseconds>(
+                  steady_clock::now().time_since_epoch()).count());
+    }
+
+    size_t num_stamps() const { return num_stamps_; }
+
+    /**
+     * @brief A stamp in the trace.
+     * @param i Index of the stamp, which must be less than num_stamps().
+     * @return Time in nanoseconds on the steady clock.
+     */
+    uint64_t stamp_ns(const size_t i) const
+    {
+        return i == 0 ? first_stamp_ns_
+                      : first_stamp_ns_ + stamp_offsets_ns_[i - 1];
+    }
 
 private:
 
     uint64_t count_ {0};
     Microseconds microseconds_ {0};
     Seconds period_sec_ {0.0};
-    Microseconds period_microseconds_ {0};
-    double rate_hz_ {0.0};
+
+    // Latency trace. Stamps after the first are stored as offsets from it to
+    // keep the sample small, since it is copied with every position.
+    uint64_t first_stamp_ns_ {0};
+    uint32_t stamp_offsets_ns_[MAX_STAMPS - 1] {0};
+    uint8_t num_stamps_ {0};
 };
 
 }      /* namespace oat */
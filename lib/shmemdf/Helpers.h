@@ -21,12 +21,18 @@
 #define	OAT_SHMEMDFHELPERS_H
 
 #include "Source.h"
+#include "Waker.h"
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cmath>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 
+#include "../datatypes/Sample.h"
 #include "../utility/in_place.h"
 #include "../utility/make_unique.h"
 
@@ -133,6 +139,337 @@ struct NamedSource {
 template<typename T>
 using NamedSourceList = std::vector<NamedSource<T>>;
 
+/**
+ * @brief Wait until each of several SOURCEs has a new write. Each source is
+ * read and then posted as soon as its write arrives, so its SINK is released
+ * right away instead of after the other sources have been read, and the
+ * caller waits for the slowest source rather than for the sum of the
+ * sources' delays.
+ *
+ * Semaphores in different nodes cannot be waited on together, so while more
+ * than one source is pending, waitAll() registers a Waker with each of them
+ * and blocks on the Waker, which their SINKs post along with the sources'
+ * read barriers. Sources that cannot post a Waker (SourceMode::LATEST), or
+ * all sources if no Waker is free, are instead checked every POLL_PERIOD.
+ *
+ * @param sources SOURCEs to read.
+ * @param read Called with the index of a source in sources after the source
+ * has waited and before it is posted. Should copy the source's shared object.
+ * @param timeout Maximum time to wait for all sources. Defaults to no limit.
+ * @return NodeState::END if any source's SINK has ended, in which case
+ * sources that have yet to be read are not waited on. NodeState::UNDEFINED
+ * if the timeout expired, in which case sources that were read have been
+ * posted and will be waited on again by the next call. Otherwise,
+ * NodeState::SINK_BOUND. Check quit, as after wait(), to find out if the
+ * wait was interrupted.
+ */
+template <typename F>
+NodeState waitAll(const std::vector<SourceSync *> &sources,
+                  F read,
+                  const std::chrono::microseconds timeout
+                      = std::chrono::microseconds::max())
+{
+    using Clock = std::chrono::steady_clock;
+    using usec = std::chrono::microseconds;
+    static constexpr usec POLL_PERIOD {1000};
+
+    const bool forever = timeout == usec::max();
+    const auto deadline = forever ? Clock::time_point::max()
+                                  : Clock::now() + timeout;
+
+    std::vector<size_t> pending(sources.size());
+    for (size_t i = 0; i < pending.size(); i++)
+        pending[i] = i;
+
+    Waker &waker = threadWaker();
+    waker.drain();
+
+    // Registered until return. Registration precedes the first check of
+    // each source so that a write between the two posts the Waker.
+    struct Registration {
+        const std::vector<SourceSync *> &sources;
+        bool polled {false}; //!< A source could not register
+        Registration(const std::vector<SourceSync *> &s, const uint32_t id)
+        : sources(s)
+        {
+            for (auto src : sources)
+                polled |= !src->set_waker(id);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+        ~Registration()
+        {
+            for (auto src : sources)
+                src->set_waker(Waker::NONE);
+        }
+    };
+    std::unique_ptr<Registration> reg;
+    if (waker.valid() && sources.size() > 1)
+        reg = oat::make_unique<Registration>(sources, waker.id());
+    const bool poll = reg ? reg->polled : sources.size() > 1;
+
+    // Read and release a source that has finished waiting
+    NodeState state = NodeState::SINK_BOUND;
+    auto complete = [&](const size_t k) {
+
+        const size_t i = pending[k];
+
+        // START CRITICAL SECTION //
+        ////////////////////////////
+        const bool ok = state != NodeState::END && !quit;
+        if (ok)
+            read(i);
+
+        sources[i]->post();
+        ////////////////////////////
+        //  END CRITICAL SECTION  //
+
+        pending.erase(pending.begin() + k);
+        return ok;
+    };
+
+    while (true) {
+
+        // Read each source that already has a new write
+        for (size_t k = 0; k < pending.size(); ) {
+            if (!sources[pending[k]]->tryWait(usec(0), state))
+                k++;
+            else if (!complete(k))
+                return state;
+        }
+
+        if (pending.empty())
+            return NodeState::SINK_BOUND;
+
+        // Block on a single pending source
+        if (forever && pending.size() == 1) {
+            state = sources[pending[0]]->wait();
+            if (!complete(0))
+                return state;
+            continue;
+        }
+
+        auto left = forever ? usec::max()
+            : std::chrono::duration_cast<usec>(deadline - Clock::now());
+        if (left <= usec(0))
+            return NodeState::UNDEFINED;
+        if (poll)
+            left = std::min(left, POLL_PERIOD);
+
+        // Block until any pending source may read
+        if (reg)
+            waker.wait(left);
+        else if (sources[pending[0]]->tryWait(left, state) && !complete(0))
+            return state;
+
+        if (quit)
+            return state;
+    }
+}
+
+/**
+ * @brief Sample field used to match samples from different SOURCEs.
+ */
+enum class SyncKey {
+    NONE,         //!< Assume the i-th read from each source is the same sample
+    COUNT,        //!< Match by Sample::count()
+    MICROSECONDS  //!< Match by Sample::microseconds()
+};
+
+/**
+ * @brief Parameters of a SampleSynchronizer.
+ */
+struct SyncConfig {
+    SyncKey key {SyncKey::NONE};
+    uint64_t tolerance {0}; //!< Maximum difference between matched keys
+    size_t window {8};      //!< Samples held per source while unmatched
+};
+
+/**
+ * @brief Aligns samples read from several SOURCEs whose SINKs may drop or
+ * duplicate samples. Each source has a reorder window of the most recent
+ * samples that have yet to be matched. Samples whose keys are within the
+ * tolerance of one another are emitted together as a tuple. Samples that can
+ * no longer be matched are discarded and counted rather than waited for, so a
+ * source that skips a sample costs one tuple instead of stalling or shifting
+ * every later tuple.
+ *
+ * The synchronizer only tracks keys. Payloads are stored by the caller in
+ * per-source arrays of window() elements, at the slot returned by push().
+ * Slots named by pop() remain valid until the next call to push().
+ */
+class SampleSynchronizer {
+public:
+
+    static constexpr size_t NO_SLOT {static_cast<size_t>(-1)};
+
+    SampleSynchronizer(const size_t num_sources, const SyncConfig &config)
+    : config_(config)
+    , num_sources_(num_sources)
+    , keys_(num_sources * std::max<size_t>(config.window, 1))
+    , head_(num_sources, 0)
+    , size_(num_sources, 0)
+    , last_(num_sources, 0)
+    , seen_(num_sources, false)
+    {
+        config_.window = std::max<size_t>(config_.window, 1);
+    }
+
+    /**
+     * @brief Add a sample that was read from a source.
+     * @param source Index of the source.
+     * @param sample The sample's timing information.
+     * @return Window slot at which the caller should store the sample's
+     * payload, or NO_SLOT if the sample is a duplicate of, or older than, the
+     * previous sample from this source and has been discarded.
+     */
+    size_t push(const size_t source, const oat::Sample &sample)
+    {
+        const uint64_t key = keyOf(sample);
+
+        if (seen_[source] && key <= last_[source]) {
+            duplicates_++;
+            return NO_SLOT;
+        }
+        seen_[source] = true;
+        last_[source] = key;
+
+        // The window is full, so the oldest sample will never be matched
+        if (size_[source] == config_.window) {
+            popHead(source);
+            dropped_++;
+        }
+
+        const size_t slot = (head_[source] + size_[source]) % config_.window;
+        keys_[source * config_.window + slot] = key;
+        size_[source]++;
+
+        return slot;
+    }
+
+    /**
+     * @brief Remove the oldest tuple of matching samples, if there is one.
+     * Samples that are older than the newest sample at the front of any
+     * window by more than the tolerance can no longer be matched and are
+     * discarded.
+     * @param slots Set to the window slot of each source's sample.
+     * @return True if a tuple was found.
+     */
+    bool pop(std::vector<size_t> &slots)
+    {
+        for (size_t i = 0; i < num_sources_; i++)
+            if (size_[i] == 0)
+                return false;
+
+        // Discarding a stale head can expose a newer one than the heads that
+        // were already checked, so repeat until every head is within the
+        // tolerance of the newest
+        bool discarded = true;
+        while (discarded) {
+
+            uint64_t newest = 0;
+            for (size_t i = 0; i < num_sources_; i++)
+                newest = std::max(newest, headKey(i));
+
+            discarded = false;
+            for (size_t i = 0; i < num_sources_; i++) {
+                while (size_[i] > 0
+                       && headKey(i) + config_.tolerance < newest) {
+                    popHead(i);
+                    mismatches_++;
+                    discarded = true;
+                }
+                if (size_[i] == 0)
+                    return false;
+            }
+        }
+
+        slots.resize(num_sources_);
+        for (size_t i = 0; i < num_sources_; i++) {
+            slots[i] = head_[i];
+            popHead(i);
+        }
+
+        return true;
+    }
+
+    const SyncConfig &config() const { return config_; }
+    size_t window() const { return config_.window; }
+
+    /**
+     * @brief Samples discarded because no sample from another source matched.
+     */
+    uint64_t mismatches() const { return mismatches_; }
+
+    /**
+     * @brief Samples discarded because a window overflowed.
+     */
+    uint64_t dropped() const { return dropped_; }
+
+    /**
+     * @brief Samples discarded because they repeated a previous sample.
+     */
+    uint64_t duplicates() const { return duplicates_; }
+
+    /**
+     * @brief Total number of discarded samples.
+     */
+    uint64_t discarded() const { return mismatches_ + dropped_ + duplicates_; }
+
+    /**
+     * @brief Check if a misalignment warning is due. True once each time
+     * discarded() reaches a power of two, so that a persistently misaligned
+     * source does not flood the console.
+     */
+    bool warningDue()
+    {
+        const uint64_t n = discarded();
+        if (n < next_warning_)
+            return false;
+
+        while (next_warning_ <= n)
+            next_warning_ *= 2;
+        return true;
+    }
+
+private:
+
+    uint64_t keyOf(const oat::Sample &sample) const
+    {
+        return config_.key == SyncKey::MICROSECONDS
+                   ? static_cast<uint64_t>(sample.microseconds().count())
+                   : sample.count();
+    }
+
+    uint64_t headKey(const size_t source) const
+    {
+        return keys_[source * config_.window + head_[source]];
+    }
+
+    void popHead(const size_t source)
+    {
+        head_[source] = (head_[source] + 1) % config_.window;
+        size_[source]--;
+    }
+
+    SyncConfig config_;
+    const size_t num_sources_;
+    std::vector<uint64_t> keys_;
+    std::vector<size_t> head_, size_;
+    std::vector<uint64_t> last_;
+    std::vector<bool> seen_;
+    uint64_t mismatches_ {0}, dropped_ {0}, duplicates_ {0};
+    uint64_t next_warning_ {1};
+};
+
+inline std::string misalignedSourcesWarning(const SampleSynchronizer &sync)
+{
+    return
+        "WARNING: sources are misaligned. " + std::to_string(sync.discarded())
+        + " samples have been discarded so far (" + std::to_string(sync.mismatches())
+        + " unmatched, " + std::to_string(sync.dropped()) + " overflowed, "
+        + std::to_string(sync.duplicates()) + " duplicated).\n";
+}
+
 /**
  * @brief Check if a set of sample periods is consistent.
  * @param periods_sec Sample periods in seconds.
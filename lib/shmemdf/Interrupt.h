@@ -0,0 +1,163 @@
+//******************************************************************************
+//* File:   Interrupt.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_INTERRUPT_H
+#define	OAT_INTERRUPT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/sync/interprocess_semaphore.hpp>
+
+#include "../base/Globals.h"
+
+namespace oat {
+
+// Sinks and sources block on Node semaphores without a timeout. Because a
+// blocked thread cannot poll the global quit flag, each waiting thread
+// registers the semaphore it is blocked on. interruptWaits() posts every
+// registered semaphore so that all waiting threads wake up, see that quit is
+// set, and return. Waits are also released by the SINK when the node goes to
+// NodeState::END (see Node::notifySinkEnd()).
+
+namespace detail {
+
+using semaphore = boost::interprocess::interprocess_semaphore;
+
+// Maximum number of threads that can be simultaneously blocked in
+// interruptibleWait() in a single process
+static constexpr size_t MAX_WAITERS {256};
+
+// Zero-initialized before any dynamic initialization, so this is safe to use
+// from a signal handler
+inline std::atomic<semaphore *> *waiters()
+{
+    static std::atomic<semaphore *> w[MAX_WAITERS];
+    return w;
+}
+
+class WaitRegistration {
+public:
+    explicit WaitRegistration(semaphore &s)
+    {
+        auto w = waiters();
+        for (index_ = 0; index_ < MAX_WAITERS; index_++) {
+            semaphore *expected = nullptr;
+            if (w[index_].compare_exchange_strong(expected, &s))
+                return;
+        }
+
+        throw std::runtime_error("Too many threads waiting on shared memory "
+                                 "nodes in this process.");
+    }
+
+    ~WaitRegistration() { waiters()[index_].store(nullptr); }
+
+    WaitRegistration(const WaitRegistration &) = delete;
+    WaitRegistration &operator=(const WaitRegistration &) = delete;
+
+private:
+    size_t index_ {0};
+};
+
+} // namespace detail
+
+/**
+ * @brief Wake all threads of this process that are blocked in
+ * interruptibleWait(). Set quit before calling. Async-signal-safe.
+ */
+inline void interruptWaits()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    auto w = detail::waiters();
+    for (size_t i = 0; i < detail::MAX_WAITERS; i++) {
+        auto s = w[i].load();
+        if (s != nullptr)
+            s->post();
+    }
+}
+
+/**
+ * @brief Block on a semaphore until it is posted or until interruptWaits()
+ * is called.
+ * @param s Semaphore to wait on.
+ * @return False if the wait was released because quit was set.
+ */
+inline bool interruptibleWait(detail::semaphore &s)
+{
+    // Register before checking quit so that a concurrent interruptWaits()
+    // either sees this wait or happens before the check
+    detail::WaitRegistration reg(s);
+
+    if (quit)
+        return false;
+
+    try {
+        s.wait();
+    } catch (const boost::interprocess::interprocess_exception &) {
+
+        // SIGINT during sem_wait() results in EINTR
+        if (quit)
+            return false;
+        throw;
+    }
+
+    return !quit;
+}
+
+/**
+ * @brief Block on a semaphore until it is posted, until a timeout expires or
+ * until interruptWaits() is called.
+ * @param s Semaphore to wait on.
+ * @param timeout Maximum time to block. If zero, the semaphore is only
+ * checked.
+ * @return True if the semaphore was posted. If false, check quit to find
+ * out if the wait timed out or was interrupted.
+ */
+inline bool interruptibleTimedWait(detail::semaphore &s,
+                                   const std::chrono::microseconds timeout)
+{
+    if (timeout.count() <= 0)
+        return !quit && s.try_wait();
+
+    detail::WaitRegistration reg(s);
+
+    if (quit)
+        return false;
+
+    const auto deadline = boost::posix_time::microsec_clock::universal_time()
+                          + boost::posix_time::microseconds(timeout.count());
+
+    try {
+        return s.timed_wait(deadline) && !quit;
+    } catch (const boost::interprocess::interprocess_exception &) {
+
+        // SIGINT during sem_timedwait() results in EINTR
+        if (quit)
+            return false;
+        throw;
+    }
+}
+
+}       /* namespace oat */
+#endif	/* OAT_INTERRUPT_H */
@@ -23,11 +23,19 @@
 #include <iostream>
 #include <array>
 #include <atomic>
-#include <bitset>
+#include <cstdint>
+#include <stdexcept>
+#include <new>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <boost/interprocess/sync/interprocess_semaphore.hpp>
 
+#include <unistd.h>
+
 #include "ForwardsDecl.h"
+#include "NodeStats.h"
+#include "Waker.h"
 
 namespace oat {
 
@@ -38,149 +46,717 @@ enum class NodeState {
     ERROR = 2
 };
 
+/**
+ * @brief What a SINK does when a blocking SOURCE has yet to read the ring
+ * slot that it will write next. Chosen by the SINK when it binds.
+ */
+enum class BackpressurePolicy {
+    BLOCK,       //!< Wait for the SOURCE. No samples are lost.
+    DROP_OLDEST, //!< Overwrite the unread sample, unless a SOURCE is in the
+                 //!< middle of reading it. SOURCEs skip to the most recent
+                 //!< write. Requires a ring of at least two slots.
+    DROP_NEWEST  //!< Discard the new sample without publishing it.
+};
+
+/**
+ * @brief Parse a backpressure policy name: block, drop-oldest or
+ * drop-newest.
+ */
+inline BackpressurePolicy backpressurePolicy(const std::string &name)
+{
+    if (name == "block")
+        return BackpressurePolicy::BLOCK;
+    else if (name == "drop-oldest")
+        return BackpressurePolicy::DROP_OLDEST;
+    else if (name == "drop-newest")
+        return BackpressurePolicy::DROP_NEWEST;
+
+    throw std::runtime_error("Unrecognized backpressure policy '" + name
+                             + "'. Use block, drop-oldest or drop-newest.");
+}
+
+// Node lives in shared memory and is accessed by several processes, which
+// requires address-free, lock-free atomics
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_BOOL_LOCK_FREE == 2,
+              "oat::Node requires lock-free 64-bit atomics.");
+
 class Node {
+
+    // Counters, masks and telemetry that are updated by different processes
+    // are each given their own cache lines to prevent false sharing. Padding,
+    // rather than alignas, is used because managed shared memory does not
+    // honor extended alignment: each such member starts a whole number of
+    // cache lines from the start of the node.
+    static constexpr size_t CACHE_LINE_BYTES {64};
+
+    template <typename T>
+    struct Padded {
+        std::atomic<T> value;
+        char pad[CACHE_LINE_BYTES - sizeof(std::atomic<T>)];
+    };
+
 public:
 
     using semaphore = bip::interprocess_semaphore;
+    using mask_t = uint64_t;
 
     Node()
     {
-        source_slots_.reset();
-        source_read_required_.reset();
+        for (auto &r : source_read_required_)
+            r.value = 0;
+        for (auto &r : read_number_)
+            r.value = UNSET;
+        for (auto &t : post_time_)
+            t.store(0, std::memory_order_relaxed);
+        for (auto &o : owners_) {
+            o.pid.store(0, std::memory_order_relaxed);
+            o.heartbeat_ns.store(0, std::memory_order_relaxed);
+            o.waker.store(Waker::NONE, std::memory_order_relaxed);
+        }
+        for (auto &o : observers_)
+            o.store(Waker::NONE, std::memory_order_relaxed);
+
+        // Semaphores are not default constructable, so they are constructed
+        // in place in raw storage
+        for (size_t i = 0; i < MAX_SLOTS; i++)
+            new (&read_barriers_[i]) semaphore(0);
     }
 
-    // Nodes are movable
-    Node(Node&&) = default;
-    Node & operator=(Node&&) = default;
+    ~Node()
+    {
+        for (size_t i = 0; i < MAX_SLOTS; i++)
+            barrier(i).~semaphore();
+    }
 
-    // Nodes are not copyable
+    // Nodes are not copyable or movable
     Node(const Node &) = delete;
     Node & operator=(const Node &) = delete;
 
     // SINK state
-    void set_sink_state(NodeState value) { sink_state_ = value; }
-    NodeState sink_state(void) const { return sink_state_; }
+    void set_sink_state(NodeState value) { sink_state_.value = value; }
+    NodeState sink_state(void) const { return sink_state_.value; }
+
+    /**
+     * @brief Set the SINK state to END and wake each SOURCE that is blocked
+     * waiting on its read_barrier.
+     */
+    void notifySinkEnd()
+    {
+        sink_state_.value = NodeState::END;
+
+        for (mask_t m = source_slots_.value; m; m &= m - 1)
+            wake(lowestSlot(m));
+        wakeObservers();
+    }
 
     // SINK writes (~sample number)
-    // TODO: write_number_ being atomic is redundant because only one sink can
-    //       be bound to a node, right?
-    uint64_t write_number() const { return write_number_; }
+    uint64_t write_number() const { return write_number_.value; }
+
+    // Ring of shared objects written by the SINK and read by each SOURCE
+    static constexpr size_t MAX_RING_DEPTH {16};
+
+    /**
+     * @brief Set the number of shared objects in the node's ring. Must be
+     * called by the SINK before its first write.
+     * @param depth Number of ring slots. A depth of 1 keeps the SINK in
+     * lockstep with its blocking SOURCEs.
+     */
+    void set_ring_depth(const size_t depth)
+    {
+        if (depth == 0 || depth > MAX_RING_DEPTH)
+            throw std::runtime_error("Ring depth must be between 1 and "
+                                     + std::to_string(MAX_RING_DEPTH) + ".");
 
-    void notifySinkWriteComplete()
+        if (write_number_.value != 0)
+            throw std::runtime_error("Ring depth cannot be changed after the "
+                                     "SINK has written to the node.");
+
+        ring_depth_ = depth;
+    }
+
+    size_t ring_depth(void) const { return ring_depth_; }
+
+    /**
+     * @brief Set the SINK's backpressure policy. Must be called by the SINK
+     * before its first write.
+     */
+    void set_backpressure(const BackpressurePolicy policy)
     {
-        mutex_.wait();
+        if (write_number_.value != 0)
+            throw std::runtime_error("Backpressure policy cannot be changed "
+                                     "after the SINK has written to the node.");
 
-        // Require one read from all connected sources
-        source_read_required_ = source_slots_;
+        backpressure_ = policy;
+    }
 
-        // Tell each source connected to the node that it may read
-        for (size_t i = 0; i < source_slots_.size(); i++)
-            if (source_slots_[i])
-                read_barrier(i).post();
+    BackpressurePolicy backpressure(void) const { return backpressure_; }
 
-        ++write_number_;
+    // Ring slot that the SINK will write next
+    size_t write_index(void) const { return write_number_.value % ring_depth_; }
 
-        mutex_.post();
+    // Ring slot that a SOURCE will read next
+    size_t read_index(size_t index) const
+    {
+        uint64_t n = read_number_[index].value;
+        return n == UNSET ? write_index() : n % ring_depth_;
     }
 
-    // SOURCE read counting
-    bool notifySourceReadComplete(size_t index)
+    /**
+     * @brief Check if the ring slot that the SINK will write next has been
+     * read by all blocking SOURCEs.
+     * @return True if the SINK may write.
+     */
+    bool writeSlotAvailable() const
     {
-        mutex_.wait();
+        return source_read_required_[write_index()].value == 0;
+    }
 
-        source_read_required_[index] = false;
-        bool reads_finished = source_read_required_.none();
+    /**
+     * @brief SOURCEs that are in the middle of reading the ring slot that the
+     * SINK will write next. Only tracked for SOURCEs that mark their reads in
+     * catchUp(): non-blocking ones, and all of them under DROP_OLDEST.
+     */
+    mask_t writeSlotReaders() const
+    {
+        mask_t readers = 0;
+        for (mask_t m = reading_slots_.value; m; m &= m - 1) {
+            const size_t i = lowestSlot(m);
+            const uint64_t n = read_number_[i].value;
+            if (n != UNSET && n % ring_depth_ == write_index())
+                readers |= bit(i);
+        }
 
-        mutex_.post();
+        return readers;
+    }
 
-        return reads_finished;
+    /**
+     * @brief Check if the SINK must wait before writing the ring slot that
+     * it will write next. Under BLOCK, it waits until all blocking SOURCEs
+     * have read the slot. Under DROP_OLDEST, it only waits for SOURCEs that
+     * are in the middle of reading it. Under DROP_NEWEST, the SINK discards
+     * the sample instead of waiting for blocking SOURCEs. Under every policy,
+     * it waits for SOURCEs that are in the middle of reading the slot.
+     */
+    bool writeSlotBlocked() const
+    {
+        return (backpressure_ != BackpressurePolicy::DROP_OLDEST
+                && !writeSlotAvailable())
+               || writeSlotReaders() != 0;
     }
 
-    // SOURCE slots
-    static constexpr size_t NUM_SLOTS {10};
+    /**
+     * @brief Check, after notifySinkWriteBegin(), if a SOURCE marked a read
+     * of the slot being written too late for writeSlotBlocked() to see it.
+     * Only possible in a ring one slot deep, where a SOURCE that catches up
+     * reads the slot that the SINK writes. Such a SOURCE either sees that
+     * the write has begun and waits for it (see catchUp()), or is seen here,
+     * in which case the SINK must wait for it and begin the write again.
+     */
+    bool writeSlotRaced() const
+    {
+        if (ring_depth_ > 1)
+            return false;
 
-    int acquireSlot(size_t &index)
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return writeSlotReaders() != 0;
+    }
+
+    /**
+     * @brief Tell SOURCEs that the SINK is about to block on the
+     * write_barrier. The last SOURCE to read the ring slot that the SINK is
+     * waiting on will post the write_barrier.
+     * @return False if the ring slot became available in the meantime, in
+     * which case the SINK must not block.
+     */
+    bool announceSinkWait()
     {
-        mutex_.wait();
+        sink_waiting_.value = true;
 
-        if (source_slots_.all()) {
-            mutex_.post();
-            return -1;
+        // Re-check after announcing to avoid missing a wakeup
+        if (!writeSlotBlocked()) {
+            sink_waiting_.value = false;
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Mark the start of a SINK write. Together with write_number(),
+     * this forms a sequence lock that lets observers, which are SOURCEs
+     * without a slot, copy the most recent write without holding up the SINK.
+     */
+    void notifySinkWriteBegin()
+    {
+        writes_begun_.value.store(write_number_.value + 1,
+                                  std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    /**
+     * @brief Check an observer's copy of the most recent write.
+     * @param n write_number() before the copy was made. The copy is of ring
+     * slot (n - 1) % ring_depth().
+     * @return False if the SINK might have started overwriting the ring slot
+     * during the copy, in which case the copy must be retried.
+     */
+    bool snapshotValid(const uint64_t n) const
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return writes_begun_.value.load(std::memory_order_relaxed)
+               < n + ring_depth_;
+    }
+
+    void notifySinkWriteComplete()
+    {
+        const uint64_t w = write_number_.value;
+        const mask_t slots = source_slots_.value;
+
+        // Require one read of this ring slot from all blocking sources. A
+        // source that releases its slot after 'slots' was loaded may clear
+        // its bit before the store, so the mask is trimmed to the sources
+        // that are still attached.
+        auto &required = source_read_required_[w % ring_depth_].value;
+        required = slots & blocking_slots_.value;
+        required.fetch_and(source_slots_.value);
+
+        // Newly attached sources start reading from this write
+        for (mask_t m = slots; m; m &= m - 1) {
+            uint64_t unset = UNSET;
+            read_number_[lowestSlot(m)].value.compare_exchange_strong(unset, w);
+        }
+
+        post_time_[w % ring_depth_].store(statsNow(),
+                                          std::memory_order_relaxed);
+        write_number_.value = w + 1;
+
+        // Tell each source connected to the node that it may read
+        for (mask_t m = slots; m; m &= m - 1)
+            wake(lowestSlot(m));
+        wakeObservers();
+    }
+
+    /**
+     * @brief SOURCE read counting. Does not block.
+     * @param index SOURCE slot index
+     * @return True if this read released the ring slot that the SINK is
+     * waiting on, in which case the caller must post the write_barrier.
+     */
+    bool notifySourceReadComplete(size_t index)
+    {
+        const uint64_t r = read_number_[index].value;
+        const mask_t prev = source_read_required_[r % ring_depth_].value
+                                .fetch_and(~bit(index));
+        read_number_[index].value = r + 1;
+
+        const uint64_t latency = statsNow()
+            - post_time_[r % ring_depth_].load(std::memory_order_relaxed);
+        source_stats[index].latency.add(latency);
+        if (prev == bit(index))
+            sink_stats.last_read.add(latency);
+
+        // The SINK may be waiting for this read to finish
+        const bool done_reading
+            = reading_slots_.value.fetch_and(~bit(index)) & bit(index);
+
+        // Only the last blocking reader wakes the SINK, and only if the SINK
+        // is waiting
+        return (prev == bit(index) || done_reading)
+               && sink_waiting_.value.exchange(false);
+    }
+
+    /**
+     * @brief Move a non-blocking SOURCE's read cursor to the most recent write,
+     * discarding any pending read_barrier posts for older ring slots. Must be
+     * called after a wait on read_barrier(index) has succeeded. Also marks
+     * the SOURCE as reading until notifySourceReadComplete(), so that the
+     * SINK does not overwrite its slot. Blocking SOURCEs under DROP_OLDEST
+     * are caught up and marked too.
+     * @param index SOURCE slot index
+     */
+    void catchUp(size_t index) { catchUp(index, [] { }); }
+
+    /**
+     * @brief catchUp() that calls preempted() after the write number is
+     * loaded and before the read cursor is moved. Lets tests stand in for a
+     * SINK that runs while the SOURCE is preempted there.
+     */
+    template <typename F>
+    void catchUp(size_t index, F preempted)
+    {
+        auto &rb = read_barrier(index);
+        while (true) {
+
+            // Marked before the write number is loaded. A SINK that misses
+            // the mark has already completed that write and is writing the
+            // next ring slot. That is a different slot unless the ring is one
+            // slot deep, which is handled below.
+            reading_slots_.value.fetch_or(bit(index));
+
+            while (rb.try_wait()) { }
+
+            uint64_t w = write_number_.value;
+            preempted();
+
+            // Until the cursor is stored, the SINK sees the previous one,
+            // which might not protect the slot the SINK writes after
+            // completing write w. If the SINK completed a write in the
+            // meantime, move the cursor again: the SINK stores the write
+            // number before it checks cursors, so one it did not complete
+            // yet will see this one.
+            while (w > 0) {
+                read_number_[index].value = w - 1;
+                const uint64_t latest = write_number_.value;
+                if (latest == w)
+                    break;
+                w = latest;
+            }
+
+            // In a ring one slot deep, a SINK that missed the mark may be
+            // writing the slot. It checks for marks again once the write has
+            // begun (see writeSlotRaced()), so stand aside until the write is
+            // complete and catch up to it instead.
+            if (ring_depth_ > 1 || writes_begun_.value <= w
+                || sink_state_.value == NodeState::END)
+                return;
+
+            if (reading_slots_.value.fetch_and(~bit(index)) & bit(index)
+                && sink_waiting_.value.exchange(false))
+                write_barrier.post();
+
+            while (write_number_.value == w
+                   && sink_state_.value != NodeState::END)
+                std::this_thread::yield();
         }
+    }
+
+    // SOURCE slots
+    static constexpr size_t NUM_SLOTS {10}; //!< Default number of SOURCE slots
+    static constexpr size_t MAX_SLOTS {64}; //!< Maximum number of SOURCE slots
+    static_assert(MAX_SLOTS <= sizeof(mask_t) * 8,
+                  "SOURCE slots must fit in a slot mask.");
+
+    /**
+     * @brief Set the number of SOURCEs that can share this node. Called by
+     * the SINK when it binds.
+     * @param num_slots Number of SOURCE slots.
+     */
+    void set_num_slots(const size_t num_slots)
+    {
+        if (num_slots == 0 || num_slots > MAX_SLOTS)
+            throw std::runtime_error("Number of sources must be between 1 and "
+                                     + std::to_string(MAX_SLOTS) + ".");
+
+        if (claimed_slots_.value & ~slotMask(num_slots))
+            throw std::runtime_error("More than " + std::to_string(num_slots)
+                                     + " sources are already attached to "
+                                       "this node.");
 
-        index = 0;
-        while (source_slots_[index])
-            ++index;
+        num_slots_.value = num_slots;
+    }
 
-        source_slots_[index] = true;
-        source_ref_count_ = source_slots_.count();
+    size_t num_slots(void) const { return num_slots_.value; }
 
-        mutex_.post();
+    int acquireSlot(size_t &index, bool blocking = true)
+    {
+        // Claim the lowest free slot
+        mask_t claimed = claimed_slots_.value;
+        do {
+            mask_t free = ~claimed & slotMask(num_slots_.value);
+            if (!free)
+                return -1;
+            index = lowestSlot(free);
+        } while (!claimed_slots_.value.compare_exchange_weak(
+                     claimed, claimed | bit(index)));
+
+        // Discard posts left over from a previous occupant of this slot
+        auto &rb = barrier(index);
+        while (rb.try_wait()) { }
+
+        // The SINK sets the read cursor on its next write
+        read_number_[index].value = UNSET;
+        source_stats[index].reset();
+        owners_[index].pid = getpid();
+        owners_[index].waker = Waker::NONE;
+        heartbeat(index);
+        evicted_slots_.value.fetch_and(~bit(index));
+        if (blocking)
+            blocking_slots_.value.fetch_or(bit(index));
+
+        // Publish to the SINK
+        source_slots_.value.fetch_or(bit(index));
 
         return 0;
     }
 
     int releaseSlot(size_t index)
     {
-        if (index >= source_slots_.size())
+        if (index >= MAX_SLOTS || !(claimed_slots_.value & bit(index)))
             return -1;
 
-        mutex_.wait();
-        source_slots_[index] = false;
-        source_ref_count_ = source_slots_.count();
-        mutex_.post();
+        source_slots_.value.fetch_and(~bit(index));
+        blocking_slots_.value.fetch_and(~bit(index));
+
+        // Pending reads by this source no longer hold up the SINK
+        bool freed = false;
+        for (auto &r : source_read_required_)
+            freed |= r.value.fetch_and(~bit(index)) == bit(index);
+        freed |= reading_slots_.value.fetch_and(~bit(index)) & bit(index);
+
+        if (freed && sink_waiting_.value.exchange(false))
+            write_barrier.post();
+
+        read_number_[index].value = UNSET;
+        evicted_slots_.value.fetch_and(~bit(index));
+        owners_[index].pid = 0;
+        claimed_slots_.value.fetch_and(~bit(index));
 
         return 0;
     }
 
-    size_t source_ref_count(void) const { return source_ref_count_; }
+    /**
+     * @brief Record that a SOURCE is alive and reading. Called by the SOURCE
+     * each time it posts.
+     * @param index SOURCE slot index
+     */
+    void heartbeat(size_t index)
+    {
+        owners_[index].heartbeat_ns.store(statsNow(),
+                                          std::memory_order_relaxed);
+    }
+
+    // PID of the process holding a SOURCE slot
+    int64_t slot_pid(size_t index) const { return owners_[index].pid; }
+
+    /**
+     * @brief Register a Waker for the SINK to post along with a SOURCE's
+     * read barrier. Called by the SOURCE. Cleared when the slot is acquired.
+     * @param index SOURCE slot index
+     * @param id Waker::id(), or Waker::NONE to unregister.
+     */
+    void set_waker(size_t index, const uint32_t id)
+    {
+        owners_[index].waker.store(id);
+    }
+
+    // Observers are SOURCEs that hold no slot (SourceMode::LATEST)
+    static constexpr size_t MAX_OBSERVERS {16};
+
+    /**
+     * @brief Register a Waker for the SINK to post after each write and when
+     * it ENDs. Called by observers while they wait for a write.
+     * @param id Waker::id()
+     * @return Index to pass to removeObserver(), or -1 if all observer
+     * entries are in use, in which case the caller must poll.
+     */
+    int addObserver(const uint32_t id)
+    {
+        for (size_t i = 0; i < MAX_OBSERVERS; i++) {
+            uint32_t none = Waker::NONE;
+            if (observers_[i].compare_exchange_strong(none, id))
+                return static_cast<int>(i);
+        }
+
+        return -1;
+    }
+
+    void removeObserver(const int index)
+    {
+        observers_[index].store(Waker::NONE);
+    }
+
+    /**
+     * @brief Evict SOURCEs that can no longer read. Called by the SINK while
+     * it is blocked. SOURCEs whose process has died, e.g. because it crashed
+     * between wait() and post(), lose their slot once they have held up the
+     * SINK without posting for a second. Blocking SOURCEs that hold
+     * up the SINK and have not posted for longer than a deadline are made
+     * non-blocking, and find out on their next wait() (see
+     * acknowledgeEviction()). Each eviction is counted in sink_stats.
+     * @param deadline_ns Heartbeat age after which a blocking SOURCE that
+     * holds up the SINK is evicted. 0 to only evict dead SOURCEs.
+     * @return Number of SOURCEs evicted.
+     */
+    size_t evictStaleReaders(const uint64_t deadline_ns)
+    {
+        size_t evicted = 0;
+        const uint64_t now = statsNow();
+
+        // A SOURCE in another PID namespace appears dead (see
+        // detail::processAlive()), so a SOURCE is only taken for dead if it
+        // also holds up the SINK and has not posted for a grace period
+        for (mask_t m = source_read_required_[write_index()].value
+                        | writeSlotReaders();
+             m; m &= m - 1) {
+
+            const size_t i = lowestSlot(m);
+            const uint64_t beat = owners_[i].heartbeat_ns;
+            if (!detail::processAlive(owners_[i].pid) && now > beat
+                && now - beat > DEAD_READER_GRACE_NS) {
+                releaseSlot(i);
+                evicted++;
+            }
+        }
+
+        if (deadline_ns > 0) {
+
+            // A SOURCE that is stuck in the middle of a read stops protecting
+            // its slot once it is evicted
+            for (mask_t m = source_read_required_[write_index()].value
+                            | writeSlotReaders();
+                 m; m &= m - 1) {
+
+                const size_t i = lowestSlot(m);
+                const uint64_t beat = owners_[i].heartbeat_ns;
+                if (now > beat && now - beat > deadline_ns) {
+                    evicted_slots_.value.fetch_or(bit(i));
+                    blocking_slots_.value.fetch_and(~bit(i));
+                    reading_slots_.value.fetch_and(~bit(i));
+                    for (auto &r : source_read_required_)
+                        r.value.fetch_and(~bit(i));
+                    evicted++;
+                }
+            }
+        }
+
+        sink_stats.evictions.fetch_add(evicted, std::memory_order_relaxed);
+        return evicted;
+    }
+
+    /**
+     * @brief Check if a SOURCE was made non-blocking by evictStaleReaders().
+     * @param index SOURCE slot index
+     * @return True the first time this is called after an eviction.
+     */
+    bool acknowledgeEviction(size_t index)
+    {
+        return evicted_slots_.value.fetch_and(~bit(index)) & bit(index);
+    }
+
+    size_t source_ref_count(void) const
+    {
+        return __builtin_popcountll(claimed_slots_.value);
+    }
+
+    // Slots visible to the SINK, and the subset that the SINK waits for
+    mask_t source_slots(void) const { return source_slots_.value; }
+    mask_t blocking_slots(void) const { return blocking_slots_.value; }
+
+    /**
+     * @brief Number of writes that a SOURCE has yet to read.
+     * @param index SOURCE slot index
+     */
+    uint64_t reads_behind(size_t index) const
+    {
+        const uint64_t r = read_number_[index].value;
+        const uint64_t w = write_number_.value;
+        return r == UNSET || r > w ? 0 : w - r;
+    }
+
+    // Telemetry, see NodeStats.h. SinkBase::post() and SourceBase::post()
+    // update these. Padding keeps each SOURCE's slot off the SINK's cache
+    // lines.
+    SinkStats sink_stats;
+    char sink_stats_pad[CACHE_LINE_BYTES - sizeof(SinkStats) % CACHE_LINE_BYTES];
+    std::array<SourceStats, MAX_SLOTS> source_stats;
 
     // Synchronization constructs
-    // write _always_ occurs before read. By starting at 1, the writer is not
-    // blocked by an initial wait. Readers to do not post to the write_barrier
-    // until a write occurs.
-    semaphore write_barrier {1};
-
-    // This method is required because an std::array of semaphores requires
-    // each semaphore to be copy-constructed to initialized the array.
-    // Because of their nature, semaphores are NOT copy constructable, so
-    // this approach does not work.
+    // The write_barrier is only posted when the SINK has announced that it
+    // is about to block (see announceSinkWait()). Because the writer may be
+    // several ring slots ahead of its readers, a post only signals that the
+    // ring slot to be written next might have become available:
+    // writeSlotAvailable() must be checked after each wakeup.
+    semaphore write_barrier {0};
+    char write_barrier_pad[CACHE_LINE_BYTES - sizeof(semaphore) % CACHE_LINE_BYTES];
+
     semaphore &read_barrier(size_t index)
     {
-        if (!source_slots_[index])
+        if (index >= MAX_SLOTS || !(claimed_slots_.value & bit(index)))
             throw std::runtime_error("Requested index refers to a SOURCE "
                                      "that is not bound to this node.");
 
-        switch (index) {
-            case 0: return rb0_; break;
-            case 1: return rb1_; break;
-            case 2: return rb2_; break;
-            case 3: return rb3_; break;
-            case 4: return rb4_; break;
-            case 6: return rb6_; break;
-            case 7: return rb7_; break;
-            case 8: return rb8_; break;
-            case 9: return rb9_; break;
-            default:
-                throw std::runtime_error("Source index out of range.");
-                break;
-        }
+        return barrier(index);
     }
 
 private:
 
-    std::atomic<NodeState> sink_state_ {oat::NodeState::UNDEFINED}; //!< SINK state
-    //std::atomic<size_t> source_read_count_ {0}; //!< Number SOURCE reads that have occured since last sink reset
-    std::bitset<NUM_SLOTS> source_slots_;
-    std::bitset<NUM_SLOTS> source_read_required_;
+    static constexpr uint64_t UNSET {~0ull};
+    static constexpr uint64_t DEAD_READER_GRACE_NS {1000000000};
+    static constexpr mask_t bit(size_t index) { return 1ull << index; }
+    static constexpr mask_t slotMask(size_t n)
+    {
+        return n >= MAX_SLOTS ? ~mask_t(0) : bit(n) - 1;
+    }
+    static size_t lowestSlot(mask_t m) { return __builtin_ctzll(m); }
+
+    Padded<NodeState> sink_state_ {{NodeState::UNDEFINED}, {}}; //!< SINK state
+    Padded<uint64_t> write_number_ {{0}, {}}; //!< Number of writes to shmem that have been facilited by this node
+    Padded<uint64_t> writes_begun_ {{0}, {}}; //!< Number of writes the SINK has started
+    Padded<bool> sink_waiting_ {{false}, {}}; //!< SINK is blocked on write_barrier
+    Padded<size_t> num_slots_ {{NUM_SLOTS}, {}}; //!< Usable SOURCE slots
+    Padded<mask_t> claimed_slots_ {{0}, {}}; //!< Slots held by a SOURCE
+    Padded<mask_t> source_slots_ {{0}, {}}; //!< Slots visible to the SINK
+    Padded<mask_t> blocking_slots_ {{0}, {}}; //!< SOURCES that the SINK must wait for
+    Padded<mask_t> evicted_slots_ {{0}, {}}; //!< Evicted SOURCEs yet to find out
+    Padded<mask_t> reading_slots_ {{0}, {}}; //!< SOURCEs between catchUp() and post
+    std::array<Padded<mask_t>, MAX_RING_DEPTH> source_read_required_;
+    std::array<Padded<uint64_t>, MAX_SLOTS> read_number_; //!< Per-SOURCE read cursor
+    std::array<std::atomic<uint64_t>, MAX_RING_DEPTH> post_time_; //!< statsNow() when each ring slot was last written
+    size_t ring_depth_ {1};
+    BackpressurePolicy backpressure_ {BackpressurePolicy::BLOCK};
+    char sink_config_pad_[CACHE_LINE_BYTES
+                          - (sizeof(post_time_) + sizeof(size_t)
+                             + sizeof(BackpressurePolicy)) % CACHE_LINE_BYTES];
+
+    // Wakers of observers. Read by the SINK after every write, so they share
+    // a single cache line.
+    std::array<std::atomic<uint32_t>, MAX_OBSERVERS> observers_;
+    static_assert(MAX_OBSERVERS * sizeof(uint32_t) == CACHE_LINE_BYTES,
+                  "Observer Wakers must fill one cache line.");
+
+    // Owner of each SOURCE slot. Written by the owner, read by the SINK.
+    struct SlotOwner {
+        std::atomic<int64_t> pid;
+        std::atomic<uint64_t> heartbeat_ns; //!< statsNow() of last post
+        std::atomic<uint32_t> waker; //!< Waker posted with the read barrier
+        char pad[CACHE_LINE_BYTES - 20];
+    };
+    std::array<SlotOwner, MAX_SLOTS> owners_;
+
+    // Read barriers. Unlike read_barrier(), barrier() does not check that the
+    // slot is bound, so the SINK can post a SOURCE that is concurrently
+    // releasing its slot.
+    using semaphore_storage =
+        std::aligned_storage<sizeof(semaphore), alignof(semaphore)>::type;
+    semaphore_storage read_barriers_[MAX_SLOTS];
+
+    semaphore &barrier(size_t index)
+    {
+        return *reinterpret_cast<semaphore *>(&read_barriers_[index]);
+    }
 
-    size_t source_ref_count_ {0}; //!< Number of SOURCES sharing this node
-    uint64_t write_number_ {0}; //!< Number of writes to shmem that have been facilited by this node
+    // Post a SOURCE's read barrier and then its Waker. The fence pairs with
+    // the one in a waiter that registers its Waker and then checks the read
+    // barrier, so that either the waiter finds the post or the SINK finds the
+    // Waker.
+    void wake(size_t index)
+    {
+        barrier(index).post();
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        Waker::post(owners_[index].waker.load(std::memory_order_relaxed));
+    }
 
-    // Unfortunately, must manually maintain the number of rbx_'s to match NUM_SLOTS
-    semaphore mutex_ {1}; //!< mutex governing exclusive acces to the read_barrier_
-    semaphore rb0_ {0}, rb1_ {0}, rb2_ {0}, rb3_ {0}, rb4_ {0},
-              rb5_ {0}, rb6_ {0}, rb7_ {0}, rb8_ {0}, rb9_ {0};
+    // Post the Waker of each observer. The fence pairs with the one in an
+    // observer that registers and then checks write_number().
+    void wakeObservers()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for (auto &o : observers_) {
+            const uint32_t id = o.load(std::memory_order_relaxed);
+            if (id != Waker::NONE)
+                Waker::post(id);
+        }
+    }
 };
 
 }       /* namespace oat */
@@ -0,0 +1,236 @@
+//******************************************************************************
+//* File:   NodeSegment.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_NODESEGMENT_H
+#define	OAT_NODESEGMENT_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+#include <boost/interprocess/managed_heap_memory.hpp>
+#include <boost/interprocess/managed_shared_memory.hpp>
+
+#include "ForwardsDecl.h"
+
+namespace oat {
+
+// Sinks and sources place their node and shared object in a pair of managed
+// segments. Normally these are POSIX shared memory in /dev/shm so that each
+// component can run in its own process. When several components are threads
+// of a single process (see oat-host), addresses that are declared local with
+// makeNodeLocal() are instead placed in managed heap memory owned by the
+// process. Local nodes use the same Node synchronization and frame ring, but
+// are not visible to other processes or to oat-stats.
+
+using heap_t = bip::managed_heap_memory;
+
+namespace detail {
+
+struct LocalSegments {
+
+    std::mutex mutex;
+    std::set<std::string> names;
+    std::map<std::string, std::shared_ptr<heap_t>> segments;
+
+    static LocalSegments &instance()
+    {
+        static LocalSegments local;
+        return local;
+    }
+};
+
+}  // namespace detail
+
+/**
+ * @brief Place the node at an address in this process's memory rather than
+ * shared memory. Must be called before any sink or source uses the address.
+ * @param address Node address, e.g. "raw".
+ */
+inline void makeNodeLocal(const std::string &address)
+{
+    auto &local = detail::LocalSegments::instance();
+    std::lock_guard<std::mutex> lock(local.mutex);
+    local.names.insert(address + "_node");
+    local.names.insert(address + "_obj");
+}
+
+/**
+ * @brief Check if a node address was declared local.
+ * @param address Node address.
+ */
+inline bool isNodeLocal(const std::string &address)
+{
+    auto &local = detail::LocalSegments::instance();
+    std::lock_guard<std::mutex> lock(local.mutex);
+    return local.names.count(address + "_node") > 0;
+}
+
+/**
+ * @brief A managed memory segment holding either part of a node. Backed by
+ * shared memory, or by heap memory if the segment's node is local. Provides
+ * the subset of the managed segment interface used by sinks and sources.
+ */
+class NodeSegment {
+public:
+
+    NodeSegment() = default;
+
+    static NodeSegment openOrCreate(const std::string &name, const size_t bytes)
+    {
+        NodeSegment s;
+        if (!s.findLocal(name, bytes, true))
+            s.shmem_ = shmem_t(bip::open_or_create, name.c_str(), bytes);
+        return s;
+    }
+
+    static NodeSegment create(const std::string &name, const size_t bytes)
+    {
+        NodeSegment s;
+        if (s.isLocal(name)) {
+            if (s.findLocal(name, 0, false))
+                throw std::runtime_error("Local segment " + name
+                                         + " already exists.");
+            s.findLocal(name, bytes, true);
+        } else {
+            s.shmem_ = shmem_t(bip::create_only, name.c_str(), bytes);
+        }
+        return s;
+    }
+
+    static NodeSegment open(const std::string &name)
+    {
+        NodeSegment s;
+        if (s.isLocal(name)) {
+            if (!s.findLocal(name, 0, false))
+                throw std::runtime_error("Local segment " + name
+                                         + " does not exist.");
+        } else {
+            s.shmem_ = shmem_t(bip::open_only, name.c_str());
+        }
+        return s;
+    }
+
+    /**
+     * @brief Remove a segment by name. Like shared memory, the memory of a
+     * local segment is released once the last NodeSegment using it is gone.
+     * @return True if the segment existed.
+     */
+    static bool remove(const std::string &name)
+    {
+        auto &local = detail::LocalSegments::instance();
+        {
+            std::lock_guard<std::mutex> lock(local.mutex);
+            if (local.names.count(name))
+                return local.segments.erase(name) > 0;
+        }
+
+        return bip::shared_memory_object::remove(name.c_str());
+    }
+
+    template <typename T, typename... Args>
+    T *findOrConstruct(const char *name, Args&&... args)
+    {
+        if (heap_)
+            return heap_->find_or_construct<T>(name)(std::forward<Args>(args)...);
+        return shmem_.find_or_construct<T>(name)(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    T *find(const char *name)
+    {
+        return heap_ ? heap_->find<T>(name).first : shmem_.find<T>(name).first;
+    }
+
+    /**
+     * @brief Construct an anonymous array of default constructed objects.
+     */
+    template <typename T>
+    T *constructArray(const size_t n)
+    {
+        if (heap_)
+            return heap_->construct<T>(bip::anonymous_instance)[n]();
+        return shmem_.construct<T>(bip::anonymous_instance)[n]();
+    }
+
+    void *allocate(const size_t bytes)
+    {
+        return heap_ ? heap_->allocate(bytes) : shmem_.allocate(bytes);
+    }
+
+    handle_t handle(const void *address) const
+    {
+        return heap_ ? heap_->get_handle_from_address(address)
+                     : shmem_.get_handle_from_address(address);
+    }
+
+    void *address(const handle_t handle) const
+    {
+        return heap_ ? heap_->get_address_from_handle(handle)
+                     : shmem_.get_address_from_handle(handle);
+    }
+
+    // Number of named objects in the segment
+    size_t numNamed()
+    {
+        return heap_ ? heap_->get_num_named_objects()
+                     : shmem_.get_num_named_objects();
+    }
+
+    bool local() const { return static_cast<bool>(heap_); }
+
+private:
+
+    bool isLocal(const std::string &name) const
+    {
+        auto &local = detail::LocalSegments::instance();
+        std::lock_guard<std::mutex> lock(local.mutex);
+        return local.names.count(name) > 0;
+    }
+
+    // Find a local segment, creating it if bytes > 0 and create is set.
+    // Returns false if the name is not local or the segment was not found.
+    bool findLocal(const std::string &name, const size_t bytes, const bool create)
+    {
+        auto &local = detail::LocalSegments::instance();
+        std::lock_guard<std::mutex> lock(local.mutex);
+
+        if (!local.names.count(name))
+            return false;
+
+        auto it = local.segments.find(name);
+        if (it != local.segments.end()) {
+            heap_ = it->second;
+        } else if (create) {
+            heap_ = std::make_shared<heap_t>(bytes);
+            local.segments.emplace(name, heap_);
+        }
+
+        return static_cast<bool>(heap_);
+    }
+
+    shmem_t shmem_;
+    std::shared_ptr<heap_t> heap_;
+};
+
+}      /* namespace oat */
+#endif /* OAT_NODESEGMENT_H */
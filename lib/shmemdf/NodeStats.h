@@ -0,0 +1,192 @@
+//******************************************************************************
+//* File:   NodeStats.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_NODESTATS_H
+#define	OAT_NODESTATS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <unistd.h>
+
+namespace oat {
+
+// Each Node carries a telemetry block in shared memory. The SINK and each
+// SOURCE update their own part of it from post() using relaxed atomics, and
+// `oat stats` attaches to the node read-only to display it. Durations are
+// measured on the steady clock, which is shared by all processes on a host.
+
+/**
+ * @brief Current time in nanoseconds on a clock that all processes share.
+ */
+inline uint64_t statsNow()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(
+               steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Plain copy of a LatencyHistogram. Snapshots taken at two times can
+ * be subtracted to get the histogram of the interval in between.
+ */
+struct HistogramSnapshot {
+
+    static constexpr size_t NUM_BINS {23};
+
+    uint64_t bins[NUM_BINS] {0};
+    uint64_t total_ns {0};
+
+    uint64_t count() const
+    {
+        uint64_t n = 0;
+        for (auto b : bins)
+            n += b;
+        return n;
+    }
+
+    double mean_us() const
+    {
+        const uint64_t n = count();
+        return n == 0 ? 0.0 : total_ns / 1e3 / n;
+    }
+
+    /**
+     * @brief Upper edge of the bin that contains a percentile.
+     * @param p Percentile, between 0 and 1.
+     * @return Duration in microseconds, or 0 if the histogram is empty.
+     */
+    double percentile_us(const double p) const
+    {
+        const uint64_t n = count();
+        if (n == 0)
+            return 0.0;
+
+        uint64_t cum = 0;
+        for (size_t i = 0; i < NUM_BINS; i++) {
+            cum += bins[i];
+            if (cum >= p * n)
+                return static_cast<double>(1ull << i);
+        }
+
+        return static_cast<double>(1ull << (NUM_BINS - 1));
+    }
+
+    HistogramSnapshot operator-(const HistogramSnapshot &rhs) const
+    {
+        HistogramSnapshot d;
+        for (size_t i = 0; i < NUM_BINS; i++)
+            d.bins[i] = bins[i] - rhs.bins[i];
+        d.total_ns = total_ns - rhs.total_ns;
+        return d;
+    }
+};
+
+/**
+ * @brief Histogram of durations in power-of-two microsecond bins. Bin 0
+ * holds durations under 1 usec, bin i holds [2^(i-1), 2^i) usec, and the last
+ * bin holds everything longer (~2 sec and up). Lives in shared memory.
+ */
+class LatencyHistogram {
+public:
+
+    static constexpr size_t NUM_BINS {HistogramSnapshot::NUM_BINS};
+
+    LatencyHistogram() { clear(); }
+
+    void add(const uint64_t ns)
+    {
+        const uint64_t us = ns / 1000;
+        size_t bin = us == 0 ? 0 : 64 - __builtin_clzll(us);
+        if (bin >= NUM_BINS)
+            bin = NUM_BINS - 1;
+
+        bins_[bin].fetch_add(1, std::memory_order_relaxed);
+        total_ns_.fetch_add(ns, std::memory_order_relaxed);
+    }
+
+    void clear()
+    {
+        for (auto &b : bins_)
+            b.store(0, std::memory_order_relaxed);
+        total_ns_.store(0, std::memory_order_relaxed);
+    }
+
+    HistogramSnapshot snapshot() const
+    {
+        HistogramSnapshot s;
+        for (size_t i = 0; i < NUM_BINS; i++)
+            s.bins[i] = bins_[i].load(std::memory_order_relaxed);
+        s.total_ns = total_ns_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    std::atomic<uint64_t> bins_[NUM_BINS];
+    std::atomic<uint64_t> total_ns_;
+};
+
+/**
+ * @brief SINK telemetry.
+ */
+struct SinkStats {
+
+    LatencyHistogram wait;      //!< Time blocked in wait() on slow SOURCEs
+    LatencyHistogram hold;      //!< Time from wait() returning to post()
+    LatencyHistogram last_read; //!< Time from post() to the last blocking read
+    std::atomic<int64_t> pid {0};
+    std::atomic<uint64_t> evictions {0}; //!< SOURCEs evicted, see Node::evictStaleReaders()
+    std::atomic<uint64_t> dropped {0}; //!< Samples lost to the backpressure policy
+
+    void reset()
+    {
+        wait.clear();
+        hold.clear();
+        last_read.clear();
+        pid = getpid();
+        evictions = 0;
+        dropped = 0;
+    }
+};
+
+/**
+ * @brief Telemetry of a single SOURCE slot. Occupies whole cache lines
+ * because each slot is written by a different process.
+ */
+struct SourceStats {
+
+    LatencyHistogram wait;    //!< Time blocked in wait() on the SINK
+    LatencyHistogram hold;    //!< Time from wait() returning to post()
+    LatencyHistogram latency; //!< Time from the SINK's post() to post()
+
+    void reset()
+    {
+        wait.clear();
+        hold.clear();
+        latency.clear();
+    }
+};
+
+static_assert(sizeof(SourceStats) % 64 == 0,
+              "SourceStats must occupy whole cache lines.");
+
+}      /* namespace oat */
+#endif /* OAT_NODESTATS_H */
@@ -0,0 +1,177 @@
+//******************************************************************************
+//* File:   RingMemory.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_RINGMEMORY_H
+#define	OAT_RINGMEMORY_H
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/statvfs.h>
+#include <unistd.h>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "ForwardsDecl.h"
+
+namespace oat {
+
+// By default, a frame node's ring is allocated inside of the node's managed
+// shared memory segment in /dev/shm, which is backed by normal pages. For
+// large, fast frames, the ring can instead be placed in a file on a hugetlbfs
+// mount (see RingFile) and can be prefaulted and locked into RAM so that
+// there are no page faults once frames start streaming.
+
+/**
+ * @brief Frame ring memory in a file on a hugetlbfs mount (e.g.
+ * /dev/hugepages), which is backed by huge pages. The SINK creates the file
+ * and SOURCEs map the same file when they connect.
+ */
+class RingFile {
+public:
+
+    /**
+     * @brief Create and map the file, replacing any file left at the path.
+     * Its size is rounded up to a multiple of the mount's page size.
+     * @param path Path of the file to create.
+     * @param bytes Minimum size of the file.
+     */
+    void create(const std::string &path, const size_t bytes)
+    {
+        const size_t dir_end = path.find_last_of('/');
+        const std::string dir
+            = dir_end == std::string::npos ? "." : path.substr(0, dir_end + 1);
+
+        struct statvfs fs;
+        if (statvfs(dir.c_str(), &fs) != 0)
+            throw std::runtime_error("Frame ring directory " + dir + " is not "
+                                     "available: " + std::strerror(errno));
+
+        const size_t page = fs.f_bsize;
+        const size_t size = (bytes + page - 1) / page * page;
+
+        // A SINK that crashed leaves its file behind. SOURCEs that still map
+        // it keep their mapping.
+        ::unlink(path.c_str());
+
+        int fd = ::open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0666);
+        if (fd < 0)
+            throw std::runtime_error("Could not create frame ring file " + path
+                                     + ": " + std::strerror(errno));
+
+        int rc = ::ftruncate(fd, size);
+        ::close(fd);
+        if (rc != 0) {
+            ::unlink(path.c_str());
+            throw std::runtime_error("Could not size frame ring file " + path
+                                     + ": " + std::strerror(errno));
+        }
+
+        map(path, size);
+    }
+
+    /**
+     * @brief Map an existing file.
+     * @param path Path of the file.
+     */
+    void open(const std::string &path) { map(path, 0); }
+
+    void * data() const { return region_.get_address(); }
+    size_t size() const { return region_.get_size(); }
+
+private:
+
+    void map(const std::string &path, const size_t size)
+    {
+        bip::file_mapping file(path.c_str(), bip::read_write);
+        bip::mapped_region region(file, bip::read_write, 0, size);
+        region_.swap(region);
+    }
+
+    bip::mapped_region region_;
+};
+
+/**
+ * @brief Touch each page of a frame ring so that it is mapped before frames
+ * start streaming.
+ * @param data Start of the ring.
+ * @param bytes Size of the ring.
+ * @param write True for the SINK, which zeros the ring. SOURCEs only read it.
+ */
+inline void prefaultRing(void *data, const size_t bytes, const bool write)
+{
+    if (write) {
+        std::memset(data, 0, bytes);
+        return;
+    }
+
+    const size_t page = sysconf(_SC_PAGESIZE);
+    volatile const uint8_t *p = static_cast<uint8_t *>(data);
+    for (size_t i = 0; i < bytes; i += page)
+        (void)p[i];
+}
+
+/**
+ * @brief Lock a frame ring into RAM.
+ * @return False if the ring could not be locked, e.g. because RLIMIT_MEMLOCK
+ * is too small.
+ */
+inline bool lockRing(const void *data, const size_t bytes)
+{
+    return mlock(data, bytes) == 0;
+}
+
+/**
+ * @brief Size of the pages that back a mapped address.
+ * @param data Mapped address.
+ * @return Page size in bytes.
+ */
+inline size_t ringPageSize(const void *data)
+{
+#ifdef __linux__
+    const auto addr = reinterpret_cast<uintptr_t>(data);
+    std::ifstream smaps("/proc/self/smaps");
+    std::string line;
+    bool in_mapping = false;
+
+    while (std::getline(smaps, line)) {
+
+        unsigned long start, end;
+        size_t kb;
+        if (std::sscanf(line.c_str(), "%lx-%lx ", &start, &end) == 2)
+            in_mapping = addr >= start && addr < end;
+        else if (in_mapping
+                 && std::sscanf(line.c_str(), "KernelPageSize: %zu kB", &kb) == 1)
+            return kb * 1024;
+    }
+#endif
+
+    return sysconf(_SC_PAGESIZE);
+}
+
+}      /* namespace oat */
+#endif /* OAT_RINGMEMORY_H */
@@ -21,6 +21,9 @@
 #define	OAT_SHAREDFRAMEHEADER_H
 
 #include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <string>
 #include <boost/interprocess/managed_shared_memory.hpp>
 
 #include "../datatypes/Color.h"
@@ -45,6 +48,13 @@ struct FrameParams {
   * two blocks of shared memory, one for matrix data and other for sample count
   * and rate information. Non-pointer members allow construction of Frames at
   * source and sink end contain this data and sample information.
+  *
+  * The handles refer to the first element of a ring of frames and samples. The
+  * number of ring elements is held by the oat::Node. Ring element i's data
+  * begins params_.bytes * i bytes after the data_ handle's address.
+  *
+  * If ring_path() is not empty, the ring's matrix data is instead held in the
+  * file at that path (see RingFile) and the data_ handle is not used.
   */
 
 class SharedFrameHeader {
@@ -56,6 +66,24 @@ public :
     handle_t sample() const { return sample_; }
     handle_t data() const { return data_; }
     FrameParams params() const { return params_; }
+    std::string ring_path() const { return ring_path_; }
+    bool ring_locked() const { return ring_locked_; }
+
+    /**
+     * Set where the ring's matrix data is held and how it is mapped.
+     *
+     * @param path File holding the ring's matrix data. Empty if the data is in
+     * the shared memory segment.
+     * @param locked Ring is prefaulted and locked into RAM
+     */
+    void setRingMemory(const std::string &path, const bool locked)
+    {
+        if (path.size() >= sizeof(ring_path_))
+            throw std::runtime_error("Frame ring path is too long.");
+
+        std::strncpy(ring_path_, path.c_str(), sizeof(ring_path_));
+        ring_locked_ = locked;
+    }
 
     /**
      * Set header data fields.
@@ -65,13 +93,16 @@ public :
      * @param rows Number of rows in the matrix
      * @param cols Number of columns in the matrix
      * @param type OpenCV cv::Mat type of the frame
+     * @param color Pixel color of the frame
+     * @param bytes Number of bytes in a single frame of the ring
      */
     void setParameters(const handle_t data,
                        const handle_t sample,
                        const size_t rows,
                        const size_t cols,
                        const int type,
-                       const oat::PixelColor color)
+                       const oat::PixelColor color,
+                       const size_t bytes)
     {
         data_ = data;
         sample_ = sample;
@@ -79,6 +110,7 @@ public :
         params_.cols = cols;
         params_.type = type;
         params_.color = color;
+        params_.bytes = bytes;
     }
 
 private :
@@ -94,6 +126,10 @@ private :
     // Interprocess matrix data and sample handles
     handle_t data_;
     handle_t sample_;
+
+    // Ring memory outside of the shared memory segment
+    char ring_path_[256] {0};
+    bool ring_locked_ {false};
 };
 
 }       /* namespace oat */
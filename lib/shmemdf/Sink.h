@@ -21,22 +21,48 @@
 #define	OAT_SINK_H
 
 #include <boost/interprocess/managed_shared_memory.hpp>
-#include <boost/thread/thread_time.hpp>
+#include <chrono>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <type_traits>
 
 #include "../datatypes/Color.h"
 #include "../datatypes/Frame.h"
 #include "../datatypes/Sample.h"
 #include "../base/Globals.h"
+#include "../base/Profiler.h"
+#include "../utility/IOFormat.h"
 
 #include "ForwardsDecl.h"
+#include "Interrupt.h"
 #include "Node.h"
+#include "NodeSegment.h"
+#include "RingMemory.h"
 #include "SharedFrameHeader.h"
 
 namespace oat {
 
+namespace detail {
+
+// The sample of a shared object that exposes a mutable one, which is stamped
+// each time the object is published
+template <typename T>
+inline auto publishedSample(T *obj, int) -> typename std::enable_if<
+    std::is_same<decltype(obj->sample()), Sample &>::value, Sample *>::type
+{
+    return obj == nullptr ? nullptr : &obj->sample();
+}
+
+template <typename T>
+inline Sample *publishedSample(T *, long)
+{
+    return nullptr;
+}
+
+}  // namespace detail
+
 template <typename T>
 class SinkBase {
 public:
@@ -47,20 +73,104 @@ public:
     SinkBase &operator=(const SinkBase &) = delete;
     SinkBase(const SinkBase& orig) = delete;
 
-    void wait();
+    /**
+     * @brief Wait until the ring slot that will be written next may be
+     * written.
+     * @return False if the backpressure policy is DROP_NEWEST and a blocking
+     * source has yet to read the ring slot, or if the wait was interrupted
+     * because quit was set. The sample must then be discarded: the shared
+     * object must not be written and post() must not be called.
+     */
+    bool wait();
     void post();
 
+    /**
+     * @brief Check if wait() would block on sources that have yet to read
+     * the ring slot that will be written next. Lets sinks that pass samples
+     * along release their upstream read before waiting on downstream ones.
+     */
+    bool wouldBlock() const
+    {
+        // Under DROP_NEWEST, wait() discards the sample rather than wait for
+        // blocking sources
+        return backpressure_ == BackpressurePolicy::DROP_NEWEST
+                   ? node_->writeSlotAvailable()
+                         && node_->writeSlotReaders() != 0
+                   : node_->writeSlotBlocked();
+    }
+
+    /**
+     * @brief Set what the sink does when sources have yet to read the ring
+     * slot that will be written next. Must be called before bind(). Samples
+     * that are lost are counted in the node's telemetry and show up as gaps
+     * in Sample::count().
+     * @param policy Backpressure policy. Defaults to
+     * BackpressurePolicy::BLOCK.
+     */
+    void set_backpressure(const BackpressurePolicy policy);
+
+    /**
+     * @brief Set the number of sources that can connect to the node. Must be
+     * called before bind().
+     * @param max_sources Number of sources, up to Node::MAX_SLOTS. Defaults
+     * to Node::NUM_SLOTS.
+     */
+    void set_max_sources(const size_t max_sources);
+
+    /**
+     * @brief Set how long a blocking source may hold up the sink without
+     * reading before it is evicted and made non-blocking. Sources whose
+     * process has died are always evicted once they have held up the sink
+     * for a second.
+     * @param deadline Deadline. Zero, the default, disables eviction of live
+     * sources.
+     */
+    void set_reader_deadline(const std::chrono::milliseconds deadline)
+    {
+        reader_deadline_ns_ = std::chrono::duration_cast<
+            std::chrono::nanoseconds>(deadline).count();
+    }
+
 protected:
 
     std::string address_;
-    shmem_t node_shmem_, obj_shmem_;
+    NodeSegment node_shmem_, obj_shmem_;
     Node * node_ {nullptr};
     T * sh_object_ {nullptr};
     std::string node_address_, obj_address_;
+    size_t max_sources_ {Node::NUM_SLOTS};
+    BackpressurePolicy backpressure_ {BackpressurePolicy::BLOCK};
     bool bound_ {false};
 
+    /**
+     * @brief The sample of the object being published, which post() stamps
+     * to trace its latency. See Sample::stamp().
+     * @return Sample, or nullptr if the shared object does not carry one.
+     */
+    virtual oat::Sample *publishedSample()
+    {
+        return detail::publishedSample(sh_object_, 0);
+    }
+
+    /**
+     * @brief Check that the backpressure policy can be used with a ring of
+     * a given depth. Called by bind().
+     * @param depth Number of ring slots.
+     */
+    void checkBackpressure(const size_t depth) const;
+
 private:
+    // Check for dead and unresponsive sources
+    void evictStaleReaders(const uint64_t blocked_ns);
+
+    // How long DROP_NEWEST drops every sample before checking for sources
+    // that are dead or past the reader deadline
+    static constexpr uint64_t DROP_EVICTION_PERIOD_NS {100000000};
+
     bool did_wait_need_post_ {false};
+    uint64_t wait_begin_ns_ {0}, wait_end_ns_ {0}; //!< Telemetry
+    uint64_t reader_deadline_ns_ {0};
+    uint64_t drop_begin_ns_ {0}; //!< Start of a run of DROP_NEWEST drops
 };
 
 template <typename T>
@@ -75,12 +185,13 @@ inline SinkBase<T>::~SinkBase()
     // Detach this server from shared mat header
     if (bound_) {
 
-        node_->set_sink_state(NodeState::END);
+        // Release any sources waiting on this sink
+        node_->notifySinkEnd();
 
         // If the client ref count is 0, memory can be deallocated
         if (node_->source_ref_count() == 0 &&
-            bip::shared_memory_object::remove(node_address_.c_str()) &&
-            bip::shared_memory_object::remove(obj_address_.c_str())) {
+            NodeSegment::remove(node_address_) &&
+            NodeSegment::remove(obj_address_)) {
 
 #ifndef NDEBUG
         std::cout << "Shared memory at \'" + node_address_ +
@@ -91,7 +202,53 @@ inline SinkBase<T>::~SinkBase()
 }
 
 template <typename T>
-inline void SinkBase<T>::wait()
+inline void SinkBase<T>::set_max_sources(const size_t max_sources)
+{
+    if (bound_)
+        throw std::runtime_error("Maximum number of sources must be set "
+                                 "before the sink binds.");
+
+    if (max_sources == 0 || max_sources > Node::MAX_SLOTS)
+        throw std::runtime_error("Maximum number of sources must be between 1 "
+                                 "and " + std::to_string(Node::MAX_SLOTS) + ".");
+
+    max_sources_ = max_sources;
+}
+
+template <typename T>
+inline void SinkBase<T>::set_backpressure(const BackpressurePolicy policy)
+{
+    if (bound_)
+        throw std::runtime_error("Backpressure policy must be set before the "
+                                 "sink binds.");
+
+    backpressure_ = policy;
+}
+
+template <typename T>
+inline void SinkBase<T>::checkBackpressure(const size_t depth) const
+{
+    // A source that catches up reads the previous ring slot while the sink
+    // writes the next one, so the two must differ
+    if (backpressure_ == BackpressurePolicy::DROP_OLDEST && depth < 2)
+        throw std::runtime_error("The drop-oldest backpressure policy "
+                                 "requires a ring at least two samples deep. "
+                                 "Use block or drop-newest.");
+}
+
+template <typename T>
+inline void SinkBase<T>::evictStaleReaders(const uint64_t blocked_ns)
+{
+    const size_t evicted = node_->evictStaleReaders(
+        blocked_ns > reader_deadline_ns_ ? reader_deadline_ns_ : 0);
+
+    if (evicted > 0)
+        std::cerr << oat::whoWarn(address_, std::to_string(evicted)
+            + " unresponsive source(s) were evicted from the node.\n");
+}
+
+template <typename T>
+inline bool SinkBase<T>::wait()
 {
 #ifndef NDEBUG
     // Don't use Asserts because it does not clean shmem
@@ -101,18 +258,74 @@ inline void SinkBase<T>::wait()
         throw std::runtime_error("wait() called when post() was required.");
 #endif
 
-    boost::system_time timeout = boost::get_system_time() + msec_t(10);
+    wait_begin_ns_ = statsNow();
+
+    Profiler *profiler = Profiler::current();
+    if (profiler)
+        profiler->beginWait(true);
+
+    // Under the drop policies the SINK does not wait for SOURCEs that have
+    // yet to read
+    if (backpressure_ != BackpressurePolicy::BLOCK
+        && !node_->writeSlotAvailable()) {
+
+        node_->sink_stats.dropped.fetch_add(1, std::memory_order_relaxed);
 
-    // Only wait if there is a SOURCE attached to the node
-    // Wait with timed wait with period check to prevent deadlocks
-    while (node_->source_ref_count() > 0 &&
-          !node_->write_barrier.timed_wait(timeout) &&
-          !quit) {
-        // Loops checking if wait has been released
-        timeout = boost::get_system_time() + msec_t(10);
+        if (backpressure_ == BackpressurePolicy::DROP_NEWEST) {
+
+            // A dead SOURCE would otherwise cause every sample to be dropped
+            if (drop_begin_ns_ == 0) {
+                drop_begin_ns_ = wait_begin_ns_;
+            } else if (wait_begin_ns_ - drop_begin_ns_
+                       > DROP_EVICTION_PERIOD_NS) {
+                evictStaleReaders(wait_begin_ns_ - drop_begin_ns_);
+                drop_begin_ns_ = wait_begin_ns_;
+            }
+
+            if (profiler)
+                profiler->endWait();
+            return false;
+        }
     }
 
+    drop_begin_ns_ = 0;
+
+    // Only wait if a blocking SOURCE has yet to read the ring slot that will
+    // be written next or if a SOURCE is in the middle of reading it. Each
+    // post to the write_barrier is a hint that the slot might have become
+    // available, so check again after every wakeup. Periodically check for
+    // SOURCEs that have died or stopped reading so that they cannot stall
+    // the SINK forever.
+    do {
+        while (node_->writeSlotBlocked()) {
+
+            if (!node_->announceSinkWait()
+                || oat::interruptibleTimedWait(node_->write_barrier,
+                                               std::chrono::milliseconds(100)))
+                continue;
+
+            if (quit) {
+                if (profiler)
+                    profiler->endWait();
+                return false;
+            }
+
+            evictStaleReaders(statsNow() - wait_begin_ns_);
+        }
+
+        node_->notifySinkWriteBegin();
+
+    } while (node_->writeSlotRaced());
+
+    wait_end_ns_ = statsNow();
     did_wait_need_post_ = true;
+
+    if (profiler) {
+        profiler->endWait();
+        profiler->beginCritical(true);
+    }
+
+    return true;
 }
 
 template <typename T>
@@ -126,9 +339,24 @@ inline void SinkBase<T>::post()
         throw std::runtime_error("post() called when wait() was required.");
 #endif
 
+    node_->sink_stats.wait.add(wait_end_ns_ - wait_begin_ns_);
+    const uint64_t now = statsNow();
+    node_->sink_stats.hold.add(now - wait_end_ns_);
+
+    // Stamp the sample on its way out so that downstream components can
+    // measure the latency of each hop
+    if (oat::Sample *sample = publishedSample()) {
+        sample->stamp(now);
+        if (Profiler *p = Profiler::current())
+            p->traceSample(*sample);
+    }
+
     // Increment the number times this node has facilitated a shmem write
     node_->notifySinkWriteComplete();
 
+    if (Profiler *p = Profiler::current())
+        p->endCritical(true);
+
     did_wait_need_post_ = false;
 
 #ifndef NDEBUG
@@ -151,7 +379,10 @@ class Sink : public SinkBase<T> {
     using SinkBase<T>::obj_shmem_;
     using SinkBase<T>::node_;
     using SinkBase<T>::sh_object_;
+    using SinkBase<T>::max_sources_;
+    using SinkBase<T>::backpressure_;
     using SinkBase<T>::bound_;
+    using SinkBase<T>::checkBackpressure;
 
 public:
 
@@ -159,8 +390,36 @@ public:
     void bind(const std::string &address, Targs... args);
     T * retrieve();
 
+    /**
+     * @brief Publish metadata that is constant for the lifetime of the node
+     * alongside the shared object. Sources read it once when they connect,
+     * using Source<T>::metadata(), so that it does not have to be copied
+     * with every sample. Must be called before bind().
+     * @param metadata Metadata. M is placed in shared memory, so it must not
+     * hold pointers or own heap memory.
+     */
+    template <typename M>
+    void set_metadata(const M &metadata);
+
+private:
+
+    std::function<void(NodeSegment &)> construct_metadata_;
+    size_t metadata_bytes_ {0};
 };
 
+template <typename T>
+template <typename M>
+inline void Sink<T>::set_metadata(const M &metadata)
+{
+    if (bound_)
+        throw std::runtime_error("Metadata must be set before the sink binds.");
+
+    construct_metadata_ = [metadata](NodeSegment &segment) {
+        segment.template findOrConstruct<M>(typeid(M).name(), metadata);
+    };
+    metadata_bytes_ = 1024 + sizeof(M);
+}
+
 template <typename T>
 template <typename... Targs>
 inline void Sink<T>::bind(const std::string &address, Targs... args)
@@ -169,6 +428,9 @@ inline void Sink<T>::bind(const std::string &address, Targs... args)
         throw std::runtime_error("A sink can only bind a "
                                  "single time to a single node.");
 
+    // The shared object is not a ring
+    checkBackpressure(1);
+
     // Addresses for this block of shared memory
     address_ = address;
     node_address_ = address + "_node";
@@ -178,13 +440,10 @@ inline void Sink<T>::bind(const std::string &address, Targs... args)
     // Extra 1024 bytes are used to hold managed shared mem helper objects
     // (name-object index, internal synchronization objects, internal
     // variables...)
-    node_shmem_ = bip::managed_shared_memory(
-            bip::open_or_create,
-            node_address_.c_str(),
-            1024 + sizeof(Node));
+    node_shmem_ = NodeSegment::openOrCreate(node_address_, 1024 + sizeof(Node));
 
     // Bind to a node which facilitates synchronized access to shmem
-    node_ = node_shmem_.template find_or_construct<Node>(typeid(Node).name())();
+    node_ = node_shmem_.template findOrConstruct<Node>(typeid(Node).name());
 
     // Make sure there is not another SINK using this shmem
     if (node_->sink_state() != NodeState::UNDEFINED) {
@@ -194,13 +453,19 @@ inline void Sink<T>::bind(const std::string &address, Targs... args)
                 "Requested SINK address, '" + address + "', is not available."));
     } else {
 
-        obj_shmem_ = bip::managed_shared_memory(
-            bip::create_only,
-            obj_address_.c_str(),
-            1024 + sizeof (T));
+        node_->set_num_slots(max_sources_);
+        node_->set_backpressure(backpressure_);
+        node_->sink_stats.reset();
+
+        obj_shmem_ = NodeSegment::create(obj_address_,
+                                         1024 + sizeof (T) + metadata_bytes_);
+
+        // Metadata must be in place before sources can connect
+        if (construct_metadata_)
+            construct_metadata_(obj_shmem_);
 
         // Find an existing shared object or construct one
-        sh_object_ = obj_shmem_.template find_or_construct<T>(typeid(T).name())(args...);
+        sh_object_ = obj_shmem_.template findOrConstruct<T>(typeid(T).name(), args...);
         node_->set_sink_state(NodeState::SINK_BOUND);
         bound_ = true;
     }
@@ -224,30 +489,161 @@ template <>
 class Sink<Frame> : public SinkBase<SharedFrameHeader> {
 
 public:
-    void bind(const std::string &address, const size_t bytes);
-    oat::Frame retrieve(const size_t rows, size_t cols, const int type, const
-            oat::PixelColor color);
+    ~Sink();
+
+    /**
+     * @brief Hold the frame ring in a file on a hugetlbfs mount, which is
+     * backed by huge pages, instead of in the node's shared memory segment.
+     * Must be called before bind().
+     * @param dir hugetlbfs mount point, e.g. /dev/hugepages
+     */
+    void set_huge_page_dir(const std::string &dir);
+
+    /**
+     * @brief Prefault the frame ring and lock it into RAM when it is
+     * allocated. Sources lock the ring when they connect. Must be called
+     * before bind().
+     * @param lock True to lock the ring.
+     */
+    void set_lock_ring(const bool lock);
+
+    /**
+     * @brief Bind to a node and allocate a ring of frames in shared memory.
+     * @param address Node address
+     * @param bytes Number of bytes in each frame
+     * @param depth Number of frames in the ring. Readers may fall up to this
+     * many frames behind before the sink blocks.
+     */
+    void bind(const std::string &address,
+              const size_t bytes,
+              const size_t depth = 1);
+
+    /**
+     * @brief Allocate the frame ring and retrieve a pointer to the frame that
+     * will be written next. The pointed to frame is moved to the next ring
+     * slot by each call to wait().
+     * @return Pointer to the shared frame
+     */
+    oat::Frame * retrieve(const size_t rows,
+                          const size_t cols,
+                          const int type,
+                          const oat::PixelColor color);
+
+    bool wait();
+
+    /**
+     * @brief Wait for the next ring slot to become writable and return the
+     * frame that occupies it. Producers can decode or filter directly into
+     * this frame and then publish it using commit(). This replaces
+     * wait(), a copy into the frame returned by retrieve(), and post().
+     * If the backpressure policy drops this sample, a private frame is
+     * returned instead and commit() discards it, so producers need not
+     * check.
+     * @return Pointer to the shared frame in the next ring slot
+     */
+    oat::Frame * acquire();
+
+    /**
+     * @brief Increment the sample count of the acquired frame and tell
+     * sources there is new data. For pure sinks.
+     */
+    void commit();
+
+    /**
+     * @brief Increment the sample count of the acquired frame using an
+     * external clock reading and tell sources there is new data. For pure
+     * sinks.
+     * @param usec Current sample time in microseconds
+     */
+    void commit(const oat::Sample::Microseconds usec);
+
+    /**
+     * @brief Propagate upstream sample information to the acquired frame and
+     * tell sources there is new data. For sinks that pass frames along.
+     * @param sample Sample information of the frame that was written
+     */
+    void commit(const oat::Sample &sample);
+
+    size_t ring_depth() const { return node_ == nullptr ? 1 : node_->ring_depth(); }
+
+protected:
+
+    oat::Sample *publishedSample() override
+    {
+        return samples_ == nullptr ? nullptr : samples_ + node_->write_index();
+    }
+
+private:
+    // Make sure the acquired frame's data is in its ring slot and post
+    void publish();
+
+    // Ring memory options
+    std::string huge_page_dir_;
+    bool lock_ring_ {false};
+    oat::RingFile ring_file_;
+    std::string ring_path_;
+
+    // Ring storage in shared memory
+    uint8_t * data_ {nullptr};
+    oat::Sample * samples_ {nullptr};
+    oat::FrameParams params_;
+
+    // Frame in the ring slot that will be written next
+    oat::Frame frame_;
+
+    // Private frame that a DROP_NEWEST sample is written to instead. Its
+    // sample information is carried forward to the next published frame so
+    // that dropped samples show up as gaps in the sample count.
+    cv::Mat dropped_data_;
+    oat::Sample dropped_sample_;
+    bool dropping_ {false}, carry_dropped_sample_ {false};
 };
 
-inline void Sink<Frame>::bind(const std::string &address, const size_t bytes)
+inline Sink<Frame>::~Sink()
+{
+    // If there are no sources left, we are the last user of the ring file
+    if (!ring_path_.empty() && node_->source_ref_count() == 0)
+        ::unlink(ring_path_.c_str());
+}
+
+inline void Sink<Frame>::set_huge_page_dir(const std::string &dir)
+{
+    if (bound_)
+        throw std::runtime_error("Huge page directory must be set before the "
+                                 "sink binds.");
+
+    huge_page_dir_ = dir;
+}
+
+inline void Sink<Frame>::set_lock_ring(const bool lock)
+{
+    if (bound_)
+        throw std::runtime_error("Frame ring locking must be set before the "
+                                 "sink binds.");
+
+    lock_ring_ = lock;
+}
+
+inline void Sink<Frame>::bind(const std::string &address,
+                              const size_t bytes,
+                              const size_t depth)
 {
     if (bound_)
         throw std::runtime_error("A sink can only bind a "
                                  "single time to a single node.");
 
+    checkBackpressure(depth);
+
     // Addresses for this block of shared memory
     address_ = address;
     node_address_ = address + "_node";
     obj_address_ = address + "_obj";
 
     // Define shared memory
-    node_shmem_ = bip::managed_shared_memory(
-            bip::open_or_create,
-            node_address_.c_str(),
-            1024  + sizeof(Node));
+    node_shmem_ = NodeSegment::openOrCreate(node_address_, 1024  + sizeof(Node));
 
     // Facilitates synchronized access to shmem
-    node_ = node_shmem_.find_or_construct<Node>(typeid(Node).name())();
+    node_ = node_shmem_.findOrConstruct<Node>(typeid(Node).name());
 
     // Make sure there is not another SINK using this shmem
     if (node_->sink_state() != NodeState::UNDEFINED) {
@@ -257,44 +653,190 @@ inline void Sink<Frame>::bind(const std::string &address, const size_t bytes)
                 "Requested SINK address, '" + address + "', is not available."));
     } else {
 
-        // Object shared memory
-        obj_shmem_ = bip::managed_shared_memory(
-            bip::create_only,
-            obj_address_.c_str(),
-            1024 + sizeof(SharedFrameHeader) + bytes + sizeof(uint64_t));
+        node_->set_num_slots(max_sources_);
+        node_->set_backpressure(backpressure_);
+        node_->sink_stats.reset();
+        node_->set_ring_depth(depth);
+
+        // Object shared memory. Holds the frame ring unless it is on huge
+        // pages.
+        const size_t ring_bytes = huge_page_dir_.empty() ? depth * bytes : 0;
+        obj_shmem_ = NodeSegment::create(
+            obj_address_,
+            1024 + sizeof(SharedFrameHeader) + ring_bytes
+                 + depth * sizeof(oat::Sample) + sizeof(uint64_t));
 
         // Find an existing shared object or construct one
-        sh_object_ = obj_shmem_.find_or_construct<SharedFrameHeader>(typeid(SharedFrameHeader).name())();
+        sh_object_ = obj_shmem_.findOrConstruct<SharedFrameHeader>(typeid(SharedFrameHeader).name());
 
         node_->set_sink_state(NodeState::SINK_BOUND);
         bound_ = true;
     }
 }
 
-inline oat::Frame Sink<Frame>::retrieve(const size_t rows,
-                                        const size_t cols,
-                                        const int type,
-                                        const oat::PixelColor color)
+inline oat::Frame * Sink<Frame>::retrieve(const size_t rows,
+                                          const size_t cols,
+                                          const int type,
+                                          const oat::PixelColor color)
 {
     // Make sure that the SINK is bound to a shared memory segment
     //assert(bound_);
     if (!bound_)
         throw (std::runtime_error("SINK must be bound before shared frame is retrieved."));
 
-    // Allocate memory for sample number
-    void * sample = obj_shmem_.allocate(sizeof(oat::Sample));
-    handle_t sample_handle = obj_shmem_.get_handle_from_address(sample);
+    const size_t depth = node_->ring_depth();
+
+    // Allocate memory for sample numbers, one per ring slot
+    samples_ = obj_shmem_.constructArray<oat::Sample>(depth);
+    handle_t sample_handle = obj_shmem_.handle(samples_);
 
-    // Allocate memory for the shared object's data
+    // Allocate memory for the shared object's data, one frame per ring slot
     cv::Mat temp(rows, cols, type);
-    void * data = obj_shmem_.allocate(temp.total() * temp.elemSize());
-    handle_t data_handle = obj_shmem_.get_handle_from_address(data);
+    const size_t bytes = temp.total() * temp.elemSize();
+    const size_t ring_bytes = depth * bytes;
+    handle_t data_handle = 0;
+
+    if (huge_page_dir_.empty()) {
+        data_ = static_cast<uint8_t *>(obj_shmem_.allocate(ring_bytes));
+        data_handle = obj_shmem_.handle(data_);
+    } else {
+        ring_path_ = huge_page_dir_ + "/" + address_ + "_ring";
+        ring_file_.create(ring_path_, ring_bytes);
+        data_ = static_cast<uint8_t *>(ring_file_.data());
+    }
 
     // Reset the SharedFrameHeader's parameters now that we know what they should be
-    sh_object_->setParameters(data_handle, sample_handle, rows, cols, type, color);
+    sh_object_->setParameters(data_handle, sample_handle, rows, cols, type, color, bytes);
+    sh_object_->setRingMemory(ring_path_, lock_ring_);
+    params_ = sh_object_->params();
+
+    // Map the ring up front rather than on first write
+    if (!huge_page_dir_.empty() || lock_ring_) {
+
+        prefaultRing(data_, ring_bytes, true);
+
+        if (lock_ring_ && !lockRing(data_, ring_bytes))
+            std::cerr << oat::whoWarn(address_, "frame ring could not be "
+                         "locked into RAM. Check RLIMIT_MEMLOCK.\n");
+
+        std::cout << oat::whoMessage(address_,
+                     "frame ring of " + std::to_string(ring_bytes) + " bytes "
+                     "backed by " + std::to_string(ringPageSize(data_) / 1024)
+                     + " kB pages.\n");
+    }
+
+    // Point to the first ring slot
+    frame_ = oat::Frame(rows, cols, type, color, data_, samples_);
 
     // Return pointer to memory allocated for shared object
-    return oat::Frame(rows, cols, type, color, data, sample);
+    return &frame_;
+}
+
+inline bool Sink<Frame>::wait()
+{
+    const bool publish = SinkBase<SharedFrameHeader>::wait();
+
+    // Sample information of the previous write, which is carried forward
+    const size_t depth = node_->ring_depth();
+    const size_t i = node_->write_index();
+    const oat::Sample &previous = carry_dropped_sample_ ? dropped_sample_
+        : samples_[node_->write_number() > 0 ? (i + depth - 1) % depth : i];
+
+    if (!publish) {
+
+        // Write to the private frame instead
+        dropped_data_.create(params_.rows, params_.cols, params_.type);
+        dropped_sample_ = previous;
+        dropping_ = true;
+
+        frame_ = oat::Frame(params_.rows,
+                            params_.cols,
+                            params_.type,
+                            frame_.color(),
+                            dropped_data_.data,
+                            &dropped_sample_);
+        return false;
+    }
+
+    // Move to the ring slot that will be written next
+    samples_[i] = previous;
+    carry_dropped_sample_ = false;
+
+    frame_ = oat::Frame(params_.rows,
+                        params_.cols,
+                        params_.type,
+                        frame_.color(),
+                        data_ + i * params_.bytes,
+                        samples_ + i);
+    return true;
+}
+
+inline oat::Frame * Sink<Frame>::acquire()
+{
+    if (data_ == nullptr)
+        throw (std::runtime_error("SINK must retrieve() its shared frame before acquiring it."));
+
+    wait();
+
+    return &frame_;
+}
+
+inline void Sink<Frame>::commit()
+{
+    frame_.incrementSampleCount();
+    publish();
+}
+
+inline void Sink<Frame>::commit(const oat::Sample::Microseconds usec)
+{
+    frame_.incrementSampleCount(usec);
+    publish();
+}
+
+inline void Sink<Frame>::commit(const oat::Sample &sample)
+{
+    if (dropping_)
+        dropped_sample_ = sample;
+    else
+        samples_[node_->write_index()] = sample;
+    publish();
+}
+
+inline void Sink<Frame>::publish()
+{
+    // The backpressure policy dropped this sample
+    if (dropping_) {
+        dropping_ = false;
+        carry_dropped_sample_ = true;
+        return;
+    }
+
+    // If the producer reallocated the frame (e.g. by assigning the result of
+    // an operation that could not be performed in place), its data is no
+    // longer in shared memory and must be copied into the ring slot
+    const size_t i = node_->write_index();
+    uint8_t * slot = data_ + i * params_.bytes;
+
+    if (frame_.data != slot) {
+
+        if (frame_.rows != static_cast<int>(params_.rows)
+            || frame_.cols != static_cast<int>(params_.cols)
+            || frame_.type() != params_.type)
+            throw (std::runtime_error("Frame written to SINK does not "
+                                      "match its shared frame parameters."));
+
+        cv::Mat shared(params_.rows, params_.cols, params_.type, slot);
+        static_cast<cv::Mat &>(frame_).copyTo(shared);
+
+        frame_ = oat::Frame(params_.rows,
+                            params_.cols,
+                            params_.type,
+                            frame_.color(),
+                            slot,
+                            samples_ + i);
+    }
+
+    post();
 }
 
 } // namespace oat
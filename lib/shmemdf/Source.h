@@ -21,21 +21,29 @@
 #define	OAT_SOURCE_H
 
 #include "ForwardsDecl.h"
+#include "Interrupt.h"
 #include "Node.h"
+#include "NodeSegment.h"
+#include "RingMemory.h"
 #include "SharedFrameHeader.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <exception>
 #include <iostream>
 #include <memory>
 #include <sstream>
 #include <string>
 #include <thread>
+#include <type_traits>
 
 #include <boost/interprocess/managed_shared_memory.hpp>
-#include <boost/thread/thread_time.hpp>
 
 #include "../datatypes/Frame.h"
 #include "../base/Globals.h"
+#include "../base/Profiler.h"
+#include "../utility/IOFormat.h"
 
 namespace oat {
 
@@ -49,19 +57,67 @@ enum class SourceState : std::int16_t
     CONNECTED       = 2,
 };
 
+enum class SourceMode
+{
+    BLOCKING,     //!< Reads every write. The SINK waits for this source
+                  //!< unless its BackpressurePolicy drops samples.
+    NON_BLOCKING, //!< Only holds up the SINK while reading a ring slot,
+                  //!< between wait() and post(). Skips to the most recent
+                  //!< write if it falls behind the SINK's ring.
+    LATEST        //!< Does not take a slot in the node, so the SINK is
+                  //!< unaware of it. Copies the most recent write, so
+                  //!< only Frames and LatestCopyable types are allowed.
+};
+
+/**
+ * @brief Type-independent SOURCE synchronization, which lets waitAll() wait
+ * on SOURCEs of different types.
+ */
+class SourceSync {
+public:
+    virtual ~SourceSync() { }
+
+    virtual NodeState wait() = 0;
+
+    /**
+     * @brief Like wait(), but gives up after a timeout.
+     * @param timeout Maximum time to block. If zero, only checks for a new
+     * write.
+     * @param state Set to the node state if the wait completed.
+     * @return True if the wait completed, in which case post() must be
+     * called as after wait().
+     */
+    virtual bool tryWait(const std::chrono::microseconds timeout,
+                         NodeState &state) = 0;
+    virtual void post() = 0;
+
+    /**
+     * @brief Have the SINK post a Waker each time this source may read, so
+     * that one thread can block until any of several sources may read.
+     * @param id Waker::id(), or Waker::NONE to unregister.
+     * @return False if the source cannot post a Waker, e.g. because it holds
+     * no slot in the node, in which case it must be polled.
+     */
+    virtual bool set_waker(const uint32_t id) = 0;
+};
+
 template <typename T>
-class SourceBase {
+class SourceBase : public SourceSync {
 public:
     SourceBase();
     virtual ~SourceBase();
 
     // Node connection
-    void touch(const std::string &address);
+    void touch(const std::string &address,
+               const SourceMode mode = SourceMode::BLOCKING);
     virtual SourceState connect(void);
 
     // Sychronization
-    NodeState wait();
-    void post();
+    NodeState wait() override;
+    bool tryWait(const std::chrono::microseconds timeout,
+                 NodeState &state) override;
+    void post() override;
+    bool set_waker(const uint32_t id) override;
 
     uint64_t write_number() const
     {
@@ -70,15 +126,39 @@ public:
 
 protected:
 
-    shmem_t node_shmem_, obj_shmem_;
+    /**
+     * @brief Copy the most recent write into private storage. Used by
+     * SourceMode::LATEST sources, which read the shared object while the
+     * SINK may be writing to it, so the copy might be torn and is checked
+     * afterwards.
+     * @param n Current write_number(). The most recent write is n - 1.
+     */
+    virtual void copyLatest(const uint64_t n) = 0;
+
+    NodeSegment node_shmem_, obj_shmem_;
     T * sh_object_ {nullptr};
     Node * node_ {nullptr};
     std::string address_, node_address_, obj_address_;
     size_t slot_index_ {0};
+    SourceMode mode_ {SourceMode::BLOCKING};
+    uint64_t latest_read_ {0}; //!< write_number() of LATEST source's last copy
     std::atomic<SourceState> state_ {SourceState::VIRGIN};
     bool touched_ {false};
     bool connected_ {false};
     bool did_wait_need_post_ {false};
+    uint64_t wait_begin_ns_ {0}, wait_end_ns_ {0}; //!< Telemetry
+
+    // LATEST sources hold no slot, so nothing posts to them and they must
+    // poll the node
+    bool pollSinkBound();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Copy a write that has not been copied yet. Returns false if quit was
+    // set, the SINK ENDed, or the deadline passed first.
+    bool waitLatest(const Clock::time_point deadline = Clock::time_point::max());
+    NodeState waitComplete(const bool released);
 };
 
 template <typename T>
@@ -92,7 +172,8 @@ inline SourceBase<T>::~SourceBase()
 {
     // If we have touched the node, or there was a node type mismatch, we must
     // release our slot
-    if (state_ >= SourceState::TOUCHED || state_ == SourceState::ERR_TYPEMIS)
+    if ((state_ >= SourceState::TOUCHED || state_ == SourceState::ERR_TYPEMIS)
+        && mode_ != SourceMode::LATEST)
         node_->releaseSlot(slot_index_);
 
     // If the client reference count is 0 and there is no server
@@ -101,8 +182,8 @@ inline SourceBase<T>::~SourceBase()
         node_->sink_state() != NodeState::SINK_BOUND) {
 
         bool shmem_freed = false;
-        shmem_freed |= bip::shared_memory_object::remove(node_address_.c_str());
-        shmem_freed |= bip::shared_memory_object::remove(obj_address_.c_str());
+        shmem_freed |= NodeSegment::remove(node_address_);
+        shmem_freed |= NodeSegment::remove(obj_address_);
 
 #ifndef NDEBUG
         if (shmem_freed)
@@ -112,7 +193,8 @@ inline SourceBase<T>::~SourceBase()
 }
 
 template <typename T>
-inline void SourceBase<T>::touch(const std::string &address)
+inline void SourceBase<T>::touch(const std::string &address,
+                                  const SourceMode mode)
 {
     // Make sure we did not connect already
     if (state_ != SourceState::VIRGIN)
@@ -128,16 +210,15 @@ inline void SourceBase<T>::touch(const std::string &address)
     // Extra 1024 bytes are used to hold managed shared mem helper objects
     // (name-object index, internal synchronization objects, internal
     // variables...)
-    node_shmem_ = bip::managed_shared_memory(
-            bip::open_or_create,
-            node_address_.c_str(),
-            1024 + sizeof(Node));
+    node_shmem_ = NodeSegment::openOrCreate(node_address_, 1024 + sizeof(Node));
 
     // Facilitates synchronized access to shmem
-    node_ = node_shmem_.find_or_construct<Node>(typeid(Node).name())();
+    node_ = node_shmem_.findOrConstruct<Node>(typeid(Node).name());
 
     // Let the node know this source is attached and retrieve *this's index
-    if (node_->acquireSlot(slot_index_) < 0) {
+    mode_ = mode;
+    if (mode_ != SourceMode::LATEST
+        && node_->acquireSlot(slot_index_, mode_ == SourceMode::BLOCKING) < 0) {
         state_ = SourceState::ERR_NODEFULL;
         return;
     }
@@ -155,7 +236,12 @@ inline SourceState SourceBase<T>::connect()
                                  "touch()ed a node.");
 
     // Wait for the SINK to bind and construct the shared object
-    if (node_->sink_state() != NodeState::SINK_BOUND) {
+    if (mode_ == SourceMode::LATEST) {
+
+        if (!pollSinkBound())
+            return SourceState::ERR_CONNECT;
+
+    } else if (node_->sink_state() != NodeState::SINK_BOUND) {
 
         if (wait() != NodeState::SINK_BOUND)
             return SourceState::ERR_CONNECT; // No throw because this can occur
@@ -166,13 +252,12 @@ inline SourceState SourceBase<T>::connect()
         // wait() a 'freebie'
         node_->read_barrier(slot_index_).post();
         did_wait_need_post_ = false;
+        wait_begin_ns_ = 0;
     }
 
     // Find an existing shared object constructed by the SINK
-    obj_shmem_ =
-            bip::managed_shared_memory(bip::open_only, obj_address_.c_str());
-    std::pair<T *,std::size_t> temp = obj_shmem_.find<T>(typeid(T).name());
-    sh_object_ = temp.first;
+    obj_shmem_ = NodeSegment::open(obj_address_);
+    sh_object_ = obj_shmem_.find<T>(typeid(T).name());
 
     // Only occurs when the name of the shared object does not match typeid(T).name()
     if (sh_object_ == nullptr) {
@@ -195,22 +280,110 @@ inline NodeState SourceBase<T>::wait()
         throw std::runtime_error("wait() called when post() was required.");
 #endif
 
-    boost::system_time timeout = boost::get_system_time() + msec_t(10);
+    // A wait that tryWait() gave up on is resumed
+    if (wait_begin_ns_ == 0)
+        wait_begin_ns_ = statsNow();
+
+    if (Profiler *p = Profiler::current())
+        p->beginWait(false);
+
+    if (mode_ == SourceMode::LATEST) {
+        waitLatest();
+        return waitComplete(false);
+    }
+
+    // If the sink has left the room, we should too. Otherwise, block until
+    // the sink posts a write, the sink ENDs, or this process quits.
+    bool released = node_->sink_state() != NodeState::END
+                    && oat::interruptibleWait(node_->read_barrier(slot_index_));
+
+    return waitComplete(released);
+}
+
+template <typename T>
+inline bool SourceBase<T>::set_waker(const uint32_t id)
+{
+    if (state_ < SourceState::TOUCHED || mode_ == SourceMode::LATEST)
+        return false;
+
+    node_->set_waker(slot_index_, id);
+    return true;
+}
+
+template <typename T>
+inline bool SourceBase<T>::tryWait(const std::chrono::microseconds timeout,
+                                   NodeState &state)
+{
+#ifndef NDEBUG
+    // Don't use Asserts because it does not clean shmem
+    if(state_ < SourceState::TOUCHED)
+        throw std::runtime_error("Source must have touched node before calling tryWait()");
+    if (did_wait_need_post_)
+        throw std::runtime_error("tryWait() called when post() was required.");
+#endif
+
+    if (wait_begin_ns_ == 0)
+        wait_begin_ns_ = statsNow();
 
-    // Only wait if there is a SOURCE attached to the node
-    // Wait with timed wait with period check to prevent deadlocks
-    while (!node_->read_barrier(slot_index_).timed_wait(timeout) && !quit) {
+    Profiler *profiler = Profiler::current();
+    if (profiler)
+        profiler->beginWait(false);
+
+    if (mode_ == SourceMode::LATEST) {
+
+        if (!waitLatest(Clock::now() + timeout) && !quit
+            && node_->sink_state() != NodeState::END) {
+            if (profiler)
+                profiler->endWait();
+            return false;
+        }
+
+        state = waitComplete(false);
+        return true;
+    }
 
-        // Loops checking if wait has been released
-        timeout = boost::get_system_time() + msec_t(10);
+    const bool ended = node_->sink_state() == NodeState::END;
+    const bool released = !ended
+        && oat::interruptibleTimedWait(node_->read_barrier(slot_index_), timeout);
 
-        // If the sink has left the room, we should too
-        if (node_->sink_state() == NodeState::END)
-            break;
+    if (!released && !ended && !quit) {
+        if (profiler)
+            profiler->endWait();
+        return false;
     }
 
+    state = waitComplete(released);
+    return true;
+}
+
+template <typename T>
+inline NodeState SourceBase<T>::waitComplete(const bool released)
+{
+    // The SINK stops waiting on blocking sources that are too slow
+    if (mode_ == SourceMode::BLOCKING
+        && node_->acknowledgeEviction(slot_index_)) {
+        mode_ = SourceMode::NON_BLOCKING;
+        std::cerr << oat::whoWarn(address_, "this source did not read within "
+            "the sink's deadline and is now non-blocking. Samples will be "
+            "skipped.\n");
+    }
+
+    // Non-blocking sources, and all sources of a SINK that overwrites
+    // unread samples, always read the most recent write
+    if (released
+        && (mode_ == SourceMode::NON_BLOCKING
+            || node_->backpressure() == BackpressurePolicy::DROP_OLDEST)
+        && node_->sink_state() != NodeState::END)
+        node_->catchUp(slot_index_);
+
+    wait_end_ns_ = statsNow();
     did_wait_need_post_ = true;
 
+    if (Profiler *p = Profiler::current()) {
+        p->endWait();
+        p->beginCritical(false);
+    }
+
     return node_->sink_state();
 }
 
@@ -225,28 +398,172 @@ inline void SourceBase<T>::post()
         throw std::runtime_error("post() called when wait() was required.");
 #endif
 
-    if (node_->notifySourceReadComplete(slot_index_))
-        node_->write_barrier.post();
+    if (mode_ != SourceMode::LATEST) {
+
+        auto &stats = node_->source_stats[slot_index_];
+        stats.wait.add(wait_end_ns_ - wait_begin_ns_);
+        stats.hold.add(statsNow() - wait_end_ns_);
+        node_->heartbeat(slot_index_);
+
+        if (node_->notifySourceReadComplete(slot_index_))
+            node_->write_barrier.post();
+    }
+
+    wait_begin_ns_ = 0;
+
+    if (Profiler *p = Profiler::current())
+        p->endCritical(false);
 
     did_wait_need_post_ = false;
 }
 
+template <typename T>
+inline bool SourceBase<T>::pollSinkBound()
+{
+    while (node_->sink_state() != NodeState::SINK_BOUND) {
+        if (quit || node_->sink_state() == NodeState::END)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return true;
+}
+
+template <typename T>
+inline bool SourceBase<T>::waitLatest(const Clock::time_point deadline)
+{
+    // Tries of a copy that the SINK overwrote before backing off
+    static constexpr int SPINS {4};
+
+    // Nothing posts the read barrier of a source without a slot, so the
+    // thread's Waker is registered with the node for the SINK to post after
+    // each write. If none is available, the node is polled.
+    struct Observer {
+        Node *node;
+        int index {-1};
+        Observer(Node *n, const Waker &waker) : node(n)
+        {
+            if (waker.valid())
+                index = node->addObserver(waker.id());
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+        ~Observer()
+        {
+            if (index >= 0)
+                node->removeObserver(index);
+        }
+    };
+
+    Waker &waker = threadWaker();
+    Observer observer(node_, waker);
+
+    for (int tries = 0; !quit && node_->sink_state() != NodeState::END;
+         tries++) {
+
+        // Sequence lock: the copy is kept if the SINK did not start
+        // overwriting it while it was being made. Missed writes show up as
+        // jumps in the sample count.
+        const uint64_t n = node_->write_number();
+        if (n != latest_read_) {
+            copyLatest(n);
+            if (node_->snapshotValid(n)) {
+                latest_read_ = n;
+                return true;
+            }
+        }
+
+        // Wait for a new write, or for the write that keeps overwriting the
+        // copy to complete. A SINK that never completes its write, e.g.
+        // because it crashed, is retried at the rate of the timeout.
+        if (n == latest_read_ || tries >= SPINS) {
+
+            const auto now = Clock::now();
+            if (now >= deadline)
+                return false;
+
+            const auto left = std::min(
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    deadline - now),
+                std::chrono::microseconds(observer.index >= 0 ? 100000 : 1000));
+            if (observer.index >= 0)
+                waker.wait(left);
+            else
+                std::this_thread::sleep_for(left);
+        }
+    }
+
+    return false;
+}
+
 /* SPECIALIZATIONS */
 
 // 0. General Case
 
+class PositionList;
+
+/**
+ * @brief Whether a SourceMode::LATEST Source<T> may observe objects of type
+ * T. LATEST sources copy the shared object while the SINK may be writing to
+ * it and discard the copy if it was torn, so the copy must only read plain
+ * data and must not follow pointers or allocate.
+ */
+template <typename T>
+struct LatestCopyable : std::is_trivially_copyable<T> { };
+
+// Copies only the entries in use, but its storage is fixed size
+template <>
+struct LatestCopyable<PositionList> : std::true_type { };
+
 template <typename T>
 class Source : public SourceBase<T> {
 
+    using SourceBase<T>::obj_shmem_;
     using SourceBase<T>::sh_object_;
     using SourceBase<T>::connected_;
     using SourceBase<T>::state_;
+    using SourceBase<T>::mode_;
 
 public:
+    SourceState connect() override;
     T *retrieve() const;
     T clone() const;
+
+    /**
+     * @brief Metadata published by the sink using Sink<T>::set_metadata().
+     * @return Metadata, or nullptr if the sink did not publish metadata of
+     * type M.
+     */
+    template <typename M>
+    const M *metadata();
+
+private:
+    void copyLatest(const uint64_t n) override;
+
+    // LATEST sources' copy of the shared object
+    std::unique_ptr<T> latest_;
 };
 
+template <typename T>
+inline SourceState Source<T>::connect()
+{
+    if (mode_ == SourceMode::LATEST && !LatestCopyable<T>::value)
+        throw std::runtime_error("A LATEST source can only observe "
+                                 "trivially copyable types.");
+
+    auto rc = SourceBase<T>::connect();
+
+    if (rc == SourceState::CONNECTED && mode_ == SourceMode::LATEST)
+        latest_.reset(new T(*sh_object_));
+
+    return rc;
+}
+
+template <typename T>
+inline void Source<T>::copyLatest(const uint64_t)
+{
+    *latest_ = *sh_object_;
+}
+
 template <typename T>
 inline T *Source<T>::retrieve() const
 {
@@ -256,7 +573,7 @@ inline T *Source<T>::retrieve() const
         throw (std::runtime_error("Source must be connected before shared object is retrieved."));
 #endif
 
-    return sh_object_;
+    return latest_ ? latest_.get() : sh_object_;
 }
 
 template <typename T>
@@ -268,7 +585,17 @@ inline T Source<T>::clone() const
         throw (std::runtime_error("Source must be connected before shared object is cloned."));
 #endif
 
-    return *sh_object_;
+    return latest_ ? *latest_ : *sh_object_;
+}
+
+template <typename T>
+template <typename M>
+inline const M *Source<T>::metadata()
+{
+    if (state_ < SourceState::CONNECTED)
+        throw (std::runtime_error("Source must be connected before metadata is retrieved."));
+
+    return obj_shmem_.template find<M>(typeid(M).name());
 }
 
 // 1. SharedFrameHeader
@@ -279,12 +606,24 @@ public:
 
     using FrameParams = oat::FrameParams;
 
+    ~Source();
+
     // TODO: This info is sitting inside SharedFrameHeader. Why am I creating a
     // new class here? This should be part of SharedFrameHeader so I can just
     // copy it out of there.
     SourceState connect() override;
     SourceState connect(const oat::PixelColor col);
 
+    // Moves the shared frame to this source's next ring slot, or, for
+    // SourceMode::LATEST sources, copies the most recent frame
+    NodeState wait() override;
+    bool tryWait(const std::chrono::microseconds timeout,
+                 NodeState &state) override;
+
+    // Zero-copy read of the shared frame. See ReadLease.
+    class ReadLease;
+    ReadLease borrow();
+
     const oat::Frame * retrieve() const { return &frame_; }
     oat::Frame clone() const { return frame_.clone(); }
     void copyTo(oat::Frame &frame) const { frame_.copyTo(frame); };
@@ -292,11 +631,137 @@ public:
 
 private :
 
-    // Shared frame
+    void copyLatest(const uint64_t n) override;
+    void pointToReadSlot();
+
+    // Shared frame ring
+    uint8_t * data_ {nullptr};
+    oat::Sample * samples_ {nullptr};
+
+    // Frame ring held outside of the shared memory segment
+    oat::RingFile ring_file_;
+    std::string ring_path_;
+
+    // LATEST sources' copy of the most recent frame
+    cv::Mat latest_data_;
+    oat::Sample latest_sample_;
+
+    // Shared frame in this source's current ring slot
     oat::Frame frame_;
     FrameParams parameters_;
 };
 
+/**
+ * @brief RAII read of the shared frame in a Source<Frame>'s current ring slot.
+ * Obtained from Source<Frame>::borrow(), which performs the source's wait().
+ * The lease provides a read-only view of the frame in shared memory and posts
+ * the source's read barrier when released or destroyed. The sink cannot
+ * overwrite the leased ring slot until then, so leases should be short lived.
+ */
+class Source<Frame>::ReadLease {
+public:
+
+    ReadLease(ReadLease &&other)
+    : source_(other.source_)
+    , state_(other.state_)
+    , frame_(other.frame_)
+    {
+        other.source_ = nullptr;
+    }
+
+    ~ReadLease() { release(); }
+
+    ReadLease(const ReadLease &) = delete;
+    ReadLease &operator=(const ReadLease &) = delete;
+    ReadLease &operator=(ReadLease &&) = delete;
+
+    /**
+     * @brief Node state returned by the source's wait(). If END, there is no
+     * frame to read and nothing will be posted.
+     */
+    NodeState node_state() const { return state_; }
+
+    /**
+     * @brief Shared frame. Only valid until the lease is released. Do not
+     * write to the pixel data.
+     */
+    const oat::Frame &frame() const { return frame_; }
+
+    /**
+     * @brief Post the source's read barrier before the lease goes out of
+     * scope.
+     */
+    void release()
+    {
+        if (source_ != nullptr) {
+            source_->post();
+            source_ = nullptr;
+        }
+    }
+
+private:
+    friend class Source<Frame>;
+
+    ReadLease(Source<Frame> *source, const NodeState state)
+    : source_(state == NodeState::END ? nullptr : source)
+    , state_(state)
+    , frame_(source->frame_)
+    {
+        // Nothing
+    }
+
+    Source<Frame> *source_;
+    NodeState state_;
+    const oat::Frame &frame_;
+};
+
+inline Source<Frame>::ReadLease Source<Frame>::borrow()
+{
+    auto rc = wait();
+    return ReadLease(this, rc);
+}
+
+inline NodeState Source<Frame>::wait()
+{
+    auto rc = SourceBase<SharedFrameHeader>::wait();
+    pointToReadSlot();
+    return rc;
+}
+
+inline bool Source<Frame>::tryWait(const std::chrono::microseconds timeout,
+                                   NodeState &state)
+{
+    if (!SourceBase<SharedFrameHeader>::tryWait(timeout, state))
+        return false;
+
+    pointToReadSlot();
+    return true;
+}
+
+inline void Source<Frame>::pointToReadSlot()
+{
+    if (data_ == nullptr || mode_ == SourceMode::LATEST)
+        return;
+
+    const size_t i = node_->read_index(slot_index_);
+    frame_ = oat::Frame(parameters_.rows,
+                        parameters_.cols,
+                        parameters_.type,
+                        parameters_.color,
+                        data_ + i * parameters_.bytes,
+                        samples_ + i);
+}
+
+inline Source<Frame>::~Source()
+{
+    // If the sink and all other sources have left, we are the last user of
+    // the ring file
+    const size_t self = mode_ == SourceMode::LATEST ? 0 : 1;
+    if (!ring_path_.empty() && node_->source_ref_count() <= self
+        && node_->sink_state() != NodeState::SINK_BOUND)
+        ::unlink(ring_path_.c_str());
+}
+
 inline SourceState Source<Frame>::connect(const oat::PixelColor color)
 {
     auto rc = connect();
@@ -321,9 +786,14 @@ inline SourceState Source<Frame>::connect()
 
     // Wait for the SINK to bind the node and provide matrix
     // header info.
-    if (node_->sink_state() != NodeState::SINK_BOUND) {
+    if (mode_ == SourceMode::LATEST) {
 
-        if (wait() != NodeState::SINK_BOUND)
+        if (!pollSinkBound())
+            return SourceState::ERR_CONNECT;
+
+    } else if (node_->sink_state() != NodeState::SINK_BOUND) {
+
+        if (SourceBase<SharedFrameHeader>::wait() != NodeState::SINK_BOUND)
             return SourceState::ERR_CONNECT; // No throw because this can occur
                                              // at quit
 
@@ -332,14 +802,13 @@ inline SourceState Source<Frame>::connect()
         // wait() a 'freebie'
         node_->read_barrier(slot_index_).post();
         did_wait_need_post_ = false;
+        wait_begin_ns_ = 0;
     }
 
     // Find an existing shared object constructed by the SINK
-    obj_shmem_ =
-            bip::managed_shared_memory(bip::open_only, obj_address_.c_str());
-    std::pair<SharedFrameHeader *, size_t> temp =
+    obj_shmem_ = NodeSegment::open(obj_address_);
+    sh_object_ =
             obj_shmem_.find<SharedFrameHeader>(typeid(SharedFrameHeader).name());
-    sh_object_ = temp.first;
 
     // Only occurs when the name of the shared object does not match typeid(T).name()
     if (sh_object_ == nullptr) {
@@ -347,25 +816,64 @@ inline SourceState Source<Frame>::connect()
         throw std::runtime_error("Type mismatch: Source<T> can only connect to Node<T>.");
     }
 
-    // Generate frame header using info in shmem segment
-    auto p = sh_object_->params();
-    frame_ = oat::Frame(p.rows,
-                        p.cols,
-                        p.type,
-                        p.color,
-                        obj_shmem_.get_address_from_handle(sh_object_->data()),
-                        obj_shmem_.get_address_from_handle(sh_object_->sample()));
-
     // Save parameters to construct cv::Mats with
-    parameters_.cols = p.cols;
-    parameters_.rows = p.rows;
-    parameters_.type = p.type;
-    parameters_.color = p.color;
-    parameters_.bytes = frame_.total() * frame_.elemSize();
+    parameters_ = sh_object_->params();
+
+    // Locate the frame ring using info in shmem segment
+    ring_path_ = sh_object_->ring_path();
+    if (ring_path_.empty()) {
+        data_ = static_cast<uint8_t *>(
+            obj_shmem_.address(sh_object_->data()));
+    } else {
+        ring_file_.open(ring_path_);
+        data_ = static_cast<uint8_t *>(ring_file_.data());
+    }
+    samples_ = static_cast<oat::Sample *>(
+        obj_shmem_.address(sh_object_->sample()));
+
+    // Map the ring up front rather than on first read
+    if (sh_object_->ring_locked()) {
+
+        const size_t ring_bytes = node_->ring_depth() * parameters_.bytes;
+        prefaultRing(data_, ring_bytes, false);
+
+        if (!lockRing(data_, ring_bytes))
+            std::cerr << oat::whoWarn(address_, "frame ring could not be "
+                         "locked into RAM. Check RLIMIT_MEMLOCK.\n");
+    }
+
+    if (mode_ == SourceMode::LATEST) {
+
+        // Generate frame header for this source's private copy
+        latest_data_.create(parameters_.rows, parameters_.cols, parameters_.type);
+        frame_ = oat::Frame(parameters_.rows,
+                            parameters_.cols,
+                            parameters_.type,
+                            parameters_.color,
+                            latest_data_.data,
+                            &latest_sample_);
+    } else {
+
+        // Generate frame header for this source's next ring slot
+        const size_t i = node_->read_index(slot_index_);
+        frame_ = oat::Frame(parameters_.rows,
+                            parameters_.cols,
+                            parameters_.type,
+                            parameters_.color,
+                            data_ + i * parameters_.bytes,
+                            samples_ + i);
+    }
 
     state_ = SourceState::CONNECTED;
     return SourceState::CONNECTED;
 }
 
+inline void Source<Frame>::copyLatest(const uint64_t n)
+{
+    const size_t i = (n - 1) % node_->ring_depth();
+    std::memcpy(latest_data_.data, data_ + i * parameters_.bytes, parameters_.bytes);
+    latest_sample_ = samples_[i];
+}
+
 }      /* namespace oat */
 #endif /* OAT_SOURCE_H */
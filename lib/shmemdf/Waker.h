@@ -0,0 +1,248 @@
+//******************************************************************************
+//* File:   Waker.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_WAKER_H
+#define	OAT_WAKER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <boost/interprocess/sync/interprocess_semaphore.hpp>
+
+#include <cerrno>
+#include <signal.h>
+#include <unistd.h>
+
+#include "Interrupt.h"
+#include "NodeSegment.h"
+#include "../utility/IOFormat.h"
+
+namespace oat {
+
+// A thread that waits on several nodes at once (see waitAll()) cannot block
+// on all of their read barriers. Instead, it claims a Waker, a semaphore in a
+// table shared by all processes, and registers the Waker's id with each of
+// its SOURCE slots. A SINK posts the registered Waker, if any, each time it
+// posts a SOURCE's read barrier.
+
+namespace detail {
+
+// PIDs are only meaningful within the PID namespace of the caller, so
+// processes in a different namespace (e.g. another container that shares
+// /dev/shm) will appear dead
+inline bool processAlive(const int64_t pid)
+{
+    return pid <= 0 || ::kill(static_cast<pid_t>(pid), 0) == 0
+           || errno != ESRCH;
+}
+
+struct WakerTable {
+
+    static constexpr size_t MAX_WAKERS {64};
+
+    // Incremented whenever the layout of the table changes
+    static constexpr int VERSION {1};
+
+    // Name of the table in the "oat_wakers" segment, which identifies its
+    // layout so that a table left by an incompatible build is never used
+    static std::string name()
+    {
+        return "wakers_v" + std::to_string(VERSION) + "_"
+               + std::to_string(sizeof(WakerTable));
+    }
+
+    WakerTable()
+    {
+        for (auto &p : owner)
+            p.store(0, std::memory_order_relaxed);
+
+        // Semaphores are not default constructable, so they are constructed
+        // in place in raw storage
+        for (size_t i = 0; i < MAX_WAKERS; i++)
+            new (&semaphores[i]) semaphore(0);
+    }
+
+    ~WakerTable()
+    {
+        for (size_t i = 0; i < MAX_WAKERS; i++)
+            sem(i).~semaphore();
+    }
+
+    semaphore &sem(size_t i)
+    {
+        return *reinterpret_cast<semaphore *>(&semaphores[i]);
+    }
+
+    std::atomic<int64_t> owner[MAX_WAKERS]; //!< PID of each entry's owner
+    std::aligned_storage<sizeof(semaphore), alignof(semaphore)>::type
+        semaphores[MAX_WAKERS];
+};
+
+/**
+ * @brief This process's mapping of the table of Wakers. Mapped on first
+ * use.
+ * @return The table, or nullptr if it could not be mapped or the segment
+ * holds a table of an incompatible layout, in which case Wakers are
+ * unavailable and waits fall back to polling.
+ */
+inline WakerTable *wakerTable()
+{
+    static WakerTable *table = [] () -> WakerTable * {
+        try {
+            static NodeSegment segment
+                = NodeSegment::openOrCreate("oat_wakers", 65536);
+            const std::string name = WakerTable::name();
+
+            // Only construct the table in an empty segment. Another process
+            // might construct it between the find and the count, so look
+            // again before giving up.
+            WakerTable *t = segment.find<WakerTable>(name.c_str());
+            if (t == nullptr && segment.numNamed() == 0)
+                t = segment.findOrConstruct<WakerTable>(name.c_str());
+            if (t == nullptr)
+                t = segment.find<WakerTable>(name.c_str());
+
+            if (t == nullptr)
+                std::cerr << oat::Warn("The oat_wakers shared memory segment "
+                    "was left by an incompatible version of Oat. Waits will "
+                    "poll until it is removed using 'oat clean --wakers' "
+                    "while no components are running.\n");
+
+            return t;
+        } catch (const bip::interprocess_exception &) {
+            return nullptr;
+        }
+    }();
+
+    return table;
+}
+
+} // namespace detail
+
+/**
+ * @brief A semaphore, shared with every process, that SINKs post when they
+ * post a SOURCE slot that the Waker is registered with.
+ */
+class Waker {
+public:
+
+    static constexpr uint32_t NONE {0}; //!< id() of no Waker
+
+    /**
+     * @brief Claim a free entry of the table of Wakers, reclaiming entries of
+     * processes that have died if need be. If none is free, valid() is
+     * false.
+     */
+    Waker()
+    {
+        table_ = detail::wakerTable();
+        if (table_ == nullptr)
+            return;
+
+        const int64_t pid = getpid();
+        for (int pass = 0; pass < 2 && id_ == NONE; pass++) {
+            for (size_t i = 0; i < detail::WakerTable::MAX_WAKERS; i++) {
+                int64_t owner = table_->owner[i];
+                if ((pass == 0 && owner != 0)
+                    || (pass == 1 && detail::processAlive(owner)))
+                    continue;
+                if (table_->owner[i].compare_exchange_strong(owner, pid)) {
+                    id_ = static_cast<uint32_t>(i + 1);
+                    break;
+                }
+            }
+        }
+
+        drain();
+    }
+
+    ~Waker()
+    {
+        if (valid())
+            table_->owner[id_ - 1].store(0);
+    }
+
+    // Wakers are not copyable
+    Waker(const Waker &) = delete;
+    Waker &operator=(const Waker &) = delete;
+
+    bool valid() const { return id_ != NONE; }
+    uint32_t id() const { return id_; }
+
+    /**
+     * @brief Discard posts made before now.
+     */
+    void drain()
+    {
+        if (valid())
+            while (sem().try_wait()) { }
+    }
+
+    /**
+     * @brief Block until posted, until a timeout expires or until
+     * interruptWaits() is called.
+     * @param timeout Maximum time to block. Defaults to no limit.
+     * @return True if the Waker was posted.
+     */
+    bool wait(const std::chrono::microseconds timeout
+              = std::chrono::microseconds::max())
+    {
+        return timeout == std::chrono::microseconds::max()
+                   ? interruptibleWait(sem())
+                   : interruptibleTimedWait(sem(), timeout);
+    }
+
+    /**
+     * @brief Post a Waker by id. Does nothing for NONE.
+     */
+    static void post(const uint32_t id)
+    {
+        if (id == NONE || id > detail::WakerTable::MAX_WAKERS)
+            return;
+
+        auto table = detail::wakerTable();
+        if (table != nullptr)
+            table->sem(id - 1).post();
+    }
+
+private:
+
+    detail::semaphore &sem() { return table_->sem(id_ - 1); }
+
+    detail::WakerTable *table_ {nullptr};
+    uint32_t id_ {NONE};
+};
+
+/**
+ * @brief The calling thread's Waker, claimed on first use and released when
+ * the thread exits.
+ */
+inline Waker &threadWaker()
+{
+    static thread_local Waker waker;
+    return waker;
+}
+
+}       /* namespace oat */
+#endif	/* OAT_WAKER_H */
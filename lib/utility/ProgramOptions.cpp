@@ -46,5 +46,81 @@ ComponentInfo * ComponentInfo::instance() {
     return inst;
 }
 
+po::options_description schedulingOptions() {
+
+    po::options_description desc;
+    desc.add_options()
+        ("cpu", po::value<std::string>(),
+         "Array of CPUs that the processing thread may run on, e.g. '[2,3]'. "
+         "Defaults to any CPU.")
+        ("rt-priority", po::value<int>(),
+         "SCHED_FIFO real-time priority of the processing thread, between 1 "
+         "and 99. Requires CAP_SYS_NICE or a sufficient RLIMIT_RTPRIO. "
+         "Defaults to 0, which uses normal scheduling.")
+        ("helper-cpu", po::value<std::string>(),
+         "Array of CPUs that helper threads (control, display and file "
+         "writing) may run on. Defaults to any CPU.")
+        ("helper-rt-priority", po::value<int>(),
+         "SCHED_FIFO real-time priority of helper threads, between 1 and 99. "
+         "Defaults to 0, which uses normal scheduling.")
+        ("mlock",
+         "If specified, lock all of the process's memory into RAM so that it "
+         "is never paged out. Check RLIMIT_MEMLOCK.")
+        ;
+
+    return desc;
+}
+
+po::options_description syncOptions() {
+
+    po::options_description desc;
+    desc.add_options()
+        ("sync", po::value<std::string>(),
+         "How samples from different SOURCES are matched. Values:\n"
+         "  none: assume the i-th read from each SOURCE is the same sample.\n"
+         "  count: match samples with the same sample count.\n"
+         "  usec: match samples with the same sample time.\n"
+         "Unmatched samples are discarded. Defaults to none.")
+        ("sync-tolerance", po::value<int64_t>(),
+         "Maximum difference between matched samples, in counts or "
+         "microseconds depending on --sync. Defaults to 0. Use about half a "
+         "sample period to match usec across independent devices.")
+        ("sync-window", po::value<int>(),
+         "Number of samples from each SOURCE held while waiting for a match. "
+         "Defaults to 8.")
+        ;
+
+    return desc;
+}
+
+po::options_description stripeOptions() {
+
+    po::options_description desc;
+    desc.add_options()
+        ("stripes", po::value<int>(),
+         "Number of horizontal stripes that each frame is split into so that "
+         "it can be processed by several cores at once. Reduces the latency "
+         "of large frames. Defaults to 1. A good value is the number of "
+         "cores available to the component.")
+        ;
+
+    return desc;
+}
+
+po::options_description profileOptions() {
+
+    po::options_description desc;
+    desc.add_options()
+        ("profile", po::value<std::string>()->implicit_value(""),
+         "If specified, time each iteration of the processing loop, split "
+         "into SOURCE wait, SOURCE critical section, compute, SINK wait and "
+         "SINK critical section. Latency histograms are written as JSON to "
+         "the given file on exit, or to standard output if no file is given. "
+         "Controllable components also print them on the 'stats' command.")
+        ;
+
+    return desc;
+}
+
 } /* namespace config */
 } /* namespace oat */
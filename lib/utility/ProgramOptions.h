@@ -56,6 +56,34 @@ private:
     std::unique_ptr<po::options_description> desc;
 };
 
+/**
+ * @brief Program options controlling CPU affinity, real-time priority and
+ * memory locking, which are common to all components.
+ * @return Scheduling program options.
+ */
+po::options_description schedulingOptions();
+
+/**
+ * @brief Program options controlling how components with several SOURCEs
+ * align the samples they read. See oat::SampleSynchronizer.
+ * @return Synchronization program options.
+ */
+po::options_description syncOptions();
+
+/**
+ * @brief Program options controlling how many stripes a frame is split into
+ * for parallel processing. See oat::forEachStripe().
+ * @return Stripe program options.
+ */
+po::options_description stripeOptions();
+
+/**
+ * @brief Program options controlling the processing loop profiler, which are
+ * common to all components. See oat::Profiler.
+ * @return Profiling program options.
+ */
+po::options_description profileOptions();
+
 }      /* namespace config */
 }      /* namespace oat */
 #endif /* OAT_PROGRAM_OPTIONS */
@@ -0,0 +1,126 @@
+//******************************************************************************
+//* File:   Stripes.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_STRIPES_H
+#define OAT_STRIPES_H
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+namespace oat {
+
+// To reduce the latency of a single frame, per-pixel kernels can split the
+// frame into horizontal stripes that are processed in parallel. Stripes run
+// on OpenCV's thread pool, which is created once per process and shared by all
+// striped kernels and by the OpenCV functions that parallelize internally.
+// OpenCV runs parallel loops that are nested inside a stripe on the calling
+// thread, so they do not oversubscribe the pool.
+
+namespace detail {
+
+template <typename F>
+class StripeBody : public cv::ParallelLoopBody {
+public:
+
+    StripeBody(const int rows, const int stripes, const F &f)
+    : rows_(rows)
+    , stripes_(stripes)
+    , f_(f)
+    {
+        // Nothing
+    }
+
+    void operator()(const cv::Range &range) const override
+    {
+        for (int s = range.start; s < range.end; s++)
+            f_(cv::Range(rows_ * s / stripes_, rows_ * (s + 1) / stripes_));
+    }
+
+private:
+    const int rows_;
+    const int stripes_;
+    const F &f_;
+};
+
+}  // namespace detail
+
+/**
+ * @brief Process a frame in horizontal stripes in parallel.
+ * @param rows Number of frame rows.
+ * @param stripes Number of stripes. If 1, the whole frame is processed on the
+ * calling thread.
+ * @param f Function called with the range of rows in each stripe. Stripes are
+ * processed concurrently, so f must only write to the rows it is given.
+ */
+template <typename F>
+void forEachStripe(const int rows, const int stripes, const F &f)
+{
+    const int n = std::max(1, std::min(stripes, rows));
+    if (n == 1) {
+        f(cv::Range(0, rows));
+        return;
+    }
+
+    cv::parallel_for_(cv::Range(0, n), detail::StripeBody<F>(rows, n, f), n);
+}
+
+/**
+ * @brief Erode or dilate a frame in horizontal stripes. Each output stripe
+ * depends on a halo of input rows, up to the kernel's height, above and below
+ * it. The halo is copied along with each stripe into a private matrix rather
+ * than relying on OpenCV to read past the edges of a region of its parent,
+ * so the result is identical to that of processing the whole frame at once.
+ * @param op cv::MORPH_ERODE or cv::MORPH_DILATE.
+ * @param src Input frame.
+ * @param dst Output frame. Must not share data with src, since each stripe
+ * reads rows that its neighbours write.
+ * @param kernel Structuring element, anchored at its center.
+ * @param stripes Number of stripes.
+ */
+inline void stripedMorphology(const int op,
+                              const cv::Mat &src,
+                              cv::Mat &dst,
+                              const cv::Mat &kernel,
+                              const int stripes)
+{
+    dst.create(src.size(), src.type());
+    if (src.data == dst.data)
+        throw std::runtime_error("Striped morphology cannot be done in place.");
+
+    const int halo = kernel.rows;
+
+    forEachStripe(src.rows, stripes, [&](const cv::Range &r) {
+
+        // Rows beyond the frame's edges are filled in by OpenCV's default
+        // border, just as they are for the whole frame
+        const int begin = std::max(0, r.start - halo);
+        const int end = std::min(src.rows, r.end + halo);
+
+        cv::Mat in, out;
+        src.rowRange(begin, end).copyTo(in);
+        cv::morphologyEx(in, out, op, kernel);
+        out.rowRange(r.start - begin, r.end - begin).copyTo(dst.rowRange(r));
+    });
+}
+
+}      /* namespace oat */
+#endif /* OAT_STRIPES_H */
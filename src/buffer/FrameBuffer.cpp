@@ -98,12 +98,14 @@ void FrameBuffer::pop()
             // START CRITICAL SECTION //
             ////////////////////////////
 
-            // Wait for sources to read
-            sink_.wait();
+            // Wait for sources to read. Stop publishing if the wait was
+            // interrupted.
+            if (!sink_.wait())
+                break;
 
             // TODO: use specialized spsc allocator for popping somehow?
             buffer_.consume_one(
-                [this](oat::Frame frame){ frame.copyTo(shared_frame_); }
+                [this](oat::Frame frame){ frame.copyTo(*shared_frame_); }
             );
 
             // Tell sources there is new data
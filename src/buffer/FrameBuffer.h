@@ -60,7 +60,7 @@ private:
     SPSCBuffer buffer_;
 
     // Sink
-    oat::Frame shared_frame_;
+    oat::Frame * shared_frame_ {nullptr};
     oat::Sink<oat::Frame> sink_;
 };
 
@@ -98,8 +98,10 @@ void TokenBuffer<T>::pop()
             // START CRITICAL SECTION //
             ////////////////////////////
 
-            // Wait for sources to read
-            sink_.wait();
+            // Wait for sources to read. Stop publishing if the wait was
+            // interrupted.
+            if (!sink_.wait())
+                break;
 
             buffer_.pop(*shared_token_);
 
@@ -22,6 +22,7 @@
 #include <iostream>
 #include <unordered_map>
 #include <csignal>
+#include <unistd.h>
 #include <boost/program_options.hpp>
 #include <boost/interprocess/managed_shared_memory.hpp>
 
@@ -40,6 +41,8 @@ void printUsage(po::options_description options) {
 int main(int argc, char *argv[]) {
 
     std::vector<std::string> names;
+    std::string huge_page_dir;
+    bool wakers = false;
     bool quiet = false;
     bool legacy = false;
 
@@ -55,6 +58,14 @@ int main(int argc, char *argv[]) {
         options.add_options()
             ("quiet,q", "Quiet mode. Prevent output text.")
             ("legacy,l", "Legacy mode. Append  \"_sh_mem\" to input NAMES before removing.")
+            ("huge-page-dir", po::value<std::string>(),
+             "Directory that frame servers were told to place their frame "
+             "rings in using their huge-page-dir option. Frame ring files of "
+             "NAMES are removed from it as well.")
+            ("wakers",
+             "Also remove the table that components use to wake each other, "
+             "e.g. after upgrading Oat. Only use when no components are "
+             "running. NAMES are optional.")
             ;
 
         po::options_description hidden("HIDDEN OPTIONS");
@@ -97,7 +108,10 @@ int main(int argc, char *argv[]) {
             return 0;
         }
 
-        if (!variable_map.count("names")) {
+        if (variable_map.count("wakers"))
+            wakers = true;
+
+        if (!variable_map.count("names") && !wakers) {
             printUsage(visible_options);
             std::cout << "Error: at least a single NAME must be specified. Exiting.\n";
             return -1;
@@ -109,7 +123,11 @@ int main(int argc, char *argv[]) {
         if (variable_map.count("legacy"))
             legacy = true;
 
-        names = variable_map["names"].as< std::vector<std::string> >();
+        if (variable_map.count("huge-page-dir"))
+            huge_page_dir = variable_map["huge-page-dir"].as<std::string>();
+
+        if (variable_map.count("names"))
+            names = variable_map["names"].as< std::vector<std::string> >();
 
     } catch (std::exception& e) {
         std::cerr << oat::Error(e.what()) << "\n";
@@ -147,6 +165,11 @@ int main(int argc, char *argv[]) {
                 success = true;
             }
 
+            if (!huge_page_dir.empty()
+                && ::unlink((huge_page_dir + "/" + name + "_ring").c_str()) == 0) {
+                success = true;
+            }
+
             if (success && !quiet)
                 std::cout << "success.\n";
             if (!success && !quiet)
@@ -154,6 +177,17 @@ int main(int argc, char *argv[]) {
         }
     }
 
+    if (wakers) {
+
+        if (!quiet)
+           std::cout << "Trying to removing \'oat_wakers\' from shared memory...";
+
+        if (bip::shared_memory_object::remove("oat_wakers") && !quiet)
+            std::cout << "success.\n";
+        else if (!quiet)
+            std::cout << "not found.\n";
+    }
+
     // Exit
     return 0;
 }
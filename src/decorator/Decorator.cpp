@@ -60,6 +60,8 @@ po::options_description Decorator::options() const
         ("invert-font,i", "Invert font color.\n")
         ;
 
+    local_opts.add(oat::config::syncOptions());
+
     return local_opts;
 }
 
@@ -77,8 +79,7 @@ void Decorator::applyConfiguration(const po::variables_map &vm,
         if (!p_source_addrs.empty()) {
             for (auto &addr : p_source_addrs) {
 
-                oat::Position2D pos(addr);
-                positions_.push_back(std::move(pos));
+                positions_.push_back(oat::Position2D());
                 position_sources_.push_back(
                     oat::NamedSource<oat::Position2D>(
                         addr,
@@ -110,6 +111,9 @@ void Decorator::applyConfiguration(const po::variables_map &vm,
     bool invert_font;
     if (oat::config::getValue<bool>(vm, config_table, "invert-font", invert_font))
         font_color_ = cv::Scalar(0,0,0);
+
+    // Alignment of frames and positions
+    sync_config_ = getSyncConfig(vm, config_table);
 }
 
 bool Decorator::connectToNode()
@@ -131,6 +135,11 @@ bool Decorator::connectToNode()
     for (auto &ps : position_sources_) {
         ps.source->connect();
         all_ts.push_back(ps.source->retrieve()->sample_period_sec());
+
+        // Maps positions in world units back to pixels
+        auto meta = ps.source->metadata<oat::PositionMetadata>();
+        inverse_homographies_.push_back(
+            meta ? meta->homography.inv() : cv::Matx33d::eye());
     }
 
     // Get frame meta data to format sink
@@ -140,12 +149,25 @@ bool Decorator::connectToNode()
     // Bind to sink sink node and create a shared frame
     frame_sink_.bind(frame_sink_address_, param.bytes);
     shared_frame_ = frame_sink_.retrieve(param.rows, param.cols, param.type, param.color);
-    all_ts.push_back(shared_frame_.sample_period_sec());
+    all_ts.push_back(shared_frame_->sample_period_sec());
 
     if (!oat::checkSamplePeriods(all_ts, sample_rate_hz)) {
         std::cerr << oat::Warn(oat::inconsistentSampleRateWarning(sample_rate_hz));
     }
 
+    // Frame source first, then position sources
+    sync_sources_.push_back(&frame_source_);
+    for (auto &ps : position_sources_)
+        sync_sources_.push_back(ps.source.get());
+
+    if (sync_config_.key != oat::SyncKey::NONE && !position_sources_.empty()) {
+        sync_ = oat::make_unique<oat::SampleSynchronizer>(
+            sync_sources_.size(), sync_config_);
+        held_frames_.resize(sync_->window());
+        for (const auto &p : positions_)
+            held_positions_.emplace_back(sync_->window(), p);
+    }
+
     // Set drawing parameters based on frame dimensions
     const size_t min_size = (param.rows < param.cols) ? param.rows : param.cols;
     position_circle_radius_ = std::ceil(symbol_scale_ * min_size);
@@ -157,7 +179,7 @@ bool Decorator::connectToNode()
     if (decorate_position_) {
         previous_positions_.push_back(oat::Point2D(0,0));
         positions_found_.push_back(false);
-        history_frame_ = cv::Mat::zeros(shared_frame_.size(), shared_frame_.type());
+        history_frame_ = cv::Mat::zeros(shared_frame_->size(), shared_frame_->type());
     }
 
     return true;
@@ -165,36 +187,51 @@ bool Decorator::connectToNode()
 
 int Decorator::process()
 {
-    // 1. Get frame
-    // START CRITICAL SECTION //
-    ////////////////////////////
-
-    // Wait for sink to write to node
-    if (frame_source_.wait() == oat::NodeState::END)
-        return 1;
+    if (sync_) {
+
+        // Read sources until there is a frame with matching positions
+        while (!sync_->pop(aligned_)) {
+
+            auto state = oat::waitAll(sync_sources_, [this](pvec_size_t i) {
+                if (i == 0) {
+                    const size_t slot = sync_->push(
+                        0, frame_source_.retrieve()->sample());
+                    if (slot != oat::SampleSynchronizer::NO_SLOT)
+                        frame_source_.copyTo(held_frames_[slot]);
+                } else {
+                    auto pos = position_sources_[i - 1].source->clone();
+                    const size_t slot = sync_->push(i, pos.sample());
+                    if (slot != oat::SampleSynchronizer::NO_SLOT)
+                        held_positions_[i - 1][slot] = std::move(pos);
+                }
+            });
+
+            if (state == oat::NodeState::END)
+                return 1;
+            else if (quit)
+                return 0;
+        }
 
-    // Clone the shared frame
-    frame_source_.copyTo(internal_frame_);
+        held_frames_[aligned_[0]].copyTo(internal_frame_);
+        for (pvec_size_t i = 0; i < positions_.size(); i++)
+            positions_[i] = held_positions_[i][aligned_[i + 1]];
 
-    // Tell sink it can continue
-    frame_source_.post();
+        if (sync_->warningDue())
+            std::cerr << oat::Warn(oat::misalignedSourcesWarning(*sync_));
 
-    ////////////////////////////
-    //  END CRITICAL SECTION  //
+    } else {
 
-    // 2. Get positions
-    for (pvec_size_t i = 0; i !=  position_sources_.size(); i++) {
+        // Get frame and positions. Each source is posted as soon as its
+        // sample has been copied.
+        auto state = oat::waitAll(sync_sources_, [this](pvec_size_t i) {
+            if (i == 0)
+                frame_source_.copyTo(internal_frame_);
+            else
+                positions_[i - 1] = position_sources_[i - 1].source->clone();
+        });
 
-        // START CRITICAL SECTION //
-        ////////////////////////////
-        if (position_sources_[i].source->wait() == oat::NodeState::END)
+        if (state == oat::NodeState::END)
             return 1;
-
-        positions_[i] = position_sources_[i].source->clone();
-
-        position_sources_[i].source->post();
-        ////////////////////////////
-        //  END CRITICAL SECTION  //
     }
 
     // Decorate frame
@@ -203,13 +240,15 @@ int Decorator::process()
     // START CRITICAL SECTION //
     ////////////////////////////
 
-    // Wait for sources to read
-    frame_sink_.wait();
+    // Wait for sources to read. Nothing is written if the wait was
+    // interrupted.
+    if (frame_sink_.wait()) {
 
-    internal_frame_.copyTo(shared_frame_);
+        internal_frame_.copyTo(*shared_frame_);
 
-    // Tell sources there is new data
-    frame_sink_.post();
+        // Tell sources there is new data
+        frame_sink_.post();
+    }
 
     ////////////////////////////
     //  END CRITICAL SECTION  //
@@ -255,12 +294,11 @@ void Decorator::drawOnFrame()
         encodeSampleNumber();
 }
 
-void Decorator::invertHomography(oat::Position2D &p)
+void Decorator::invertHomography(oat::Position2D &p,
+                                 const cv::Matx33d &inv_homo)
 {
     if (p.position_valid) {
 
-        cv::Matx33d inv_homo = p.homography().inv();
-
         std::vector<oat::Point2D> in_positions;
         std::vector<oat::Point2D> out_positions;
         in_positions.push_back(p.position);
@@ -304,7 +342,7 @@ void Decorator::drawPosition()
     for (auto &p : positions_) {
 
         if (p.unit_of_length() == oat::DistanceUnit::WORLD)
-            invertHomography(p);
+            invertHomography(p, inverse_homographies_[i]);
 
         if (p.position_valid) {
 
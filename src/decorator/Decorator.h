@@ -20,6 +20,7 @@
 #ifndef OAT_DECORATOR_H
 #define OAT_DECORATOR_H
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -85,13 +86,24 @@ private:
     oat::Source<oat::Frame> frame_source_;
 
     // Mat server for sending decorated frames
-    oat::Frame shared_frame_;
+    oat::Frame * shared_frame_ {nullptr};
     std::string frame_sink_address_;
     oat::Sink<oat::Frame> frame_sink_;
 
     // Positions to be added to the image stream
     std::vector<oat::Position2D> positions_;
     oat::NamedSourceList<oat::Position2D> position_sources_;
+    std::vector<cv::Matx33d> inverse_homographies_; //!< From node metadata
+    std::vector<oat::SourceSync *> sync_sources_; //!< Sources for waitAll()
+
+    // Sample alignment of the frame (source 0) and positions. Samples that
+    // have yet to be matched are held in held_frames_[slot] and
+    // held_positions_[position][slot]. Unused if the sync key is NONE.
+    oat::SyncConfig sync_config_;
+    std::unique_ptr<oat::SampleSynchronizer> sync_;
+    std::vector<oat::Frame> held_frames_;
+    std::vector<std::vector<oat::Position2D>> held_positions_;
+    std::vector<size_t> aligned_;
 
     // Options
     bool decorate_position_ {true};
@@ -138,8 +150,10 @@ private:
      * Project Positions into oat::PIXEL coordinates.
      * @param pos Position with unit_of_length != oat::PIXEL to be converted to
      * unit_of_length == oat::PIXEL.
+     * @param inv_homo Inverse of the homography in the position node's
+     * metadata.
      */
-    void invertHomography(oat::Position2D &pos);
+    void invertHomography(oat::Position2D &pos, const cv::Matx33d &inv_homo);
 
     // Frame mutating subroutines
     void drawPosition(void);
@@ -28,6 +28,7 @@
 
 #include "../../lib/utility/IOFormat.h"
 #include "../../lib/utility/ProgramOptions.h"
+#include "../../lib/utility/Stripes.h"
 #include "../../lib/utility/TOMLSanitize.h"
 
 namespace oat {
@@ -43,7 +44,7 @@ BackgroundSubtractor::BackgroundSubtractor(
 po::options_description BackgroundSubtractor::options() const
 {
     // Update CLI options
-    po::options_description local_opts;
+    po::options_description local_opts(baseOptions());
     local_opts.add_options()
         ("adaptation-coeff,a", po::value<double>(),
          "Scalar value, 0 to 1.0, specifying how quickly the new frames are "
@@ -53,6 +54,7 @@ po::options_description BackgroundSubtractor::options() const
          "Path to background image used for subtraction. If not provided, the "
          "first frame is used as the background image.")
         ;
+    local_opts.add(oat::config::stripeOptions());
 
     return local_opts;
 }
@@ -60,6 +62,8 @@ po::options_description BackgroundSubtractor::options() const
 void BackgroundSubtractor::applyConfiguration(const po::variables_map &vm,
                                               const config::OptionTable &config_table)
 {
+    applyBaseConfiguration(vm, config_table);
+
     // Background image path
     std::string img_path;
     if (oat::config::getValue(vm, config_table, "background", img_path)) {
@@ -70,11 +74,16 @@ void BackgroundSubtractor::applyConfiguration(const po::variables_map &vm,
         if (background_frame_.data == nullptr)
             throw (std::runtime_error("File \"" + img_path + "\" could not be read."));
 
+        background_frame_.convertTo(background_frame_f_, CV_32F);
         background_set_ = true;
     }
 
     // Adaptation coefficient
     oat::config::getNumericValue<double>(vm, config_table, "adaptation-coeff", alpha_, 0.0, 1.0);
+
+    // Stripes
+    oat::config::getNumericValue<int>(
+        vm, config_table, "stripes", stripes_, 1, 256);
 }
 
 void BackgroundSubtractor::setBackgroundImage(const cv::Mat &frame)
@@ -91,12 +100,19 @@ void BackgroundSubtractor::filter(cv::Mat &frame)
     if (!background_set_)
         setBackgroundImage(frame);
 
-    if (alpha_ > 0.0) {
-       cv::accumulateWeighted(frame, background_frame_f_, alpha_);
-       background_frame_f_.convertTo(background_frame_, CV_8U);
-    }
+    oat::forEachStripe(frame.rows, stripes_, [&](const cv::Range &r) {
+
+        cv::Mat in = frame.rowRange(r);
+        cv::Mat background = background_frame_.rowRange(r);
+
+        if (alpha_ > 0.0) {
+            cv::Mat background_f = background_frame_f_.rowRange(r);
+            cv::accumulateWeighted(in, background_f, alpha_);
+            background_f.convertTo(background, CV_8U);
+        }
 
-    frame = frame - background_frame_;
+        cv::subtract(in, background, in);
+    });
 }
 
 } /* namespace oat */
@@ -51,7 +51,7 @@ BackgroundSubtractorMOG::BackgroundSubtractorMOG(
 po::options_description BackgroundSubtractorMOG::options() const
 {
     // Update CLI options
-    po::options_description local_opts;
+    po::options_description local_opts(baseOptions());
     local_opts.add_options()
         ("adaptation-coeff,a", po::value<double>(),
          "Value, 0 to 1.0, specifying how quickly the statistical model "
@@ -69,6 +69,8 @@ po::options_description BackgroundSubtractorMOG::options() const
 void BackgroundSubtractorMOG::applyConfiguration(const po::variables_map &vm,
                                               const config::OptionTable &config_table)
 {
+    applyBaseConfiguration(vm, config_table);
+
 #ifdef HAVE_CUDA
     // GPU index
     size_t index = 0;
@@ -38,14 +38,16 @@ ColorConvert::ColorConvert(const std::string &frame_source_address,
 
 po::options_description ColorConvert::options() const
 {
-    po::options_description local_opts;
+    po::options_description local_opts(baseOptions());
     local_opts.add_options()
         ("color,C", po::value<std::string>(),
          "Pixel color format."
          "Values:\n"
          "  GREY: \t 8-bit Greyscale image.\n"
          "  BRG: \t8-bit, 3-chanel, BGR Color image.\n"
-         "  HSV: \t8-bit, 3-chanel, HSV Color image.\n")
+         "  HSV: \t8-bit, 3-chanel, HSV Color image.\n"
+         "Bayer sources can be converted to GREY or BGR, and 12 and 16-bit "
+         "greyscale sources to GREY.")
         ;
 
     return local_opts;
@@ -54,6 +56,8 @@ po::options_description ColorConvert::options() const
 void ColorConvert::applyConfiguration(const po::variables_map &vm,
                                       const config::OptionTable &config_table)
 {
+    applyBaseConfiguration(vm, config_table);
+
     // Pixel color to convert to
     std::string col;
     if (oat::config::getValue<std::string>(
@@ -74,11 +78,15 @@ bool ColorConvert::connectToNode()
     // Get frame meta data to format sink
     auto frame_parameters = frame_source_.parameters();
 
-    // Get the color conversion code
-    conversion_code_ = oat::color_conv_code(frame_parameters.color, color_);
+    from_ = frame_parameters.color;
+    if (require_bayer_ && !oat::is_bayer(from_)) {
+        throw std::runtime_error("Debayering requires a frame source with "
+                                 "Bayer pixels, not "
+                                 + color_str(from_) + ".");
+    }
 
     // If there is no conversion being done, throw
-    if (conversion_code_ == -1) {
+    if (oat::color_conv_code(from_, color_) == -1) {
         throw std::runtime_error("Nothing to be done for " + color_str(frame_parameters.color)
                                  + " to "
                                  + color_str(color_)
@@ -98,12 +106,74 @@ bool ColorConvert::connectToNode()
     return true;
 }
 
+int ColorConvert::process()
+{
+    if (num_workers_ > 1)
+        return FrameFilter::process();
+
+    // START CRITICAL SECTION //
+    ////////////////////////////
+
+    oat::Sample sample;
+    {
+        // Wait for sink to write to node
+        auto lease = frame_source_.borrow();
+        if (lease.node_state() == oat::NodeState::END)
+            return 1;
+
+        sample = lease.frame().sample();
+
+        if (!frame_sink_.wouldBlock()) {
+
+            // Convert the source frame straight into shared memory. The
+            // shared frame already has the converted size and type, so
+            // nothing is allocated.
+            oat::Frame * frame = frame_sink_.acquire();
+            oat::convert_color(lease.frame(), *frame, from_, color_);
+
+        } else {
+
+            // Downstream sources have yet to read, so convert aside and let
+            // the upstream sink continue while they do
+            auto out = frame_pool_.acquire(lease.frame().rows,
+                                           lease.frame().cols,
+                                           oat::cv_type(color_), color_);
+            oat::convert_color(lease.frame(), out.frame(), from_, color_);
+            lease.release();
+
+            // Wait for sources to read
+            oat::Frame * frame = frame_sink_.acquire();
+            static_cast<const cv::Mat &>(out.frame()).copyTo(*frame);
+        }
+
+        // Lease tells sink it can continue
+    }
+
+    // Tell sources there is new data
+    frame_sink_.commit(sample);
+
+    ////////////////////////////
+    //  END CRITICAL SECTION  //
+
+    // Sink was not at END state
+    return 0;
+}
+
 void ColorConvert::filter(cv::Mat &frame)
 {
-    cv::Mat out; // Might change underlying element type
-    cv::cvtColor(frame, out, conversion_code_);
-    frame = out;
-    static_cast<oat::Frame &>(frame).set_color(color_);
+    // Conversion might change the underlying element type, so process()
+    // converts into the shared frame rather than calling this
+    auto out = frame_pool_.acquire(frame.rows, frame.cols,
+                                   oat::cv_type(color_), color_);
+    oat::convert_color(frame, out.frame(), from_, color_);
+    out.frame().copyTo(static_cast<oat::Frame &>(frame));
+}
+
+cv::Mat &ColorConvert::filterInto(oat::Frame &in, cv::Mat &out)
+{
+    // The output already has the converted size and type
+    oat::convert_color(in, out, from_, color_);
+    return out;
 }
 
 } /* namespace oat */
@@ -39,16 +39,27 @@ public:
     ColorConvert(const std::string &frame_souce_address,
                  const std::string &frame_sink_address);
 
-private:
-    bool connectToNode(void) override;
+protected:
     po::options_description options() const override;
     void applyConfiguration(const po::variables_map &vm,
                             const config::OptionTable &config_table) override;
 
+    // Color to convert to
+    oat::PixelColor color_ {oat::PIX_BGR};
+
+    // Refuse sources whose pixels are not raw Bayer mosaics
+    bool require_bayer_ {false};
+
+private:
+    bool connectToNode(void) override;
+    int process(void) override;
+
     void filter(cv::Mat &frame) override;
+    cv::Mat &filterInto(oat::Frame &in, cv::Mat &out) override;
+    bool parallelizable(void) const override { return true; }
 
-    int conversion_code_;
-    oat::PixelColor color_;
+    // Color of the source frames
+    oat::PixelColor from_ {oat::PIX_BGR};
 };
 
 }      /* namespace oat */
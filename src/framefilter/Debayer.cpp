@@ -0,0 +1,65 @@
+//******************************************************************************
+//* File:   Debayer.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#include "Debayer.h"
+
+#include <string>
+
+#include "../../lib/utility/TOMLSanitize.h"
+
+namespace oat {
+
+Debayer::Debayer(const std::string &frame_source_address,
+                 const std::string &frame_sink_address)
+: ColorConvert(frame_source_address, frame_sink_address)
+{
+    require_bayer_ = true;
+}
+
+po::options_description Debayer::options() const
+{
+    po::options_description local_opts(baseOptions());
+    local_opts.add_options()
+        ("color,C", po::value<std::string>(),
+         "Pixel color format. The Bayer pattern is that of the source. "
+         "Defaults to BGR.\n"
+         "Values:\n"
+         "  GREY: \t 8-bit Greyscale image.\n"
+         "  BGR: \t8-bit, 3-chanel, BGR Color image.\n")
+        ;
+
+    return local_opts;
+}
+
+void Debayer::applyConfiguration(const po::variables_map &vm,
+                                 const config::OptionTable &config_table)
+{
+    applyBaseConfiguration(vm, config_table);
+
+    // Pixel color to demosaic to
+    std::string col;
+    if (oat::config::getValue<std::string>(vm, config_table, "color", col)) {
+        color_ = oat::str_color(col);
+        if (color_ != PIX_GREY && color_ != PIX_BGR)
+            throw std::runtime_error("Bayer frames can only be demosaiced to "
+                                     "GREY or BGR.");
+    }
+}
+
+} /* namespace oat */
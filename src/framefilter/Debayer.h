@@ -0,0 +1,51 @@
+//******************************************************************************
+//* File:   Debayer.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_DEBAYER_H
+#define	OAT_DEBAYER_H
+
+#include "ColorConvert.h"
+
+namespace oat {
+
+/**
+ * A Bayer demosaicing filter. Frame servers can publish raw Bayer mosaics,
+ * which are a third the size of BGR frames, and leave demosaicing to this
+ * filter so that only components that need color pay for it.
+ */
+class Debayer : public ColorConvert {
+public:
+
+    /**
+     * @brief Bayer demosaicing
+     *
+     * @param frame_souce_address raw Bayer frame source address
+     * @param frame_sink_address demosaiced frame sink address
+     */
+    Debayer(const std::string &frame_souce_address,
+            const std::string &frame_sink_address);
+
+private:
+    po::options_description options() const override;
+    void applyConfiguration(const po::variables_map &vm,
+                            const config::OptionTable &config_table) override;
+};
+
+}      /* namespace oat */
+#endif /* OAT_DEBAYER_H */
@@ -19,8 +19,12 @@
 
 #include "FrameFilter.h"
 
+#include <chrono>
 #include <string>
 
+#include "../../lib/utility/ProgramOptions.h"
+#include "../../lib/utility/TOMLSanitize.h"
+
 namespace oat {
 
 FrameFilter::FrameFilter(const std::string &frame_source_address,
@@ -34,6 +38,53 @@ FrameFilter::FrameFilter(const std::string &frame_source_address,
     // Nothing
 }
 
+FrameFilter::~FrameFilter()
+{
+    {
+        std::lock_guard<std::mutex> lock(jobs_mutex_);
+        stop_workers_ = true;
+    }
+    job_ready_.notify_all();
+
+    for (auto &w : workers_)
+        w.join();
+}
+
+po::options_description FrameFilter::baseOptions(void) const
+{
+    po::options_description base_opts;
+
+    // Common program options
+    base_opts.add_options()
+        ("workers", po::value<int>(),
+         "Number of threads that filter frames. Frames are published in the "
+         "order they were received. Only filters that do not carry state "
+         "from one frame to the next can use more than one worker. Defaults "
+         "to 1.")
+        ;
+
+    return base_opts;
+}
+
+void FrameFilter::applyBaseConfiguration(
+    const po::variables_map &vm, const config::OptionTable &config_table)
+{
+    // Worker threads
+    int workers = 1;
+    oat::config::getNumericValue<int>(
+        vm, config_table, "workers", workers, 1, 64);
+
+    if (workers > 1 && !parallelizable())
+        throw std::runtime_error(name_ + " carries state from one frame to "
+                                 "the next and cannot use more than one "
+                                 "worker.");
+
+    num_workers_ = workers;
+
+    // Each worker draws its own temporaries
+    frame_pool_.reserve(frame_pool_.capacity() * num_workers_);
+}
+
 bool FrameFilter::connectToNode()
 {
     // Establish our a slot in the source node
@@ -58,43 +109,233 @@ bool FrameFilter::connectToNode()
 
 int FrameFilter::process()
 {
-    oat::Frame internal_frame;
+    if (num_workers_ > 1)
+        return processParallel();
 
     // START CRITICAL SECTION //
     ////////////////////////////
 
-    // Wait for sink to write to node
-    if (frame_source_.wait() == oat::NodeState::END)
-        return 1;
+    oat::Frame * frame;
+    {
+        // Wait for sink to write to node
+        auto lease = frame_source_.borrow();
+        if (lease.node_state() == oat::NodeState::END)
+            return 1;
 
-    // Clone the shared frame
-    frame_source_.copyTo(internal_frame);
+        if (!frame_sink_.wouldBlock()) {
 
-    // Tell sink it can continue
-    frame_source_.post();
+            // Copy the source frame straight into shared memory
+            frame = frame_sink_.acquire();
+            lease.frame().copyTo(*frame);
+
+        } else {
+
+            // Downstream sources have yet to read, so copy the source frame
+            // aside and let the upstream sink continue while they do
+            auto temp = frame_pool_.acquire(lease.frame().rows,
+                                            lease.frame().cols,
+                                            lease.frame().type(),
+                                            lease.frame().color());
+            lease.frame().copyTo(temp.frame());
+            lease.release();
+
+            // Wait for sources to read
+            frame = frame_sink_.acquire();
+            temp.frame().copyTo(*frame);
+        }
+
+        // Lease tells sink it can continue
+    }
+
+    // Filter shared frame in place
+    filter(*frame);
+
+    // Tell sources there is new data
+    frame_sink_.commit(frame->sample());
 
     ////////////////////////////
     //  END CRITICAL SECTION  //
 
-    // Filter internal frame
-    filter(internal_frame);
+    // Sink was not at END state
+    return 0;
+}
+
+cv::Mat &FrameFilter::filterInto(oat::Frame &in, cv::Mat &)
+{
+    filter(in);
+    return in;
+}
+
+void FrameFilter::filterJob(Job &job)
+{
+    // Filters see the job's input as a frame with its color and sample
+    oat::Frame in(job.in.rows, job.in.cols, job.in.type(), job.color,
+                  job.in.data, &job.sample);
+
+    const cv::Mat &filtered = filterInto(in, job.out);
+    job.filtered = &filtered == &job.out ? &job.out : &job.in;
+}
+
+int FrameFilter::processParallel()
+{
+    // Each worker can have a frame in flight while as many wait to be
+    // published
+    if (jobs_.empty()) {
+        jobs_.resize(2 * num_workers_);
+        for (auto &j : jobs_)
+            j.out.create(shared_frame_->rows,
+                         shared_frame_->cols,
+                         shared_frame_->type());
+
+        // The source's sink and the workers post the same Waker, so that
+        // this thread can wait for either a new frame or a filtered one
+        if (threadWaker().valid()
+            && frame_source_.set_waker(threadWaker().id()))
+            waker_id_ = threadWaker().id();
+    }
+
+    // Publish filtered frames. If every job is in flight, wait for the
+    // oldest.
+    publishFinished(jobs_in_flight_ == jobs_.size());
+
+    // Wait for the next frame or for a worker to finish one, which is
+    // published on the next call. If there is no Waker, poll so that
+    // filtered frames are not held back when the source is slow.
+    oat::NodeState state;
+    if (waker_id_ == Waker::NONE) {
+        if (!frame_source_.tryWait(std::chrono::milliseconds(1), state))
+            return 0;
+    } else if (!frame_source_.tryWait(std::chrono::microseconds(0), state)) {
+        threadWaker().wait();
+        return 0;
+    }
+
+    if (state == oat::NodeState::END) {
+        while (jobs_in_flight_ > 0)
+            publishFinished(true);
+        return 1;
+    }
+
+    Job &job = jobs_[(jobs_head_ + jobs_in_flight_) % jobs_.size()];
 
     // START CRITICAL SECTION //
     ////////////////////////////
 
-    // Wait for sources to read
-    frame_sink_.wait();
-
-    internal_frame.copyTo(shared_frame_);
+    const oat::Frame *frame = frame_source_.retrieve();
+    static_cast<const cv::Mat &>(*frame).copyTo(job.in);
+    job.color = frame->color();
+    job.sample = frame->sample();
 
-    // Tell sources there is new data
-    frame_sink_.post();
+    // Tell sink it can continue
+    frame_source_.post();
 
     ////////////////////////////
     //  END CRITICAL SECTION  //
 
-    // Sink was not at END state
+    // The first frame is filtered here, before the workers start, so that
+    // filters can initialize state that depends on the frame
+    if (workers_.empty()) {
+        filterJob(job);
+        job.state = Job::DONE;
+        jobs_in_flight_++;
+        publishFinished(false);
+
+        for (size_t i = 0; i < num_workers_; i++)
+            workers_.emplace_back([this] { runWorker(); });
+
+        return 0;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(jobs_mutex_);
+        job.state = Job::READY;
+        jobs_in_flight_++;
+    }
+    job_ready_.notify_one();
+
     return 0;
 }
 
+void FrameFilter::publishFinished(const bool block)
+{
+    bool wait = block;
+
+    while (jobs_in_flight_ > 0) {
+
+        Job &job = jobs_[jobs_head_];
+        {
+            std::unique_lock<std::mutex> lock(jobs_mutex_);
+            if (wait)
+                job_done_.wait(lock, [&job] { return job.state == Job::DONE; });
+            else if (job.state != Job::DONE)
+                return;
+
+            // Pass exceptions from the workers to the processing thread
+            if (worker_ex_)
+                std::rethrow_exception(worker_ex_);
+        }
+
+        // START CRITICAL SECTION //
+        ////////////////////////////
+
+        // Wait for sources to read
+        oat::Frame *frame = frame_sink_.acquire();
+
+        job.filtered->copyTo(*frame);
+
+        // Tell sources there is new data
+        frame_sink_.commit(job.sample);
+
+        ////////////////////////////
+        //  END CRITICAL SECTION  //
+
+        std::lock_guard<std::mutex> lock(jobs_mutex_);
+        job.state = Job::FREE;
+        jobs_head_ = (jobs_head_ + 1) % jobs_.size();
+        jobs_in_flight_--;
+        wait = false;
+    }
+}
+
+void FrameFilter::runWorker()
+{
+    // Workers inherit the scheduling of the processing thread, which
+    // creates them
+
+    std::unique_lock<std::mutex> lock(jobs_mutex_);
+
+    while (true) {
+
+        // Oldest frame that has yet to be filtered
+        Job *job = nullptr;
+        job_ready_.wait(lock, [this, &job] {
+            for (size_t i = 0; i < jobs_in_flight_ && job == nullptr; i++) {
+                Job &j = jobs_[(jobs_head_ + i) % jobs_.size()];
+                if (j.state == Job::READY)
+                    job = &j;
+            }
+            return stop_workers_ || job != nullptr;
+        });
+
+        if (stop_workers_)
+            return;
+
+        job->state = Job::BUSY;
+        lock.unlock();
+
+        try {
+            filterJob(*job);
+        } catch (...) {
+            lock.lock();
+            worker_ex_ = std::current_exception();
+            lock.unlock();
+        }
+
+        lock.lock();
+        job->state = Job::DONE;
+        job_done_.notify_one();
+        Waker::post(waker_id_);
+    }
+}
+
 } /* namespace oat */
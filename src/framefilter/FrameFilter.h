@@ -20,11 +20,17 @@
 #ifndef OAT_FRAMEFILT_H
 #define	OAT_FRAMEFILT_H
 
+#include <condition_variable>
+#include <exception>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "../../lib/base/Configurable.h"
 #include "../../lib/base/ControllableComponent.h"
 #include "../../lib/datatypes/Frame.h"
+#include "../../lib/datatypes/FramePool.h"
 #include "../../lib/shmemdf/Sink.h"
 #include "../../lib/shmemdf/Source.h"
 
@@ -46,7 +52,7 @@ public:
      */
     explicit FrameFilter(const std::string &frame_source_address,
                          const std::string &frame_sink_address);
-    virtual ~FrameFilter() { };
+    virtual ~FrameFilter();
 
     // Component Interface
     oat::ComponentType type(void) const override { return oat::framefilter; };
@@ -63,11 +69,78 @@ protected:
      */
     virtual void filter(cv::Mat &frame) = 0;
 
+    /**
+     * Filter a frame that may be written to a separate output frame. Used by
+     * the workers of a parallel filter. By default, filters the input in
+     * place. Override if the output differs from the input in size or type.
+     * @param in Unfiltered frame, which may be modified
+     * @param out Spare frame with the size and type of the shared frame
+     * @return The filtered frame, either in or out
+     */
+    virtual cv::Mat &filterInto(oat::Frame &in, cv::Mat &out);
+
+    /**
+     * Check if filter() can be run concurrently on different frames. Filters
+     * that carry state from one frame to the next must return false. The
+     * first frame is filtered before the workers start, so filter() may
+     * initialize state on its first call.
+     * @return True if frames may be filtered by several workers.
+     */
+    virtual bool parallelizable(void) const { return false; }
+
+    /**
+     * @brief Options common to all frame filters.
+     */
+    po::options_description baseOptions(void) const;
+
+    /**
+     * @brief Apply options common to all frame filters.
+     */
+    void applyBaseConfiguration(const po::variables_map &vm,
+                                const config::OptionTable &config_table);
+
+    // Temporary frames used by filter(), so that it does not allocate
+    oat::FramePool frame_pool_;
+
+    // Number of threads that filter frames
+    size_t num_workers_ {1};
+
+    // Number of stripes that filters accepting oat::config::stripeOptions()
+    // split each frame into
+    int stripes_ {1};
+
 private:
     // Component Interface
     virtual bool connectToNode(void) override;
     int process(void) override;
 
+    // Frame that has been read from the source and is filtered by a worker.
+    // Jobs form a ring, in the order their frames were read, so that
+    // filtered frames are published in order.
+    struct Job {
+        enum State {FREE, READY, BUSY, DONE};
+        State state {FREE};
+        cv::Mat in, out;
+        const cv::Mat *filtered {nullptr}; //!< Either in or out
+        oat::PixelColor color;
+        oat::Sample sample;
+    };
+
+    // Parallel filtering
+    int processParallel(void);
+    void filterJob(Job &job);
+    void runWorker(void);
+    void publishFinished(const bool block);
+
+    std::vector<Job> jobs_;
+    size_t jobs_head_ {0}, jobs_in_flight_ {0};
+    std::vector<std::thread> workers_;
+    std::mutex jobs_mutex_;
+    std::condition_variable job_ready_, job_done_;
+    uint32_t waker_id_ {Waker::NONE}; //!< Posted when a job is DONE
+    bool stop_workers_ {false};
+    std::exception_ptr worker_ex_;
+
     // Frame source
     const std::string frame_source_address_;
     oat::Source<oat::Frame> frame_source_;
@@ -77,7 +150,7 @@ private:
     oat::Sink<oat::Frame> frame_sink_;
 
     // Currently acquired, shared frame
-    oat::Frame shared_frame_;
+    oat::Frame * shared_frame_ {nullptr};
 };
 
 }      /* namespace oat */
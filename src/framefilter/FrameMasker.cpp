@@ -26,6 +26,7 @@
 
 #include "../../lib/utility/IOFormat.h"
 #include "../../lib/utility/ProgramOptions.h"
+#include "../../lib/utility/Stripes.h"
 #include "../../lib/utility/TOMLSanitize.h"
 
 namespace oat {
@@ -40,7 +41,7 @@ FrameMasker::FrameMasker(const std::string &frame_source_address,
 po::options_description FrameMasker::options() const
 {
     // Update CLI options
-    po::options_description local_opts;
+    po::options_description local_opts(baseOptions());
     local_opts.add_options()
         ("mask,f", po::value<std::string>(),
          "Path to a binary image used to mask frames from SOURCE. SOURCE frame "
@@ -48,6 +49,7 @@ po::options_description FrameMasker::options() const
          "image will be unaffected. Others will be set to zero. This image must "
          "have the same dimensions as frames from SOURCE.")
         ;
+    local_opts.add(oat::config::stripeOptions());
 
     return local_opts;
 }
@@ -55,6 +57,8 @@ po::options_description FrameMasker::options() const
 void FrameMasker::applyConfiguration(const po::variables_map &vm,
                                      const config::OptionTable &config_table)
 {
+    applyBaseConfiguration(vm, config_table);
+
     // Background image path
     std::string img_path;
     if (oat::config::getValue(vm, config_table, "mask", img_path, true)) {
@@ -64,14 +68,24 @@ void FrameMasker::applyConfiguration(const po::variables_map &vm,
         if (roi_mask_.data == NULL)
             throw (std::runtime_error("File \"" + img_path + "\" could not be read."));
 
+        // Pixels to zero
+        roi_mask_ = roi_mask_ == 0;
         mask_set_ = true;
     }
+
+    // Stripes
+    oat::config::getNumericValue<int>(
+        vm, config_table, "stripes", stripes_, 1, 256);
 }
 
 void FrameMasker::filter(cv::Mat &frame)
 {
-    if (mask_set_)
-        frame.setTo(0, roi_mask_ == 0);
+    if (!mask_set_)
+        return;
+
+    oat::forEachStripe(frame.rows, stripes_, [&](const cv::Range &r) {
+        frame.rowRange(r).setTo(0, roi_mask_.rowRange(r));
+    });
 }
 
 } /* namespace oat */
@@ -46,8 +46,9 @@ private:
                             const config::OptionTable &config_table) override;
 
     void filter(cv::Mat& frame) override;
+    bool parallelizable(void) const override { return true; }
 
-    // Mask frames with an arbitrary ROI
+    // Mask frames with an arbitrary ROI. Non-zero where frames are zeroed.
     bool mask_set_ = false;
     cv::Mat roi_mask_;
 };
@@ -25,6 +25,7 @@
 
 #include "../../lib/utility/IOFormat.h"
 #include "../../lib/utility/ProgramOptions.h"
+#include "../../lib/utility/Stripes.h"
 #include "../../lib/utility/TOMLSanitize.h"
 
 namespace oat {
@@ -39,12 +40,13 @@ Threshold::Threshold(const std::string &frame_source_address,
 po::options_description Threshold::options() const
 {
     // Update CLI options
-    po::options_description local_opts;
+    po::options_description local_opts(baseOptions());
     local_opts.add_options()
         ("intensity,I", po::value<std::string>(),
          "Array of ints between 0 and 256, [min,max], specifying the "
          "intensity passband.")
         ;
+    local_opts.add(oat::config::stripeOptions());
 
     return local_opts;
 }
@@ -52,6 +54,8 @@ po::options_description Threshold::options() const
 void Threshold::applyConfiguration(const po::variables_map &vm,
                                    const config::OptionTable &config_table)
 {
+    applyBaseConfiguration(vm, config_table);
+
     // Intensity
     std::vector<int> i;
     if (oat::config::getArray<int, 2>(vm, config_table, "intensity", i)) {
@@ -62,22 +66,39 @@ void Threshold::applyConfiguration(const po::variables_map &vm,
         if (i_min_ < 0 || i_min_> 256 || i_max_ < 0 || i_max_ > 256)
            throw std::runtime_error("Values of intensity should be between 0 and 256.");
     }
+
+    // Stripes
+    oat::config::getNumericValue<int>(
+        vm, config_table, "stripes", stripes_, 1, 256);
 }
 
 void Threshold::filter(cv::Mat &frame)
 {
-    cv::Mat grey_frame, thresh_frame;
+    auto thresh = frame_pool_.acquire(frame.rows, frame.cols, CV_8UC1);
 
     auto conversion_code = oat::color_conv_code(
         static_cast<oat::Frame &>(frame).color(), oat::PIX_GREY);
 
-    if (conversion_code >= 0)
-        cv::cvtColor(frame, grey_frame, conversion_code);
-    else
-        grey_frame = frame;
+    // Only used for color frames
+    auto grey = frame_pool_.acquire(frame.rows, frame.cols, CV_8UC1);
+
+    oat::forEachStripe(frame.rows, stripes_, [&](const cv::Range &r) {
+
+        cv::Mat in = frame.rowRange(r);
+        cv::Mat mask = thresh.frame().rowRange(r);
+
+        if (conversion_code >= 0) {
+            cv::Mat g = grey.frame().rowRange(r);
+            cv::cvtColor(in, g, conversion_code);
+            cv::inRange(g, i_min_, i_max_, mask);
+        } else {
+            cv::inRange(in, i_min_, i_max_, mask);
+        }
 
-    cv::inRange(grey_frame, i_min_, i_max_, thresh_frame);
-    frame.setTo(cv::Scalar(0, 0, 0), thresh_frame == 0);
+        // Zero pixels outside of the passband
+        cv::bitwise_not(mask, mask);
+        in.setTo(cv::Scalar(0, 0, 0), mask);
+    });
 }
 
 } /* namespace oat */
@@ -44,6 +44,7 @@ private:
                             const config::OptionTable &config_table) override;
 
     void filter(cv::Mat &frame) override;
+    bool parallelizable(void) const override { return true; }
 
     // Intensity threshold boundaries
     int i_min_ {0};
@@ -41,7 +41,7 @@ Undistorter::Undistorter(const std::string &source_name,
 po::options_description Undistorter::options() const
 {
     // Update CLI options
-    po::options_description local_opts;
+    po::options_description local_opts(baseOptions());
     local_opts.add_options()
         ("camera-matrix,k", po::value<std::string>(),
          "Nine element float array, [K11,K12,...,K33], specifying the 3x3 "
@@ -57,6 +57,8 @@ po::options_description Undistorter::options() const
 void Undistorter::applyConfiguration(const po::variables_map &vm,
                                      const config::OptionTable &config_table)
 {
+    applyBaseConfiguration(vm, config_table);
+
     if (oat::config::getArray<double>(
             vm, config_table, "distortion-coeffs", dist_coeff_, true)) {
 
@@ -82,9 +84,19 @@ void Undistorter::applyConfiguration(const po::variables_map &vm,
 
 void Undistorter::filter(cv::Mat &frame)
 {
-    cv::Mat temp = frame.clone();
-    // TODO: too slow -- GPU implementation.
-    cv::undistort(temp, frame, camera_matrix_, dist_coeff_);
+    // cv::undistort() recomputes the undistortion maps on every call. Compute
+    // them once per frame size instead.
+    if (frame.size() != map_size_) {
+        cv::initUndistortRectifyMap(camera_matrix_, dist_coeff_, cv::Mat(),
+                                    camera_matrix_, frame.size(), CV_16SC2,
+                                    map_x_, map_y_);
+        map_size_ = frame.size();
+    }
+
+    // Remapping cannot be done in place
+    auto temp = frame_pool_.acquire(frame.rows, frame.cols, frame.type());
+    frame.copyTo(temp.frame());
+    cv::remap(temp.frame(), frame, map_x_, map_y_, cv::INTER_LINEAR);
 }
 
 } /* namespace oat */
@@ -54,9 +54,17 @@ private:
      */
     void filter(cv::Mat &frame) override;
 
+    // The undistortion maps are computed on the first frame, before any
+    // worker starts, and only read afterwards
+    bool parallelizable(void) const override { return true; }
+
     cv::Matx33d camera_matrix_ {cv::Matx33d::eye()};
     std::vector<double> dist_coeff_;
 
+    // Undistortion maps for frames of map_size_
+    cv::Size map_size_;
+    cv::Mat map_x_, map_y_;
+
     static const std::map<std::string, int> commands_;
 };
 
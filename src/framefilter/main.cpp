@@ -34,6 +34,7 @@
 #include "BackgroundSubtractor.h"
 #include "BackgroundSubtractorMOG.h"
 #include "ColorConvert.h"
+#include "Debayer.h"
 #include "FrameFilter.h"
 #include "FrameMasker.h"
 #include "Undistorter.h"
@@ -47,6 +48,7 @@ const char usage_type[] =
     "TYPE\n"
     "  bsub: Background subtraction\n"
     "  col: Color conversion\n"
+    "  debayer: Bayer demosaicing\n"
     "  mask: Binary mask\n"
     "  mog: Mixture of Gaussians background segmentation.\n"
     "  undistort: Correct for lens distortion using lens distortion model.\n"
@@ -103,6 +105,7 @@ int main(int argc, char *argv[]) {
     type_hash["undistort"] = 'd';
     type_hash["col"] = 'e';
     type_hash["thresh"] = 'f';
+    type_hash["debayer"] = 'g';
 
     // The component itself
     std::string comp_name = "framefilt";
@@ -191,6 +194,11 @@ int main(int argc, char *argv[]) {
                     filter = std::make_shared<oat::Threshold>(source, sink);
                     break;
                 }
+                case 'g':
+                {
+                    filter = std::make_shared<oat::Debayer>(source, sink);
+                    break;
+                }
                 default:
                 {
                     printUsage(visible_options, "");
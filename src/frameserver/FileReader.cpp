@@ -37,12 +37,21 @@ FileReader::FileReader(const std::string &sink_address)
 po::options_description FileReader::options() const
 {
     // Update CLI options
-    po::options_description local_opts;
+    // Start with base options
+    po::options_description local_opts(baseOptions());
     local_opts.add_options()
         ("video-file,f", po::value<std::string>(),
          "Path to video file to serve frames from.")
         ("fps,r", po::value<double>(),
          "Frames to serve per second.")
+        ("color,C", po::value<std::string>(),
+         "Pixel color format. Defaults to BGR.\n"
+         "Values:\n"
+         "  GREY: \t 8-bit Greyscale image.\n"
+         "  BGR: \t8-bit, 3-chanel, BGR Color image.\n"
+         "  BAYER_RG, BAYER_GB, BAYER_GR, BAYER_BG: \t8-bit raw Bayer "
+         "mosaic, for videos that hold raw frames as greyscale. Use "
+         "oat-framefilt debayer to demosaic them.\n")
         ("roi", po::value<std::string>(),
          "Four element array of unsigned ints, [x0,y0,width,height],"
          "defining a rectangular region of interest. Origin"
@@ -65,6 +74,15 @@ void FileReader::applyConfiguration(const po::variables_map &vm,
     if (oat::config::getNumericValue(vm, config_table, "fps", frames_per_second_, 0.0))
         calculateFramePeriod();
 
+    // Pixel color
+    std::string col;
+    if (oat::config::getValue<std::string>(vm, config_table, "color", col)) {
+        color_ = oat::str_color(col);
+        if (color_ != PIX_GREY && color_ != PIX_BGR && !oat::is_bayer(color_))
+            throw std::runtime_error("Videos can only be served as GREY, BGR "
+                                     "or Bayer frames.");
+    }
+
     // ROI
     std::vector<size_t> roi;
     if (oat::config::getArray<size_t, 4>(vm, config_table, "roi", roi)) {
@@ -75,6 +93,9 @@ void FileReader::applyConfiguration(const po::variables_map &vm,
         region_of_interest_.width  = roi[2];
         region_of_interest_.height = roi[3];
     }
+
+    // Shared frame sink
+    applyBaseConfiguration(vm, config_table);
 }
 
 bool FileReader::connectToNode()
@@ -86,40 +107,46 @@ bool FileReader::connectToNode()
         example_frame = example_frame(region_of_interest_);
 
     frame_sink_.bind(frame_sink_address_,
-            example_frame.total() * example_frame.elemSize());
+            example_frame.total() * oat::color_bytes(color_),
+            ring_depth_);
 
-    shared_frame_ = frame_sink_.retrieve(
-            example_frame.rows, example_frame.cols, example_frame.type(), PIX_BGR);
+    shared_frame_ = frame_sink_.retrieve(example_frame.rows,
+                                         example_frame.cols,
+                                         oat::cv_type(color_),
+                                         color_);
 
     // Reset the video to the start
     file_reader_.set(cv::CAP_PROP_POS_AVI_RATIO, 0);
 
     // Put the sample rate in the shared frame
-    shared_frame_.set_rate_hz(1.0 / frame_period_in_sec_.count());
+    shared_frame_->set_rate_hz(1.0 / frame_period_in_sec_.count());
 
     return true;
 }
 
 int FileReader::process()
 {
-    cv::Mat frame;
-    if (!file_reader_.read(frame)) 
+    // Decode before acquiring the ring slot so that sources are not held up
+    // by decoding and the slot is never left acquired at the end of the file
+    if (!file_reader_.read(decoded_))
         return 1;
 
-    if (use_roi_ )
-        frame = frame(region_of_interest_);
+    cv::Mat mat = use_roi_ ? decoded_(region_of_interest_) : decoded_;
 
     // START CRITICAL SECTION //
     ////////////////////////////
 
     // Wait for sources to read
-    frame_sink_.wait();
+    oat::Frame * frame = frame_sink_.acquire();
 
-    frame.copyTo(shared_frame_);
-    shared_frame_.incrementSampleCount();
+    // Drop the color channels of greyscale and Bayer videos
+    if (color_ != PIX_BGR)
+        cv::cvtColor(mat, *frame, cv::COLOR_BGR2GRAY);
+    else
+        mat.copyTo(*frame);
 
     // Tell sources there is new data
-    frame_sink_.post();
+    frame_sink_.commit();
 
     ////////////////////////////
     //  END CRITICAL SECTION  //
@@ -55,6 +55,14 @@ private:
     // Region of interest
     cv::Rect_<size_t> region_of_interest_;
 
+    // Pixel color of published frames. Anything but BGR means that the video
+    // holds greyscale or raw Bayer frames, which are published with a single
+    // channel.
+    oat::PixelColor color_ {oat::PIX_BGR};
+
+    // Most recently decoded frame, before it is copied to the frame sink
+    cv::Mat decoded_;
+
     // Frame generation clock
     std::chrono::high_resolution_clock clock_;
     std::chrono::duration<double> frame_period_in_sec_;
@@ -19,8 +19,13 @@
 
 #include "FrameServer.h"
 
+#include <chrono>
 #include <string>
 
+#include <cpptoml.h>
+
+#include "../../lib/utility/TOMLSanitize.h"
+
 namespace oat {
 
 FrameServer::FrameServer(const std::string &frame_sink_address) :
@@ -29,4 +34,81 @@ FrameServer::FrameServer(const std::string &frame_sink_address) :
 {
     // Nothing
 }
+
+po::options_description FrameServer::baseOptions(void) const
+{
+    po::options_description base_opts;
+
+    // Common program options
+    base_opts.add_options()
+        ("ring-depth", po::value<size_t>(),
+         "Number of frames held in shared memory. Blocking readers can fall "
+         "this many frames behind before the server waits on them. Defaults "
+         "to 1.")
+        ("max-sources", po::value<size_t>(),
+         "Maximum number of components that can read frames from this server. "
+         "Up to 64. Defaults to 10.")
+        ("huge-page-dir", po::value<std::string>(),
+         "Directory on a hugetlbfs mount, e.g. /dev/hugepages, in which to "
+         "place the shared frame ring so that it is backed by huge pages. "
+         "Defaults to the normal shared memory segment.")
+        ("lock-ring",
+         "If specified, prefault the shared frame ring and lock it into RAM "
+         "so that frames are never paged out.")
+        ("reader-deadline", po::value<size_t>(),
+         "Milliseconds that a component reading frames from this server may "
+         "hold up the server before it is evicted and its frames are "
+         "skipped. Components that crash are always evicted. Defaults to 0, "
+         "which never evicts running components.")
+        ("backpressure", po::value<std::string>(),
+         "What the server does when a component has yet to read the frame "
+         "that would be overwritten next. Values:\n"
+         "  block: wait for the component.\n"
+         "  drop-oldest: overwrite the unread frame. Components skip to the "
+         "most recent frame. Best for low latency closed loop experiments. "
+         "Requires a ring-depth of at least 2.\n"
+         "  drop-newest: discard the new frame.\n"
+         "Dropped frames appear as gaps in the sample count. Defaults to "
+         "block.")
+        ;
+
+    return base_opts;
+}
+
+void FrameServer::applyBaseConfiguration(const po::variables_map &vm,
+                                         const config::OptionTable &config_table)
+{
+    // Shared frame ring
+    oat::config::getNumericValue<size_t>(
+        vm, config_table, "ring-depth", ring_depth_, 1, Node::MAX_RING_DEPTH);
+
+    // Fan-out
+    size_t max_sources;
+    if (oat::config::getNumericValue<size_t>(
+            vm, config_table, "max-sources", max_sources, 1, Node::MAX_SLOTS))
+        frame_sink_.set_max_sources(max_sources);
+
+    // Frame ring memory
+    std::string huge_page_dir;
+    if (oat::config::getValue<std::string>(
+            vm, config_table, "huge-page-dir", huge_page_dir))
+        frame_sink_.set_huge_page_dir(huge_page_dir);
+
+    bool lock_ring {false};
+    oat::config::getValue<bool>(vm, config_table, "lock-ring", lock_ring);
+    frame_sink_.set_lock_ring(lock_ring);
+
+    // Unresponsive readers
+    size_t reader_deadline_ms;
+    if (oat::config::getNumericValue<size_t>(
+            vm, config_table, "reader-deadline", reader_deadline_ms))
+        frame_sink_.set_reader_deadline(
+            std::chrono::milliseconds(reader_deadline_ms));
+
+    // Slow readers
+    std::string backpressure;
+    if (oat::config::getValue<std::string>(
+            vm, config_table, "backpressure", backpressure))
+        frame_sink_.set_backpressure(oat::backpressurePolicy(backpressure));
+}
 } /* namespace oat */
@@ -48,6 +48,17 @@ public:
     std::string name(void) const override { return name_; }
 
 protected:
+    /**
+     * @brief Options common to all frame servers.
+     */
+    po::options_description baseOptions(void) const;
+
+    /**
+     * @brief Apply options common to all frame servers.
+     */
+    void applyBaseConfiguration(const po::variables_map &vm,
+                                const config::OptionTable &config_table);
+
     // Component name
     std::string name_;
 
@@ -58,10 +69,11 @@ protected:
     // Frame sink
     const std::string frame_sink_address_;
     oat::Sink<oat::Frame> frame_sink_;
+    size_t ring_depth_ {1};
 
     // Currently acquired, shared frame
     //bool frame_empty_ {true};
-    oat::Frame shared_frame_;
+    oat::Frame * shared_frame_ {nullptr};
 };
 
 }       /* namespace oat */
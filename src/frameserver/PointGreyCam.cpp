@@ -47,7 +47,18 @@ const typename PointGreyCam<T>::PixelMap PointGreyCam<T>::pix_map_ =
     {PIX_GREY,
         std::make_tuple(pg::PIXEL_FORMAT_MONO8, pg::PIXEL_FORMAT_MONO8, CV_8UC1)},
     {PIX_BGR,
-        std::make_tuple(pg::PIXEL_FORMAT_RAW8, pg::PIXEL_FORMAT_BGR, CV_8UC3)}
+        std::make_tuple(pg::PIXEL_FORMAT_RAW8, pg::PIXEL_FORMAT_BGR, CV_8UC3)},
+    {PIX_GREY16,
+        std::make_tuple(pg::PIXEL_FORMAT_MONO16, pg::PIXEL_FORMAT_MONO16, CV_16UC1)},
+    // Raw mosaics are published as is. The pattern must match the sensor's.
+    {PIX_BAYER_RG,
+        std::make_tuple(pg::PIXEL_FORMAT_RAW8, pg::PIXEL_FORMAT_RAW8, CV_8UC1)},
+    {PIX_BAYER_GB,
+        std::make_tuple(pg::PIXEL_FORMAT_RAW8, pg::PIXEL_FORMAT_RAW8, CV_8UC1)},
+    {PIX_BAYER_GR,
+        std::make_tuple(pg::PIXEL_FORMAT_RAW8, pg::PIXEL_FORMAT_RAW8, CV_8UC1)},
+    {PIX_BAYER_BG,
+        std::make_tuple(pg::PIXEL_FORMAT_RAW8, pg::PIXEL_FORMAT_RAW8, CV_8UC1)}
 };
 
 template <typename T>
@@ -71,7 +82,8 @@ template <typename T>
 po::options_description PointGreyCam<T>::options() const
 {
     // Update CLI options
-    po::options_description local_opts;
+    // Start with base options
+    po::options_description local_opts(baseOptions());
     local_opts.add_options()
         ("index,i", po::value<int>(),
          "Camera index. Defaults to 0. Useful in multi-camera imaging "
@@ -91,7 +103,11 @@ po::options_description PointGreyCam<T>::options() const
          "Pixel color format. Defaults to BRG.\n"
          "Values:\n"
          "  GREY: \t 8-bit Greyscale image.\n"
-         "  BRG: \t8-bit, 3-chanel, BGR Color image.\n")
+         "  BRG: \t8-bit, 3-chanel, BGR Color image.\n"
+         "  GREY16: \t16-bit Greyscale image.\n"
+         "  BAYER_RG, BAYER_GB, BAYER_GR, BAYER_BG: \t8-bit raw Bayer "
+         "mosaic, which must match the sensor's pattern. A third the size "
+         "of BGR. Use oat-framefilt debayer to demosaic it.\n")
         ("gain,g", po::value<double>(),
          "Sensor gain value, specified in dB. Defaults to auto.")
         ("strobe-pin,S", po::value<size_t>(),
@@ -148,6 +164,9 @@ void PointGreyCam<T>::applyConfiguration(
     oat::config::getNumericValue<int>(
         vm, config_table, "index", index, 0, num_cams - 1);
 
+    // Shared frame sink
+    applyBaseConfiguration(vm, config_table);
+
     connectToCamera(index);
     turnCameraOn();
 
@@ -354,7 +373,7 @@ void PointGreyCam<T>::setupWhiteBalance(int bal_red, int bal_blue, bool is_on, b
     }
 
     // Mono pixels do not support white balance
-    if (pix_col_ == PIX_GREY) {
+    if (pix_col_ == PIX_GREY || pix_col_ == PIX_GREY16) {
         std::cerr << oat::Warn(
             "You cannot adjust the white balance for mono frames.");
         return;
@@ -723,17 +742,18 @@ int PointGreyCam<T>::process()
         ////////////////////////////
 
         // Wait for sources to read
-        frame_sink_.wait();
+        oat::Frame * frame = frame_sink_.acquire();
+
+        // Point shmem_image_ at the ring slot to be written
+        shmem_image_->SetData(frame->data, shmem_image_->GetDataSize());
 
         if (color_conversion_required_)
             raw_image.Convert(std::get<PG_TO>(pix_map_.at(pix_col_)), shmem_image_.get());
         else
             shmem_image_->DeepCopy(&raw_image);
 
-        shared_frame_.incrementSampleCount(tick_);
-
         // Tell sources there is new data
-        frame_sink_.post();
+        frame_sink_.commit(tick_);
 
         ////////////////////////////
         //  END CRITICAL SECTION  //
@@ -1041,13 +1061,13 @@ bool PointGreyCam<pg::GigECamera>::connectToNode()
     const size_t cols = temp.GetCols();
     const size_t stride = temp.GetStride();
 
-    frame_sink_.bind(frame_sink_address_, bytes);
+    frame_sink_.bind(frame_sink_address_, bytes, ring_depth_);
 
     shared_frame_ = frame_sink_.retrieve(
         rows, cols, std::get<CV_TYPE>(pix_map_.at(pix_col_)), pix_col_);
-    shared_frame_.set_rate_hz(frames_per_second_);
+    shared_frame_->set_rate_hz(frames_per_second_);
 
-    // Use the shared_frame_.data, which points to a block of shared memory as
+    // Use the shared_frame_->data, which points to a block of shared memory as
     // rbg_image's data buffer. When changes are made to shmem_image_, this is
     // automatically propagated into shmem and 'converted' into a cv::Mat
     // (although this 'conversion' is simply filling in appropriate header info,
@@ -1056,7 +1076,7 @@ bool PointGreyCam<pg::GigECamera>::connectToNode()
         = oat::make_unique<pg::Image>(rows,
                                       cols,
                                       stride,
-                                      shared_frame_.data,
+                                      shared_frame_->data,
                                       bytes,
                                       std::get<PG_TO>(pix_map_.at(pix_col_)));
     return true;
@@ -1226,18 +1246,18 @@ bool PointGreyCam<pg::Camera>::connectToNode()
     const size_t cols = temp.GetCols();
     const size_t stride = temp.GetStride();
 
-    frame_sink_.bind(frame_sink_address_, bytes);
+    frame_sink_.bind(frame_sink_address_, bytes, ring_depth_);
 
     shared_frame_ = frame_sink_.retrieve(rows, cols, std::get<CV_TYPE>(pix_map_.at(pix_col_)), pix_col_);
-    shared_frame_.set_rate_hz(frames_per_second_);
+    shared_frame_->set_rate_hz(frames_per_second_);
 
-    // Use the shared_frame_.data, which points to a block of shared memory as
+    // Use the shared_frame_->data, which points to a block of shared memory as
     // rbg_image's data buffer. When changes are made to shmem_image_, this is
     // automatically propagated into shmem and 'converted' into a cv::Mat
     // (although this 'conversion' is simply filling in appropriate header info,
     // which was accomplished in the call to frame_sink_.retrieve())
     shmem_image_ = oat::make_unique<pg::Image>
-            (rows, cols, stride, shared_frame_.data, bytes, std::get<PG_TO>(pix_map_.at(pix_col_)));
+            (rows, cols, stride, shared_frame_->data, bytes, std::get<PG_TO>(pix_map_.at(pix_col_)));
 
     return true;
 }
@@ -38,7 +38,8 @@ TestFrame::TestFrame(const std::string &sink_address)
 po::options_description TestFrame::options() const
 {
     // Update CLI options
-    po::options_description local_opts;
+    // Start with base options
+    po::options_description local_opts(baseOptions());
     local_opts.add_options()
         ("test-image,f", po::value<std::string>(),
          "Path to test image used as frame source.")
@@ -46,7 +47,12 @@ po::options_description TestFrame::options() const
          "Pixel color format. Defaults to BGR.\n"
          "Values:\n"
          "  GREY: \t 8-bit Greyscale image.\n"
-         "  BGR: \t8-bit, 3-chanel, BGR Color image.\n")
+         "  BGR: \t8-bit, 3-chanel, BGR Color image.\n"
+         "  BAYER_RG, BAYER_GB, BAYER_GR, BAYER_BG: \t8-bit raw Bayer "
+         "mosaic, for images that hold a raw frame as greyscale. Use "
+         "oat-framefilt debayer to demosaic them.\n"
+         "  GREY12, GREY16: \t12 or 16-bit greyscale image, e.g. a 16-bit "
+         "PNG or TIFF.\n")
         ("fps,r", po::value<double>(),
          "Frames to serve per second.")
         ("num-frames,n", po::value<uint64_t>(),
@@ -76,45 +82,52 @@ void TestFrame::applyConfiguration(const po::variables_map &vm,
     // Frame rate
     if (oat::config::getNumericValue(vm, config_table, "fps", frames_per_second_, 0.0))
         calculateFramePeriod();
+
+    // Shared frame sink
+    applyBaseConfiguration(vm, config_table);
 }
 
 bool TestFrame::connectToNode() {
 
-    auto mat = cv::imread(file_name_, oat::imread_code(color_));
+    image_ = cv::imread(file_name_, oat::imread_code(color_));
 
-    if (mat.data == NULL)
+    if (image_.data == NULL)
         throw (std::runtime_error("File \"" + file_name_ + "\" could not be read."));
 
+    // Deep images are loaded with their own depth
+    if (image_.type() != oat::cv_type(color_))
+        throw (std::runtime_error("File \"" + file_name_ + "\" does not hold "
+                                  + oat::color_str(color_) + " pixels."));
+
     frame_sink_.bind(frame_sink_address_,
-            mat.total() * mat.elemSize());
+            image_.total() * image_.elemSize(),
+            ring_depth_);
 
     shared_frame_ = frame_sink_.retrieve(
-            mat.rows, mat.cols, mat.type(), color_);
-
-    // Static image, never changes
-    mat.copyTo(shared_frame_);
+            image_.rows, image_.cols, image_.type(), color_);
 
     // Put the sample rate in the shared frame
-    shared_frame_.set_rate_hz(1.0 / frame_period_in_sec_.count());
+    shared_frame_->set_rate_hz(1.0 / frame_period_in_sec_.count());
 
     return true;
 }
 
 int TestFrame::process()
 {
-    if (shared_frame_.sample_count() < num_samples_) {
+    if (shared_frame_->sample_count() < num_samples_) {
 
         // START CRITICAL SECTION //
         ////////////////////////////
 
         // Wait for sources to read
-        frame_sink_.wait();
+        oat::Frame * frame = frame_sink_.acquire();
 
-        // Zero frame copy
-        shared_frame_.incrementSampleCount();
+        // Static image, never changes. Copy only once into each ring slot.
+        if (frame->sample_count() < frame_sink_.ring_depth())
+            image_.copyTo(*frame);
 
         // Tell sources there is new data
-        frame_sink_.post();
+        frame_sink_.commit();
 
         ////////////////////////////
         //  END CRITICAL SECTION  //
@@ -38,7 +38,8 @@ WebCam::WebCam(const std::string &sink_name)
 po::options_description WebCam::options() const
 {
     // Update CLI options
-    po::options_description local_opts;
+    // Start with base options
+    po::options_description local_opts(baseOptions());
     local_opts.add_options()
         ("index,i", po::value<int>(),
          "Camera index. Useful in multi-camera imaging "
@@ -84,6 +85,9 @@ void WebCam::applyConfiguration(const po::variables_map &vm,
         region_of_interest_.width  = roi[2];
         region_of_interest_.height = roi[3];
     }
+
+    // Shared frame sink
+    applyBaseConfiguration(vm, config_table);
 }
 
 bool WebCam::connectToNode()
@@ -95,54 +99,51 @@ bool WebCam::connectToNode()
         example_frame = example_frame(region_of_interest_);
 
     frame_sink_.bind(frame_sink_address_,
-                     example_frame.total() * oat::color_bytes(oat::PIX_BGR));
+                     example_frame.total() * oat::color_bytes(oat::PIX_BGR),
+                     ring_depth_);
 
     shared_frame_ = frame_sink_.retrieve(
         example_frame.rows, example_frame.cols, example_frame.type(), oat::PIX_BGR);
 
     // Put the sample rate in the shared mat
-    shared_frame_.set_rate_hz(cv_camera_->get(cv::CAP_PROP_FPS));
+    shared_frame_->set_rate_hz(cv_camera_->get(cv::CAP_PROP_FPS));
 
     return true;
 }
 
 int WebCam::process()
 {
-    // Frame decoding (if compression was performed) can be
-    // computationally expensive. So do this outside the critical section
-    cv::Mat mat;
-    if (!cv_camera_->read(mat)) 
+    // Wait for the camera and decode before taking a ring slot, so that the
+    // slot is not held for the whole frame period and is never left acquired
+    // when the camera fails
+    if (!cv_camera_->read(decoded_))
         return 1;
 
-    if (use_roi_ )
-        mat = mat(region_of_interest_);
-
-    if (first_frame_) 
-        start_ = clock_.now();
-
     // START CRITICAL SECTION //
     ////////////////////////////
-    
+
     // Wait for sources to read
-    frame_sink_.wait();
+    oat::Frame * frame = frame_sink_.acquire();
+
+    if (use_roi_)
+        decoded_(region_of_interest_).copyTo(*frame);
+    else
+        decoded_.copyTo(*frame);
 
     // Pure SINKs increment sample count
     // NOTE: webcams have poorly controlled sample period, so it must be
     // calculated. This operation is very inexpensive
     if (first_frame_) {
-        first_frame_ = false; 
+        start_ = clock_.now();
+        first_frame_ = false;
+        frame_sink_.commit(frame->sample());
     } else {
         auto time_since_start
             = std::chrono::duration_cast<Sample::Microseconds>(clock_.now()
                                                                - start_);
-        shared_frame_.incrementSampleCount(time_since_start);
+        frame_sink_.commit(time_since_start);
     }
 
-    mat.copyTo(shared_frame_);
-
-    // Tell sources there is new data
-    frame_sink_.post();
-
     ////////////////////////////
     //  END CRITICAL SECTION  //
 
@@ -50,6 +50,9 @@ private:
     int index_ {0};
     std::unique_ptr<cv::VideoCapture> cv_camera_;
 
+    // Most recently decoded frame, before it is copied to the frame sink
+    cv::Mat decoded_;
+
     // frame generation clock
     bool first_frame_ {true};
     std::chrono::steady_clock clock_;
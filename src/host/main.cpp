@@ -0,0 +1,375 @@
+//******************************************************************************
+//* File:   oat host main.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//****************************************************************************
+
+#include <csignal>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/program_options.hpp>
+#include <cpptoml.h>
+#include <opencv2/core.hpp>
+#include <zmq.hpp>
+
+#include "../../lib/base/Component.h"
+#include "../../lib/shmemdf/Interrupt.h"
+#include "../../lib/shmemdf/NodeSegment.h"
+#include "../../lib/utility/IOFormat.h"
+#include "../../lib/utility/ProgramOptions.h"
+
+#include "../decorator/Decorator.h"
+#include "../framefilter/BackgroundSubtractor.h"
+#include "../framefilter/BackgroundSubtractorMOG.h"
+#include "../framefilter/ColorConvert.h"
+#include "../framefilter/FrameMasker.h"
+#include "../framefilter/Threshold.h"
+#include "../framefilter/Undistorter.h"
+#include "../frameserver/FileReader.h"
+#include "../frameserver/TestFrame.h"
+#include "../frameserver/WebCam.h"
+#include "../positioncombiner/MeanPosition.h"
+#include "../positiondetector/DifferenceDetector.h"
+#include "../positiondetector/HSVDetector.h"
+#include "../positiondetector/SimpleThreshold.h"
+#include "../positionfilter/HomographyTransform2D.h"
+#include "../positionfilter/KalmanFilter2D.h"
+#include "../positionfilter/RegionFilter2D.h"
+#include "../recorder/Recorder.h"
+
+namespace po = boost::program_options;
+
+const char usage_graph[] =
+    "GRAPH:\n"
+    "  TOML file describing the components to run. Each [[component]] "
+    "entry has\n"
+    "  a 'program' (e.g. 'framefilt') and the 'args' that would be passed "
+    "to it on\n"
+    "  the command line. Its optional 'config' key names a table in GRAPH "
+    "that\n"
+    "  configures it, like --config GRAPH KEY. The optional top-level "
+    "'local'\n"
+    "  array lists nodes that are held in this process's memory instead of "
+    "shared\n"
+    "  memory. Only components of this host can use local nodes. All other "
+    "nodes\n"
+    "  remain available to other Oat processes.\n\n"
+    "  local = [\"raw\", \"filt\"]\n\n"
+    "  [[component]]\n"
+    "  program = \"frameserve\"\n"
+    "  args = [\"wcam\", \"raw\"]\n\n"
+    "  [[component]]\n"
+    "  program = \"framefilt\"\n"
+    "  args = [\"mog\", \"raw\", \"filt\"]\n"
+    "  config = \"mog\"\n\n"
+    "  [mog]\n"
+    "  adaptation-coeff = 0.01\n\n"
+    "PROGRAMS:\n"
+    "  frameserve (wcam, file, test), framefilt, posidet, posifilt, "
+    "posicom,\n"
+    "  decorate, record";
+
+// A component built by this host and the functions needed to configure it
+struct Hosted {
+    std::shared_ptr<oat::Component> component;
+    std::function<void(po::options_description &)> append_options;
+    std::function<void(const po::variables_map &)> configure;
+};
+
+template <typename C>
+Hosted host(std::shared_ptr<C> c)
+{
+    return {c,
+            [c](po::options_description &o) { c->appendOptions(o); },
+            [c](const po::variables_map &vm) { c->configure(vm); }};
+}
+
+void printUsage(const po::options_description &options)
+{
+    std::cout << "Usage: host [INFO]\n"
+              << "   or: host GRAPH\n"
+              << "Run several components as threads of a single process.\n\n"
+              << options << "\n"
+              << usage_graph << "\n";
+}
+
+// Remove the first n arguments, which must be present
+std::vector<std::string> positional(const std::string &program,
+                                    std::vector<std::string> &args,
+                                    const size_t n)
+{
+    if (args.size() < n)
+        throw std::runtime_error(program + " requires " + std::to_string(n)
+                                 + " positional arguments.");
+
+    std::vector<std::string> pos(args.begin(), args.begin() + n);
+    args.erase(args.begin(), args.begin() + n);
+    return pos;
+}
+
+// Construct a component in the same way as its program's main()
+Hosted makeComponent(const std::string &program, std::vector<std::string> &args)
+{
+    if (program == "frameserve") {
+
+        auto p = positional(program, args, 2);
+        if (p[0] == "wcam")
+            return host(std::make_shared<oat::WebCam>(p[1]));
+        if (p[0] == "file")
+            return host(std::make_shared<oat::FileReader>(p[1]));
+        if (p[0] == "test")
+            return host(std::make_shared<oat::TestFrame>(p[1]));
+
+    } else if (program == "framefilt") {
+
+        auto p = positional(program, args, 3);
+        if (p[0] == "bsub")
+            return host(std::make_shared<oat::BackgroundSubtractor>(p[1], p[2]));
+        if (p[0] == "mask")
+            return host(std::make_shared<oat::FrameMasker>(p[1], p[2]));
+        if (p[0] == "mog")
+            return host(std::make_shared<oat::BackgroundSubtractorMOG>(p[1], p[2]));
+        if (p[0] == "undistort")
+            return host(std::make_shared<oat::Undistorter>(p[1], p[2]));
+        if (p[0] == "col")
+            return host(std::make_shared<oat::ColorConvert>(p[1], p[2]));
+        if (p[0] == "thresh")
+            return host(std::make_shared<oat::Threshold>(p[1], p[2]));
+
+    } else if (program == "posidet") {
+
+        auto p = positional(program, args, 3);
+        if (p[0] == "diff")
+            return host(std::make_shared<oat::DifferenceDetector>(p[1], p[2]));
+        if (p[0] == "hsv")
+            return host(std::make_shared<oat::HSVDetector>(p[1], p[2]));
+        if (p[0] == "thresh")
+            return host(std::make_shared<oat::SimpleThreshold>(p[1], p[2]));
+
+    } else if (program == "posifilt") {
+
+        auto p = positional(program, args, 3);
+        if (p[0] == "kalman")
+            return host(std::make_shared<oat::KalmanFilter2D>(p[1], p[2]));
+        if (p[0] == "homography")
+            return host(std::make_shared<oat::HomographyTransform2D>(p[1], p[2]));
+        if (p[0] == "region")
+            return host(std::make_shared<oat::RegionFilter2D>(p[1], p[2]));
+
+    } else if (program == "posicom") {
+
+        auto p = positional(program, args, 1);
+        if (p[0] == "mean")
+            return host(std::make_shared<oat::MeanPosition>());
+
+    } else if (program == "decorate") {
+
+        auto p = positional(program, args, 2);
+        return host(std::make_shared<oat::Decorator>(p[0], p[1]));
+
+    } else if (program == "record") {
+
+        return host(std::make_shared<oat::Recorder>());
+
+    } else {
+        throw std::runtime_error("Program '" + program
+                                 + "' cannot be hosted.");
+    }
+
+    throw std::runtime_error("Invalid TYPE specified for " + program + ".");
+}
+
+// Processing loop of a single component. Any error stops the whole graph.
+void runHosted(std::shared_ptr<oat::Component> component)
+{
+    const std::string comp_name = component->name();
+
+    try {
+
+        component->run();
+        std::cout << oat::whoMessage(comp_name, "Exiting.\n");
+        return;
+
+    } catch (const cpptoml::parse_exception &ex) {
+        std::cerr << oat::whoError(comp_name + "(TOML) ", ex.what()) << std::endl;
+    } catch (const cv::Exception &ex) {
+        std::cerr << oat::whoError(comp_name + "(OPENCV) ", ex.what()) << std::endl;
+    } catch (const boost::interprocess::interprocess_exception &ex) {
+        std::cerr << oat::whoError(comp_name + "(SHMEM) ", ex.what()) << std::endl;
+    } catch (const zmq::error_t &ex) {
+        if (ex.num() != EINTR)
+            std::cerr << oat::whoError(comp_name + "(ZMQ) " , ex.what()) << std::endl;
+    } catch (const std::runtime_error &ex) {
+        std::cerr << oat::whoError(comp_name, ex.what()) << std::endl;
+    } catch (...) {
+        std::cerr << oat::whoError(comp_name, "Unknown exception.")
+                  << std::endl;
+    }
+
+    oat::quit = 1;
+    oat::interruptWaits();
+}
+
+int main(int argc, char *argv[])
+{
+    std::string comp_name = "host";
+    std::string graph_file;
+    std::vector<Hosted> hosted;
+
+    po::options_description options;
+
+    try {
+
+        options.add(oat::config::ComponentInfo::instance()->get());
+
+        po::options_description hidden("HIDDEN OPTIONS");
+        hidden.add_options()
+            ("graph", po::value<std::string>(&graph_file),
+             "Graph description file.")
+            ;
+
+        po::positional_options_description positional_options;
+        positional_options.add("graph", 1);
+
+        po::options_description all_options;
+        all_options.add(options).add(hidden);
+
+        po::variables_map option_map;
+        po::store(po::command_line_parser(argc, argv)
+                  .options(all_options)
+                  .positional(positional_options)
+                  .run(),
+                  option_map);
+        po::notify(option_map);
+
+        if (option_map.count("help")) {
+            printUsage(options);
+            return 0;
+        }
+
+        if (option_map.count("version")) {
+            std::cout << oat::config::VERSION_STRING;
+            return 0;
+        }
+
+        if (!option_map.count("graph")) {
+            printUsage(options);
+            std::cerr << oat::Error("A GRAPH must be specified.\n");
+            return -1;
+        }
+
+        auto graph = cpptoml::parse_file(graph_file);
+
+        // Local nodes must be declared before any component uses them
+        if (graph->contains("local")) {
+            auto local = graph->get_array_of<std::string>("local");
+            if (!local)
+                throw std::runtime_error("'local' must be an array of node "
+                                         "names.");
+            for (const auto &address : *local)
+                oat::makeNodeLocal(address);
+        }
+
+        auto components = graph->get_table_array("component");
+        if (!components)
+            throw std::runtime_error("GRAPH does not contain any "
+                                     "[[component]] entries.");
+
+        for (const auto &entry : *components) {
+
+            auto program = entry->get_as<std::string>("program");
+            if (!program)
+                throw std::runtime_error("Each [[component]] requires a "
+                                         "'program'.");
+            comp_name = *program;
+
+            std::vector<std::string> args;
+            if (entry->contains("args")) {
+                auto a = entry->get_array_of<std::string>("args");
+                if (!a)
+                    throw std::runtime_error("'args' must be an array of "
+                                             "strings.");
+                args = *a;
+            }
+
+            auto h = makeComponent(*program, args);
+            comp_name = h.component->name();
+
+            // The remaining arguments are the component's CONFIGURATION
+            if (entry->contains("config")) {
+                auto key = entry->get_as<std::string>("config");
+                if (!key)
+                    throw std::runtime_error("'config' must name a table in "
+                                             "GRAPH.");
+                args.insert(args.end(), {"--config", graph_file, *key});
+            }
+
+            po::options_description detail_opts {"CONFIGURATION"};
+            h.append_options(detail_opts);
+
+            po::variables_map comp_map;
+            po::store(po::command_line_parser(args)
+                      .options(detail_opts)
+                      .run(), comp_map);
+            po::notify(comp_map);
+
+            h.configure(comp_map);
+            hosted.push_back(std::move(h));
+        }
+
+    } catch (const po::error &ex) {
+        std::cerr << oat::whoError(comp_name, ex.what()) << std::endl;
+        return -1;
+    } catch (const cpptoml::parse_exception &ex) {
+        std::cerr << oat::whoError(comp_name + "(TOML) ", ex.what()) << std::endl;
+        return -1;
+    } catch (const cv::Exception &ex) {
+        std::cerr << oat::whoError(comp_name + "(OPENCV) ", ex.what()) << std::endl;
+        return -1;
+    } catch (const std::runtime_error &ex) {
+        std::cerr << oat::whoError(comp_name, ex.what()) << std::endl;
+        return -1;
+    } catch (...) {
+        std::cerr << oat::whoError(comp_name, "Unknown exception.")
+                  << std::endl;
+        return -1;
+    }
+
+    std::cout << oat::whoMessage("host",
+                 "Running " + std::to_string(hosted.size())
+                 + " components. Press CTRL+C to exit.\n");
+
+    // Each component runs on its own thread. Sinks and sources connect in
+    // any order, as they would in separate processes.
+    std::vector<std::thread> threads;
+    for (auto &h : hosted)
+        threads.emplace_back(runHosted, h.component);
+
+    for (auto &t : threads)
+        t.join();
+
+    // Components must release their nodes before local memory goes away
+    hosted.clear();
+
+    std::cout << oat::whoMessage("host", "Exiting.\n");
+    return 0;
+}
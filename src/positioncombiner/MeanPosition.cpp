@@ -41,6 +41,8 @@ po::options_description MeanPosition::options() const
          "unspecified, the heading is not calculated.")
         ;
 
+    local_opts.add(oat::config::syncOptions());
+
     return local_opts;
 }
 
@@ -49,7 +51,7 @@ void MeanPosition::applyConfiguration(const po::variables_map &vm,
 {
     // Setup sources and sink
     // TODO: Code smell -- this is required to get a source and sink list
-    PositionCombiner::resolvePositionSources(vm);
+    PositionCombiner::resolvePositionSources(vm, config_table);
 
     // Adaptation coefficient
     generate_heading_ = oat::config::getNumericValue<int>(
@@ -34,7 +34,8 @@
 
 namespace oat {
 
-void PositionCombiner::resolvePositionSources(const po::variables_map &vm)
+void PositionCombiner::resolvePositionSources(
+    const po::variables_map &vm, const config::OptionTable &config_table)
 {
     // Pull the sources and sink out as positional options
     auto sources = vm["sources-and-sink"].as< std::vector<std::string> >();
@@ -50,8 +51,7 @@ void PositionCombiner::resolvePositionSources(const po::variables_map &vm)
 
     for (auto &addr : sources) {
 
-        oat::Position2D pos(addr);
-        positions_.push_back(std::move(pos));
+        positions_.push_back(oat::Position2D());
         position_sources_.push_back(
             oat::NamedSource<oat::Position2D>(
                 addr,
@@ -59,6 +59,8 @@ void PositionCombiner::resolvePositionSources(const po::variables_map &vm)
             )
         );
     }
+
+    sync_config_ = getSyncConfig(vm, config_table);
 }
 
 bool PositionCombiner::connectToNode()
@@ -81,8 +83,24 @@ bool PositionCombiner::connectToNode()
     if (!oat::checkSamplePeriods(all_ts, sample_rate_hz))
         std::cerr << oat::Warn(oat::inconsistentSampleRateWarning(sample_rate_hz));
 
+    for (auto &ps : position_sources_)
+        sync_sources_.push_back(ps.source.get());
+
+    if (sync_config_.key != oat::SyncKey::NONE) {
+        sync_ = oat::make_unique<oat::SampleSynchronizer>(
+            position_sources_.size(), sync_config_);
+        for (const auto &p : positions_)
+            held_.emplace_back(sync_->window(), p);
+    }
+
+    // Combined positions are in the units of the first source
+    oat::PositionMetadata meta(position_sink_address_);
+    if (auto m = position_sources_[0].source->metadata<oat::PositionMetadata>())
+        meta.homography = m->homography;
+
     // Bind to sink node and create a shared position
-    position_sink_.bind(position_sink_address_, position_sink_address_);
+    position_sink_.set_metadata(meta);
+    position_sink_.bind(position_sink_address_);
     shared_position_ = position_sink_.retrieve();
 
     return true;
@@ -90,18 +108,39 @@ bool PositionCombiner::connectToNode()
 
 int PositionCombiner::process()
 {
-    for (pvec_size_t i = 0; i != position_sources_.size(); i++) {
+    if (sync_) {
 
-        // START CRITICAL SECTION //
-        ////////////////////////////
-        if (position_sources_[i].source->wait() == oat::NodeState::END)
-            return 1;
+        // Read sources until there is a tuple of matching positions
+        while (!sync_->pop(aligned_)) {
 
-        positions_[i] = position_sources_[i].source->clone();
+            auto state = oat::waitAll(sync_sources_, [this](pvec_size_t i) {
+                auto pos = position_sources_[i].source->clone();
+                const size_t slot = sync_->push(i, pos.sample());
+                if (slot != oat::SampleSynchronizer::NO_SLOT)
+                    held_[i][slot] = std::move(pos);
+            });
 
-        position_sources_[i].source->post();
-        ////////////////////////////
-        //  END CRITICAL SECTION  //
+            if (state == oat::NodeState::END)
+                return 1;
+            else if (quit)
+                return 0;
+        }
+
+        for (pvec_size_t i = 0; i < positions_.size(); i++)
+            positions_[i] = held_[i][aligned_[i]];
+
+        if (sync_->warningDue())
+            std::cerr << oat::Warn(oat::misalignedSourcesWarning(*sync_));
+
+    } else {
+
+        // Each source is posted as soon as its position has been copied
+        auto state = oat::waitAll(sync_sources_, [this](pvec_size_t i) {
+            positions_[i] = position_sources_[i].source->clone();
+        });
+
+        if (state == oat::NodeState::END)
+            return 1;
     }
 
     combine(positions_, internal_position_);
@@ -109,13 +148,15 @@ int PositionCombiner::process()
     // START CRITICAL SECTION //
     ////////////////////////////
 
-    // Wait for sources to read
-    position_sink_.wait();
+    // Wait for sources to read. Nothing is written if the wait was
+    // interrupted.
+    if (position_sink_.wait()) {
 
-    *shared_position_ = internal_position_;
+        *shared_position_ = internal_position_;
 
-    // Tell sources there is new data
-    position_sink_.post();
+        // Tell sources there is new data
+        position_sink_.post();
+    }
 
     ////////////////////////////
     //  END CRITICAL SECTION  //
@@ -56,8 +56,11 @@ protected:
      * @brief Makes a list of position sources from a parsed program options
      * variable map.
      * @param vm Program options variable map containing the position source list.
+     * @param config_table Parsed TOML options table, which may contain the
+     * options from oat::config::syncOptions().
      */
-    void resolvePositionSources(const po::variables_map &vm);
+    void resolvePositionSources(const po::variables_map &vm,
+                                const config::OptionTable &config_table);
 
     /**
      * Perform position combination.
@@ -84,9 +87,17 @@ private:
     // Position SOURCES object for un-combined positions
     std::vector<oat::Position2D> positions_;
     oat::NamedSourceList<oat::Position2D> position_sources_;
+    std::vector<oat::SourceSync *> sync_sources_; //!< Sources for waitAll()
+
+    // Sample alignment. Positions that have yet to be matched are held in
+    // held_[source][slot]. Unused if the sync key is NONE.
+    oat::SyncConfig sync_config_;
+    std::unique_ptr<oat::SampleSynchronizer> sync_;
+    std::vector<std::vector<oat::Position2D>> held_;
+    std::vector<size_t> aligned_;
 
     // Combined position
-    oat::Position2D internal_position_ {"internal"};
+    oat::Position2D internal_position_;
 
     // Position SINK object for publishing combined position
     oat::Position2D * shared_position_ {nullptr};
@@ -17,19 +17,22 @@
 //* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
 //****************************************************************************
 
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <opencv2/core/mat.hpp>
 #include <opencv2/imgproc.hpp>
 
 #include "../../lib/datatypes/Position2D.h"
+#include "../../lib/datatypes/PositionList.h"
 
 #include "DetectorFunc.h"
 
 namespace oat {
 
 void siftContours(cv::Mat &frame,
-                  Position2D &position,
+                  PositionList &positions,
+                  size_t max_objects,
                   double &area,
                   double min_area,
                   double max_area)
@@ -42,27 +45,35 @@ void siftContours(cv::Mat &frame,
                      cv::RETR_EXTERNAL, 
                      cv::CHAIN_APPROX_SIMPLE);
 
-    double object_area = 0;
-    position.position_valid = false;
+    // Centroids and areas of contours within the min/max range
+    struct Blob { double area; oat::Point2D centroid; };
+    std::vector<Blob> blobs;
 
     for (auto &c : contours) {
 
         cv::Moments moment = cv::moments(static_cast<cv::Mat>(c));
         double countour_area = moment.m00;
 
-        // Isolate the largest contour within the min/max range.
-        if (countour_area >= min_area &&
-            countour_area < max_area &&
-            countour_area > object_area) {
+        if (countour_area >= min_area && countour_area < max_area)
+            blobs.push_back({countour_area,
+                             oat::Point2D(moment.m10 / countour_area,
+                                          moment.m01 / countour_area)});
+    }
+
+    // Isolate the largest contours
+    const size_t n = std::min(max_objects, blobs.size());
+    std::partial_sort(blobs.begin(), blobs.begin() + n, blobs.end(),
+                      [](const Blob &a, const Blob &b) { return a.area > b.area; });
 
-            position.position.x = moment.m10 / countour_area;
-            position.position.y = moment.m01 / countour_area;
-            position.position_valid = true;
-            object_area = countour_area;
-        }
+    positions.clear();
+    for (size_t i = 0; i < n; i++) {
+        oat::Position2D p;
+        p.position = blobs[i].centroid;
+        p.position_valid = true;
+        positions.push_back(p, i);
     }
 
-    area = object_area;
+    area = n > 0 ? blobs[0].area : 0;
 }
 
 } /* namespace oat */
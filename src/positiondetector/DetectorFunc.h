@@ -20,6 +20,8 @@
 #ifndef OAT_DETECTORFUNC
 #define	OAT_DETECTORFUNC
 
+#include <cstddef>
+
 // Forward decl.
 namespace cv { class Mat; }
 
@@ -29,19 +31,22 @@ namespace oat {
 static constexpr double PI {3.14159265358979323846};
 
 // Forward decl.
-class Position2D;
+class PositionList;
 
 /**
- * Given a binary frame, find all contours and return a position corresponding
- * to the centroid of the largest one.
+ * Given a binary frame, find all contours and return positions corresponding
+ * to the centroids of the largest ones.
  * @param frame_in Frame to look for positions in.
- * @param position Position output
+ * @param positions Position output, in order of decreasing contour area. The
+ * id of each position is its rank. Empty if no contour is in range.
+ * @param max_objects Maximum number of positions to return
+ * @param object_area Area of the largest contour in range
  * @param min_area Minimum contour area to be considered candidate for position
  * @param max_area Maximum contour area to be considered candidate for position
- * @return Position corresponding the centroid of the largest contour in the frame.
  */
 void siftContours(cv::Mat &frame,
-                  Position2D &position,
+                  PositionList &positions,
+                  size_t max_objects,
                   double &object_area,
                   double min_area,
                   double max_area);
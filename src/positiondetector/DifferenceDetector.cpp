@@ -26,6 +26,7 @@
 #include <cpptoml.h>
 
 #include "../../lib/datatypes/Position2D.h"
+#include "../../lib/datatypes/PositionList.h"
 #include "../../lib/utility/IOFormat.h"
 #include "../../lib/utility/TOMLSanitize.h"
 
@@ -46,7 +47,7 @@ DifferenceDetector::DifferenceDetector(const std::string &frame_source_address,
 
 po::options_description DifferenceDetector::options() const
 {
-    po::options_description local_opts;
+    po::options_description local_opts(baseOptions());
     local_opts.add_options()
         ("diff-threshold,d", po::value<int>(),
          "Intensity difference threshold to consider an object contour.")
@@ -66,6 +67,8 @@ po::options_description DifferenceDetector::options() const
 void DifferenceDetector::applyConfiguration(
     const po::variables_map &vm, const config::OptionTable &config_table)
 {
+    applyBaseConfiguration(vm, config_table);
+
     // Difference threshold
     oat::config::getNumericValue<int>(
         vm, config_table, "diff-threshold", difference_intensity_threshold_, 0
@@ -96,7 +99,7 @@ void DifferenceDetector::applyConfiguration(
 }
 
 void DifferenceDetector::detectPosition(cv::Mat &frame,
-                                        oat::Position2D &position)
+                                        oat::PositionList &positions)
 {
     if (tuning_on_)
         tune_frame_ = frame.clone();
@@ -109,24 +112,27 @@ void DifferenceDetector::detectPosition(cv::Mat &frame,
          tune_frame_.setTo(0, threshold_frame_ == 0);
 
     siftContours(threshold_frame_,
-                 position,
+                 positions,
+                 max_objects_,
                  object_area_,
                  min_object_area_,
                  max_object_area_);
 
     if (tuning_on_)
-        tune(tune_frame_, position);
+        tune(tune_frame_, positions);
 }
 
-void DifferenceDetector::tune(cv::Mat &frame, const oat::Position2D &position) {
+void DifferenceDetector::tune(cv::Mat &frame, const oat::PositionList &positions) {
 
     if (!tuning_windows_created_)
         createTuningWindows();
 
     std::string msg = cv::format("Object not found");
 
-    // Plot a circle representing found object
-    if (position.position_valid) {
+    // Plot a circle representing each found object
+    for (size_t i = 0; i < positions.size(); i++) {
+
+        const oat::Position2D &position = positions[i];
 
         // TODO: object_area_ is not set, so this will be 0!
         auto radius = std::sqrt(object_area_ / PI);
@@ -27,7 +27,7 @@
 namespace oat {
 
 // Forward decl.
-class Position2D;
+class PositionList;
 
 // Tuning GUI callbacks
 void diffDetectorBlurSliderChangedCallback(int value, void *);
@@ -55,7 +55,7 @@ private:
     void applyConfiguration(const po::variables_map &vm,
                             const config::OptionTable &config_table) override;
 
-    void detectPosition(cv::Mat &frame, oat::Position2D &position) override;
+    void detectPosition(cv::Mat &frame, oat::PositionList &positions) override;
 
     // Intermediate variables
     cv::Mat this_image_, last_image_;
@@ -84,7 +84,7 @@ private:
     bool tuning_on_ {false};
     bool tuning_windows_created_ {false};
     void createTuningWindows(void);
-    void tune(cv::Mat &frame, const oat::Position2D &position);
+    void tune(cv::Mat &frame, const oat::PositionList &positions);
     void applyThreshold(cv::Mat &frame);
 };
 
@@ -26,7 +26,10 @@
 #include <cpptoml.h>
 
 #include "../../lib/datatypes/Position2D.h"
+#include "../../lib/datatypes/PositionList.h"
 #include "../../lib/utility/IOFormat.h"
+#include "../../lib/utility/ProgramOptions.h"
+#include "../../lib/utility/Stripes.h"
 #include "../../lib/utility/TOMLSanitize.h"
 
 namespace oat {
@@ -49,7 +52,7 @@ HSVDetector::HSVDetector(const std::string &frame_source_address,
 po::options_description HSVDetector::options() const
 {
     // Update CLI options
-    po::options_description local_opts;
+    po::options_description local_opts(baseOptions());
     local_opts.add_options()
         ("h-thresh,H", po::value<std::string>(),
          "Array of ints between 0 and 256, [min,max], specifying the hue "
@@ -70,6 +73,7 @@ po::options_description HSVDetector::options() const
         ("tune,t",
          "If true, provide a GUI with sliders for tuning detection parameters.")
         ;
+    local_opts.add(oat::config::stripeOptions());
 
     return local_opts;
 }
@@ -77,6 +81,8 @@ po::options_description HSVDetector::options() const
 void HSVDetector::applyConfiguration(const po::variables_map &vm,
                                      const config::OptionTable &config_table)
 {
+    applyBaseConfiguration(vm, config_table);
+
     // Hue
     std::vector<int> h;
     if (oat::config::getArray<int, 2>(vm, config_table, "h-thresh", h)) {
@@ -137,50 +143,68 @@ void HSVDetector::applyConfiguration(const po::variables_map &vm,
 
     // Tuning GUI
     oat::config::getValue<bool>(vm, config_table, "tune", tuning_on_);
+
+    // Stripes
+    oat::config::getNumericValue<int>(
+        vm, config_table, "stripes", stripes_, 1, 256);
 }
 
-void HSVDetector::detectPosition(cv::Mat &frame, oat::Position2D &position)
+void HSVDetector::detectPosition(cv::Mat &frame, oat::PositionList &positions)
 {
     // Threshold HSV channels
     // (Very expensive operation)
-    cv::inRange(frame,
-                cv::Scalar(h_min_, s_min_, v_min_),
-                cv::Scalar(h_max_, s_max_, v_max_),
-                threshold_frame_);
-
-    // Filter the resulting threshold image
-    if (erode_on_)
-        cv::erode(threshold_frame_, threshold_frame_, erode_element_);
+    threshold_frame_.create(frame.size(), CV_8UC1);
+    oat::forEachStripe(frame.rows, stripes_, [&](const cv::Range &r) {
+        cv::Mat out = threshold_frame_.rowRange(r);
+        cv::inRange(frame.rowRange(r),
+                    cv::Scalar(h_min_, s_min_, v_min_),
+                    cv::Scalar(h_max_, s_max_, v_max_),
+                    out);
+    });
+
+    // Filter the resulting threshold image. Each pass reads the whole
+    // result of the previous one, so they alternate between two frames.
+    if (erode_on_) {
+        oat::stripedMorphology(cv::MORPH_ERODE, threshold_frame_,
+                               morphology_frame_, erode_element_, stripes_);
+        cv::swap(threshold_frame_, morphology_frame_);
+    }
 
-    if (dilate_on_)
-        cv::dilate(threshold_frame_, threshold_frame_, dilate_element_);
+    if (dilate_on_) {
+        oat::stripedMorphology(cv::MORPH_DILATE, threshold_frame_,
+                               morphology_frame_, dilate_element_, stripes_);
+        cv::swap(threshold_frame_, morphology_frame_);
+    }
 
     // Threshold frame will be destroyed by the transform below, so we need to use
     // it to form the frame that will be shown in the tuning window here
     if (tuning_on_)
         frame.setTo(0, threshold_frame_ == 0).clone();
 
-    // Find the largest contour in the threshold image
+    // Find the largest contours in the threshold image
     siftContours(threshold_frame_,
-                 position,
+                 positions,
+                 max_objects_,
                  object_area_,
                  min_object_area_,
                  max_object_area_);
 
     // Use the GUI tuner if requested
     if (tuning_on_)
-        tune(frame, position);
+        tune(frame, positions);
 }
 
-void HSVDetector::tune(cv::Mat &frame, const oat::Position2D &position)
+void HSVDetector::tune(cv::Mat &frame, const oat::PositionList &positions)
 {
     if (!tuning_windows_created_)
         createTuningWindows();
 
     std::string msg = cv::format("Object not found");
 
-    // Plot a circle representing found object
-    if (position.position_valid) {
+    // Plot a circle representing each found object
+    for (size_t i = 0; i < positions.size(); i++) {
+
+        const oat::Position2D &position = positions[i];
         auto radius = std::sqrt(object_area_ / PI);
         cv::Point center;
         center.x = position.position.x;
@@ -36,7 +36,7 @@
 
 namespace oat {
 
-class Position2D;
+class PositionList;
 
 // Tuning GUI callbacks
 void hsvDetectorMinAreaSliderChangedCallback(int value, void *);
@@ -71,7 +71,10 @@ private:
      * @param Frame to look for object within.
      * @param position Detected object position.
      */
-    void detectPosition(cv::Mat &frame, oat::Position2D &position) override;
+    void detectPosition(cv::Mat &frame, oat::PositionList &positions) override;
+
+    // The tuning GUI draws on the frame
+    bool detectsInPlace(void) const override { return !tuning_on_; }
 
     // Erode and dilate kernels
     int erode_px_ {0}, dilate_px_ {10};
@@ -80,7 +83,10 @@ private:
     void set_dilate_size(int dilate_px);
 
     // Internal matricies
-    cv::Mat threshold_frame_, erode_element_, dilate_element_;
+    cv::Mat threshold_frame_, morphology_frame_, erode_element_, dilate_element_;
+
+    // Number of stripes each frame is split into
+    int stripes_ {1};
 
     // HSV threshold values
     int h_min_ {0}, h_max_ {256};
@@ -97,7 +103,7 @@ private:
     bool tuning_on_ {false};
     bool tuning_windows_created_ {false};
     const std::string tuning_image_title_;
-    void tune(cv::Mat &frame, const oat::Position2D &position);
+    void tune(cv::Mat &frame, const oat::PositionList &positions);
     void createTuningWindows(void);
 };
 
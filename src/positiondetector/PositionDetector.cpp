@@ -21,8 +21,10 @@
 #include <opencv2/core/mat.hpp>
 
 #include "../../lib/datatypes/Position2D.h"
+#include "../../lib/datatypes/PositionList.h"
 #include "../../lib/shmemdf/Source.h"
 #include "../../lib/shmemdf/Sink.h"
+#include "../../lib/utility/TOMLSanitize.h"
 
 #include "PositionDetector.h"
 
@@ -37,6 +39,48 @@ PositionDetector::PositionDetector(const std::string &frame_source_address,
   // Nothing
 }
 
+po::options_description PositionDetector::baseOptions(void) const
+{
+    po::options_description base_opts;
+
+    // Common program options
+    base_opts.add_options()
+        ("backpressure", po::value<std::string>(),
+         "What the detector does when a component has yet to read the "
+         "previous position. Values:\n"
+         "  block: wait for the component.\n"
+         "  drop-newest: discard the new position.\n"
+         "Dropped positions appear as gaps in the sample count. Defaults to "
+         "block.")
+        ("objects", po::value<int>(),
+         "Number of objects to detect in each frame, up to 16. If greater "
+         "than 1, the detector publishes a list of the positions of the "
+         "largest objects, with ids given by their rank, instead of a single "
+         "position. One detector can then track several objects of the same "
+         "appearance in a single pass over each frame. Defaults to 1.")
+        ;
+
+    return base_opts;
+}
+
+void PositionDetector::applyBaseConfiguration(
+    const po::variables_map &vm, const config::OptionTable &config_table)
+{
+    // Slow readers
+    std::string backpressure;
+    if (oat::config::getValue<std::string>(
+            vm, config_table, "backpressure", backpressure)) {
+        position_sink_.set_backpressure(oat::backpressurePolicy(backpressure));
+        list_sink_.set_backpressure(oat::backpressurePolicy(backpressure));
+    }
+
+    // Objects per frame
+    int objects = 1;
+    oat::config::getNumericValue<int>(vm, config_table, "objects", objects,
+                                      1, oat::PositionList::MAX_SIZE);
+    max_objects_ = objects;
+}
+
 bool PositionDetector::connectToNode()
 {
     // Establish our a slot in the node
@@ -46,9 +90,17 @@ bool PositionDetector::connectToNode()
     if (frame_source_.connect(required_color_) != SourceState::CONNECTED)
         return false;
 
-    // Bind to sink node and create a shared position
-    position_sink_.bind(position_sink_address_, position_sink_address_);
-    shared_position_ = position_sink_.retrieve();
+    // Bind to sink node and create a shared position or list
+    const oat::PositionMetadata meta(position_sink_address_);
+    if (max_objects_ > 1) {
+        list_sink_.set_metadata(meta);
+        list_sink_.bind(position_sink_address_);
+        shared_list_ = list_sink_.retrieve();
+    } else {
+        position_sink_.set_metadata(meta);
+        position_sink_.bind(position_sink_address_);
+        shared_position_ = position_sink_.retrieve();
+    }
 
     // TODO: check that the pixel color is correct.
 
@@ -57,39 +109,72 @@ bool PositionDetector::connectToNode()
 
 int PositionDetector::process()
 {
-    oat::Frame internal_frame;
-    oat::Position2D internal_pos("");
+    oat::PositionList internal_list;
 
     // START CRITICAL SECTION //
     ////////////////////////////
-
-    // Wait for sink to write to node
-    if (frame_source_.wait() == oat::NodeState::END)
-        return 1;
-
-    // Clone the shared frame
-    frame_source_.copyTo(internal_frame);
-
-    // Tell sink it can continue
-    frame_source_.post();
-
+    {
+        // Wait for sink to write to node
+        auto lease = frame_source_.borrow();
+        if (lease.node_state() == oat::NodeState::END)
+            return 1;
+
+        // Propagate sample info
+        internal_list.set_sample(lease.frame().sample());
+
+        if (detectsInPlace()) {
+
+            // Detect position directly from shared memory. The sink is held
+            // off until detection is finished.
+            cv::Mat shared_frame = lease.frame();
+            detectPosition(shared_frame, internal_list);
+
+        } else {
+
+            // Copy the shared frame into a reused buffer
+            const oat::Frame &shared_frame = lease.frame();
+            auto internal = frame_pool_.acquire(shared_frame.rows,
+                                                shared_frame.cols,
+                                                shared_frame.type(),
+                                                shared_frame.color());
+            shared_frame.copyTo(internal.frame());
+
+            // Tell sink it can continue
+            lease.release();
+
+            detectPosition(internal.frame(), internal_list);
+        }
+    }
     ////////////////////////////
     //  END CRITICAL SECTION  //
 
-    // Propagate sample info and detect position
-    internal_pos.set_sample(internal_frame.sample());
-    detectPosition(internal_frame, internal_pos);
-
     // START CRITICAL SECTION //
     ////////////////////////////
 
-    // Wait for sources to read
-    position_sink_.wait();
+    // Wait for sources to read. The position is discarded if the
+    // backpressure policy drops it.
+    if (shared_list_ != nullptr) {
+
+        if (list_sink_.wait()) {
+
+            *shared_list_ = internal_list;
+
+            // Tell sources there is new data
+            list_sink_.post();
+        }
+
+    } else if (position_sink_.wait()) {
 
-    *shared_position_ = internal_pos;
+        if (internal_list.empty()) {
+            *shared_position_ = oat::Position2D();
+            shared_position_->set_sample(internal_list.sample());
+        } else {
+            *shared_position_ = internal_list[0];
+        }
 
-    // Tell sources there is new data
-    position_sink_.post();
+        // Tell sources there is new data
+        position_sink_.post();
+    }
 
     ////////////////////////////
     //  END CRITICAL SECTION  //
@@ -29,7 +29,9 @@
 #include "../../lib/base/Component.h"
 #include "../../lib/base/Configurable.h"
 #include "../../lib/datatypes/Frame.h"
+#include "../../lib/datatypes/FramePool.h"
 #include "../../lib/datatypes/Position2D.h"
+#include "../../lib/datatypes/PositionList.h"
 #include "../../lib/shmemdf/Sink.h"
 #include "../../lib/shmemdf/Source.h"
 
@@ -57,12 +59,32 @@ public:
     std::string name(void) const override { return name_; }
 
 protected:
+    /**
+     * @brief Options common to all position detectors.
+     */
+    po::options_description baseOptions(void) const;
+
+    /**
+     * @brief Apply options common to all position detectors.
+     */
+    void applyBaseConfiguration(const po::variables_map &vm,
+                                const config::OptionTable &config_table);
+
     /**
      * Perform object position detection.
-     * @param Frame to look for object within.
-     * @param position Detected object position.
+     * @param Frame to look for objects within.
+     * @param positions Detected object positions, at most max_objects_ of
+     * them. The list's sample is set by the caller.
      */
-    virtual void detectPosition(cv::Mat &frame, oat::Position2D &position) = 0;
+    virtual void detectPosition(cv::Mat &frame, oat::PositionList &positions) = 0;
+
+    /**
+     * Detectors that never write to or keep a reference to the frame passed
+     * to detectPosition() can return true to be handed the frame in shared
+     * memory instead of a private copy.
+     * @return True if detectPosition() only reads its frame.
+     */
+    virtual bool detectsInPlace(void) const { return false; }
 
     // Detector name
     const std::string name_;
@@ -70,6 +92,10 @@ protected:
     // Explicit frame data type
     oat::PixelColor required_color_ {PIX_BGR};
 
+    // Number of objects to detect in each frame. If more than one, a
+    // PositionList is published instead of a Position2D.
+    size_t max_objects_ {1};
+
     // List of allowed configuration options
     //std::vector<std::string> config_keys_;
 
@@ -79,15 +105,20 @@ private:
     int process(void) override;
 
     // Current frame
-    oat::Position2D * shared_position_;
+    oat::Position2D * shared_position_ {nullptr};
+    oat::PositionList * shared_list_ {nullptr};
 
     // Frame source
     const std::string frame_source_address_;
     oat::Source<oat::Frame> frame_source_;
 
+    // Private copies of shared frames
+    oat::FramePool frame_pool_;
+
     // Position sink
     const std::string position_sink_address_;
     oat::Sink<oat::Position2D> position_sink_;
+    oat::Sink<oat::PositionList> list_sink_; //!< Used if max_objects_ > 1
 };
 
 }      /* namespace oat */
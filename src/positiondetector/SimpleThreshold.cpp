@@ -26,6 +26,7 @@
 #include <cpptoml.h>
 
 #include "../../lib/datatypes/Position2D.h"
+#include "../../lib/datatypes/PositionList.h"
 #include "../../lib/utility/IOFormat.h"
 #include "../../lib/utility/TOMLSanitize.h"
 
@@ -49,7 +50,7 @@ SimpleThreshold::SimpleThreshold(const std::string &frame_source_address,
 po::options_description SimpleThreshold::options() const
 {
     // Update CLI options
-    po::options_description local_opts;
+    po::options_description local_opts(baseOptions());
     local_opts.add_options()
         ("thresh,T", po::value<std::string>(),
          "Array of ints between 0 and 256, [min,max], specifying the "
@@ -71,6 +72,8 @@ po::options_description SimpleThreshold::options() const
 void SimpleThreshold::applyConfiguration(
     const po::variables_map &vm, const config::OptionTable &config_table)
 {
+    applyBaseConfiguration(vm, config_table);
+
     // Threshold
     std::vector<int> t;
     if (oat::config::getArray<int, 2>(vm, config_table, "thresh", t)) {
@@ -111,7 +114,7 @@ void SimpleThreshold::applyConfiguration(
     oat::config::getValue<bool>(vm, config_table, "tune", tuning_on_);
 }
 
-void SimpleThreshold::detectPosition(cv::Mat &frame, oat::Position2D &position)
+void SimpleThreshold::detectPosition(cv::Mat &frame, oat::PositionList &positions)
 {
     if (tuning_on_)
         tune_frame_ = frame.clone();
@@ -124,24 +127,27 @@ void SimpleThreshold::detectPosition(cv::Mat &frame, oat::Position2D &position)
          tune_frame_.setTo(0, threshold_frame_ == 0);
 
     siftContours(threshold_frame_,
-                 position,
+                 positions,
+                 max_objects_,
                  object_area_,
                  min_object_area_,
                  max_object_area_);
 
     if (tuning_on_)
-        tune(tune_frame_, position);
+        tune(tune_frame_, positions);
 }
 
-void SimpleThreshold::tune(cv::Mat &frame, const oat::Position2D &position)
+void SimpleThreshold::tune(cv::Mat &frame, const oat::PositionList &positions)
 {
     if (!tuning_windows_created_)
         createTuningWindows();
 
     std::string msg = cv::format("Object not found");
 
-    // Plot a circle representing found object
-    if (position.position_valid) {
+    // Plot a circle representing each found object
+    for (size_t i = 0; i < positions.size(); i++) {
+
+        const oat::Position2D &position = positions[i];
 
         // TODO: object_area_ is not set, so this will be 0!
         auto radius = std::sqrt(object_area_ / PI);
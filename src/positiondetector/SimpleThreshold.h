@@ -27,7 +27,7 @@
 namespace oat {
 
 // Forward decl.
-class Position2D;
+class PositionList;
 
 // Tuning GUI callbacks
 void simpleThresholdMinAreaSliderChangedCallback(int value, void *);
@@ -58,7 +58,8 @@ private:
     void applyConfiguration(const po::variables_map &vm,
                             const config::OptionTable &config_table) override;
 
-    void detectPosition(cv::Mat &frame, oat::Position2D &position) override;
+    void detectPosition(cv::Mat &frame, oat::PositionList &positions) override;
+    bool detectsInPlace(void) const override { return true; }
 
     // Intermediate variables
     cv::Mat threshold_frame_;
@@ -92,7 +93,7 @@ private:
 
     // Processing functions
     void createTuningWindows(void);
-    void tune(cv::Mat &frame, const oat::Position2D &position);
+    void tune(cv::Mat &frame, const oat::PositionList &positions);
     void applyThreshold(cv::Mat &frame);
 };
 
@@ -30,7 +30,7 @@ namespace oat {
 po::options_description HomographyTransform2D::options() const
 {
     // Update CLI options
-    po::options_description local_opts;
+    po::options_description local_opts(baseOptions());
     local_opts.add_options()
         ("homography,H", po::value<std::string>(),
          "A nine-element array of floats, [h11,h12,...,h33], specifying a "
@@ -44,6 +44,8 @@ po::options_description HomographyTransform2D::options() const
 void HomographyTransform2D::applyConfiguration(
     const po::variables_map &vm, const config::OptionTable &config_table)
 {
+    applyBaseConfiguration(vm, config_table);
+
     // Homography
     std::vector<double> H;
     if (oat::config::getArray<double, 9>(vm, config_table, "homography", H)) {
@@ -100,9 +102,15 @@ void HomographyTransform2D::filter(oat::Position2D& position) {
     }
 
     // Update outgoing position's coordinate system
-    position.setCoordSystem(oat::DistanceUnit::WORLD, homography_);
+    position.set_unit_of_length(oat::DistanceUnit::WORLD);
 
     //}
 }
 
+void HomographyTransform2D::filterMetadata(oat::PositionMetadata &metadata)
+{
+    // Incoming positions may already have been projected
+    metadata.homography = homography_ * metadata.homography;
+}
+
 } /* namespace oat */
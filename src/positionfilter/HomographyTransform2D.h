@@ -52,6 +52,13 @@ private:
      * @param Position to be projected
      */
     void filter(oat::Position2D& position) override;
+
+    /**
+     * Publish the homography so that sources can map positions back to
+     * pixels.
+     * @param metadata Metadata of the un-projected positions
+     */
+    void filterMetadata(oat::PositionMetadata &metadata) override;
 };
 
 }      /* namespace oat */
@@ -19,6 +19,8 @@
 
 #include <string>
 
+#include "../../lib/utility/TOMLSanitize.h"
+
 #include "PositionFilter.h"
 
 namespace oat {
@@ -32,24 +34,70 @@ PositionFilter::PositionFilter(const std::string &position_source_address,
   // Nothing
 }
 
+po::options_description PositionFilter::baseOptions(void) const
+{
+    po::options_description base_opts;
+
+    // Common program options
+    base_opts.add_options()
+        ("list",
+         "If set, the SOURCE and SINK hold lists of positions, as published "
+         "by position detectors that detect several objects, and each "
+         "position in a list is filtered.")
+        ;
+
+    return base_opts;
+}
+
+void PositionFilter::applyBaseConfiguration(
+    const po::variables_map &vm, const config::OptionTable &config_table)
+{
+    // Lists
+    oat::config::getValue<bool>(vm, config_table, "list", filter_lists_);
+}
+
 bool PositionFilter::connectToNode()
 {
     // Establish our a slot in the node
-    position_source_.touch(position_source_address_);
+    if (filter_lists_)
+        list_source_.touch(position_source_address_);
+    else
+        position_source_.touch(position_source_address_);
 
     // Wait for synchronous start with sink when it binds the node
-    if (position_source_.connect() != SourceState::CONNECTED)
+    auto rc = filter_lists_ ? list_source_.connect()
+                            : position_source_.connect();
+    if (rc != SourceState::CONNECTED)
         return false;
 
+    // Pass the un-filtered positions' metadata on to the sink
+    oat::PositionMetadata meta(position_sink_address_);
+    auto m = filter_lists_
+        ? list_source_.metadata<oat::PositionMetadata>()
+        : position_source_.metadata<oat::PositionMetadata>();
+    if (m)
+        meta.homography = m->homography;
+    filterMetadata(meta);
+
     // Bind to sink sink node and create a shared position
-    position_sink_.bind(position_sink_address_, position_sink_address_);
-    shared_position_ = position_sink_.retrieve();
+    if (filter_lists_) {
+        list_sink_.set_metadata(meta);
+        list_sink_.bind(position_sink_address_);
+        shared_list_ = list_sink_.retrieve();
+    } else {
+        position_sink_.set_metadata(meta);
+        position_sink_.bind(position_sink_address_);
+        shared_position_ = position_sink_.retrieve();
+    }
 
     return true;
 }
 
 int PositionFilter::process()
 {
+    if (filter_lists_)
+        return processList();
+
     // START CRITICAL SECTION //
     ////////////////////////////
 
@@ -72,13 +120,56 @@ int PositionFilter::process()
     // START CRITICAL SECTION //
     ////////////////////////////
 
-    // Wait for sources to read
-    position_sink_.wait();
+    // Wait for sources to read. Nothing is written if the wait was
+    // interrupted.
+    if (position_sink_.wait()) {
+
+        *shared_position_ = internal_position_;
+
+        // Tell sources there is new data
+        position_sink_.post();
+    }
+
+    ////////////////////////////
+    //  END CRITICAL SECTION  //
+
+    // Sink was not at END state
+    return 0;
+}
+
+int PositionFilter::processList()
+{
+    // START CRITICAL SECTION //
+    ////////////////////////////
+
+    // Wait for sink to write to node
+    if (list_source_.wait() == oat::NodeState::END)
+        return 1;
+
+    // Clone the shared list
+    internal_list_ = *list_source_.retrieve();
+
+    // Tell sink it can continue
+    list_source_.post();
+
+    ////////////////////////////
+    //  END CRITICAL SECTION  //
+
+    for (size_t i = 0; i < internal_list_.size(); i++)
+        filter(internal_list_[i]);
+
+    // START CRITICAL SECTION //
+    ////////////////////////////
+
+    // Wait for sources to read. Nothing is written if the wait was
+    // interrupted.
+    if (list_sink_.wait()) {
 
-    *shared_position_ = internal_position_;
+        *shared_list_ = internal_list_;
 
-    // Tell sources there is new data
-    position_sink_.post();
+        // Tell sources there is new data
+        list_sink_.post();
+    }
 
     ////////////////////////////
     //  END CRITICAL SECTION  //
@@ -27,6 +27,7 @@
 #include "../../lib/base/Component.h"
 #include "../../lib/base/Configurable.h"
 #include "../../lib/datatypes/Position2D.h"
+#include "../../lib/datatypes/PositionList.h"
 #include "../../lib/shmemdf/Sink.h"
 #include "../../lib/shmemdf/Source.h"
 
@@ -52,16 +53,42 @@ public:
     std::string name(void) const override { return name_; }
 
 protected:
+    /**
+     * @brief Options common to position filters that can filter lists of
+     * positions. Only filters that keep no state between positions, so that
+     * each position of a list can be filtered independently, should add
+     * them.
+     */
+    po::options_description baseOptions(void) const;
+
+    /**
+     * @brief Apply options common to position filters that can filter lists
+     * of positions.
+     */
+    void applyBaseConfiguration(const po::variables_map &vm,
+                                const config::OptionTable &config_table);
+
     /**
      * Perform position filtering.
      * @param position Position to be filtered
      */
     virtual void filter(oat::Position2D &position) = 0;
 
+    /**
+     * Update the metadata of filtered positions, e.g. if the filter changes
+     * their units. Called once, before the position SINK binds.
+     * @param metadata Metadata of the un-filtered positions
+     */
+    virtual void filterMetadata(oat::PositionMetadata &metadata) { }
+
 private:
     // Component Interface
     virtual bool connectToNode(void) override;
     int process(void) override;
+    int processList(void);
+
+    // Filter each position of a PositionList rather than a single position
+    bool filter_lists_ {false};
 
     // Filter name
     const std::string name_;
@@ -71,14 +98,21 @@ private:
     oat::Source<oat::Position2D> position_source_;
 
     // Internal, mutable position
-    oat::Position2D internal_position_ {"internal"};
+    oat::Position2D internal_position_;
 
     // Shared position
-    oat::Position2D * shared_position_;
+    oat::Position2D * shared_position_ {nullptr};
 
     // Position SINK
     const std::string position_sink_address_;
     oat::Sink<oat::Position2D> position_sink_;
+
+    // Position list SOURCE and SINK, used instead of the above if
+    // filter_lists_ is true
+    oat::Source<oat::PositionList> list_source_;
+    oat::PositionList internal_list_;
+    oat::PositionList * shared_list_ {nullptr};
+    oat::Sink<oat::PositionList> list_sink_;
 };
 
 }      /* namespace oat */
@@ -41,7 +41,7 @@ RegionFilter2D::~RegionFilter2D()
 po::options_description RegionFilter2D::options() const
 {
     // Update CLI options
-    po::options_description local_opts;
+    po::options_description local_opts(baseOptions());
     local_opts.add_options()
         ("regions", po::value<std::string>(),
          "NOTE: Regions can only be specified in a config file.\n"
@@ -74,6 +74,8 @@ po::options_description RegionFilter2D::options() const
 void RegionFilter2D::applyConfiguration(const po::variables_map &vm,
                                         const config::OptionTable &config_table)
 {
+    applyBaseConfiguration(vm, config_table);
+
     // The config should be an table of arrays.
     // Each key specifies the region ID and its value specifies an array
     // defining a vector of 2D points.
@@ -59,7 +59,8 @@ po::options_description PositionGenerator::baseOptions(void) const
 bool PositionGenerator::connectToNode()
 {
     // Bind to sink sink node and create a shared position
-    position_sink_.bind(position_sink_address_, position_sink_address_);
+    position_sink_.set_metadata(oat::PositionMetadata(position_sink_address_));
+    position_sink_.bind(position_sink_address_);
     shared_position_ = position_sink_.retrieve();
 
     // Setup sample rate info on internal copy
@@ -76,18 +77,20 @@ int PositionGenerator::process()
     // START CRITICAL SECTION //
     ////////////////////////////
 
-    // Wait for sources to read
-    position_sink_.wait();
+    // Wait for sources to read. Nothing is written if the wait was
+    // interrupted.
+    if (position_sink_.wait()) {
 
-    if (first_pos_) {
-        first_pos_ = false;
-        start_ = clock_.now();
-    }
+        if (first_pos_) {
+            first_pos_ = false;
+            start_ = clock_.now();
+        }
 
-    *shared_position_ = internal_position_;
+        *shared_position_ = internal_position_;
 
-    // Tell sources there is new data
-    position_sink_.post();
+        // Tell sources there is new data
+        position_sink_.post();
+    }
 
     ////////////////////////////
     //  END CRITICAL SECTION  //
@@ -24,9 +24,9 @@
 
 #include <rapidjson/rapidjson.h>
 #include <rapidjson/prettywriter.h>
-#include <rapidjson/writer.h>
 #include <rapidjson/stringbuffer.h>
 
+#include "../../lib/datatypes/PositionList.h"
 #include "../../lib/utility/TOMLSanitize.h"
 
 namespace oat {
@@ -34,7 +34,7 @@ namespace oat {
 po::options_description PositionCout::options() const
 {
     // Update CLI options
-    po::options_description local_opts;
+    po::options_description local_opts(baseOptions());
     local_opts.add_options()
         ("pretty-print,p", 
          "If true, print formated positions to the command line.")
@@ -46,24 +46,35 @@ po::options_description PositionCout::options() const
 void PositionCout::applyConfiguration(const po::variables_map &vm,
                                       const config::OptionTable &config_table)
 {
+    applyBaseConfiguration(vm, config_table);
+
     // Format output
     oat::config::getValue<bool>(vm, config_table, "pretty-print", pretty_);
 }
 
-void PositionCout::sendPosition(const oat::Position2D &position)
+template <typename T>
+void PositionCout::send(const T &position)
 {
     // Serialize the current position
-    rapidjson::StringBuffer buffer;
-
     if (pretty_) {
+        rapidjson::StringBuffer buffer;
         rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
         oat::serializePosition(position, writer);
+        std::cout << buffer.GetString() << std::flush;
     } else {
-        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-        oat::serializePosition(position, writer);
+        json_.serialize(position);
+        std::cout.write(json_.data(), json_.size()) << std::flush;
     }
+}
 
-    std::cout << buffer.GetString() << std::flush;
+void PositionCout::sendPosition(const oat::Position2D &position)
+{
+    send(position);
+}
+
+void PositionCout::sendPositions(const oat::PositionList &positions)
+{
+    send(positions);
 }
 
 } /* namespace oat */
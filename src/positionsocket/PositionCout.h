@@ -24,10 +24,13 @@
 
 #include <string>
 
+#include "../../lib/datatypes/PositionJSON.h"
+
 namespace oat {
 
 // Forward decl.
 class Position2D;
+class PositionList;
 
 class PositionCout : public PositionSocket {
 
@@ -42,7 +45,15 @@ class PositionCout : public PositionSocket {
     // Format std out stream
     bool pretty_ {false};
 
+    // Reused for each sample when not pretty printing
+    oat::PositionJSON json_;
+
     void sendPosition(const oat::Position2D &position) override;
+    void sendPositions(const oat::PositionList &positions) override;
+
+    // Send a Position2D or PositionList
+    template <typename T>
+    void send(const T &position);
 };
 
 }      /* namespace oat */
@@ -22,10 +22,8 @@
 #include <string>
 #include <zmq.hpp>
 
-#include <rapidjson/rapidjson.h>
-#include <rapidjson/stringbuffer.h>
-
 #include "../../lib/datatypes/Position2D.h"
+#include "../../lib/datatypes/PositionList.h"
 #include "../../lib/utility/TOMLSanitize.h"
 
 namespace oat {
@@ -40,7 +38,7 @@ PositionPublisher::PositionPublisher(const std::string &position_source_address)
 po::options_description PositionPublisher::options() const
 {
     // Update CLI options
-    po::options_description local_opts;
+    po::options_description local_opts(baseOptions());
     local_opts.add_options()
         ("endpoint,e", po::value<std::string>(),
          "ZMQ-style endpoint. For TCP: '<transport>://<host>:<port>'. For instance, "
@@ -55,6 +53,8 @@ po::options_description PositionPublisher::options() const
 void PositionPublisher::applyConfiguration(
     const po::variables_map &vm, const config::OptionTable &config_table)
 {
+    applyBaseConfiguration(vm, config_table);
+
     // Endpoint
     std::string endpoint;
     oat::config::getValue<std::string>(
@@ -62,17 +62,24 @@ void PositionPublisher::applyConfiguration(
     publisher_.bind(endpoint);
 }
 
-void PositionPublisher::sendPosition(const oat::Position2D &position)
+template <typename T>
+void PositionPublisher::send(const T &position)
 {
     // Serialize the current position
-    rapidjson::StringBuffer buffer;
-    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-    oat::serializePosition(position, writer);
+    json_.serialize(position);
 
     // Publish update
-    zmq::message_t zmsg(buffer.GetSize());
-    memcpy((void *)zmsg.data(), buffer.GetString(), buffer.GetSize());
-    publisher_.send(zmsg);
+    publisher_.send(json_.data(), json_.size());
+}
+
+void PositionPublisher::sendPosition(const oat::Position2D &position)
+{
+    send(position);
+}
+
+void PositionPublisher::sendPositions(const oat::PositionList &positions)
+{
+    send(positions);
 }
 
 } /* namespace oat */
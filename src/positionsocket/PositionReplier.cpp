@@ -22,10 +22,8 @@
 #include <string>
 #include <zmq.hpp>
 
-#include <rapidjson/rapidjson.h>
-#include <rapidjson/stringbuffer.h>
-
 #include "../../lib/datatypes/Position2D.h"
+#include "../../lib/datatypes/PositionList.h"
 #include "../../lib/utility/TOMLSanitize.h"
 
 namespace oat {
@@ -40,7 +38,7 @@ PositionReplier::PositionReplier(const std::string &position_source_address)
 po::options_description PositionReplier::options() const
 {
     // Update CLI options
-    po::options_description local_opts;
+    po::options_description local_opts(baseOptions());
     local_opts.add_options()
         ("endpoint,e", po::value<std::string>(),
          "ZMQ-style endpoint. For TCP: '<transport>://<host>:<port>'. For instance, "
@@ -55,18 +53,19 @@ po::options_description PositionReplier::options() const
 void PositionReplier::applyConfiguration(
     const po::variables_map &vm, const config::OptionTable &config_table)
 {
+    applyBaseConfiguration(vm, config_table);
+
     // Endpoint
     std::string endpoint;
     oat::config::getValue<std::string>(vm, config_table, "endpoint", endpoint, true);
     replier_.bind(endpoint);
 }
 
-void PositionReplier::sendPosition(const oat::Position2D& position)
+template <typename T>
+void PositionReplier::send(const T &position)
 {
     // Serialize the current position
-    rapidjson::StringBuffer buffer;
-    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-    oat::serializePosition(position, writer);
+    json_.serialize(position);
 
     //  Wait for next request from client
     // TODO: Use incoming string to decide which part of the position to send
@@ -74,9 +73,17 @@ void PositionReplier::sendPosition(const oat::Position2D& position)
     replier_.recv(&request);
 
     // Publish update
-    zmq::message_t zmsg(buffer.GetSize());
-    memcpy((void *)zmsg.data(), buffer.GetString(), buffer.GetSize());
-    replier_.send(zmsg);
+    replier_.send(json_.data(), json_.size());
+}
+
+void PositionReplier::sendPosition(const oat::Position2D &position)
+{
+    send(position);
+}
+
+void PositionReplier::sendPositions(const oat::PositionList &positions)
+{
+    send(positions);
 }
 
 } /* namespace oat */
@@ -25,10 +25,13 @@
 #include <string>
 #include <zmq.hpp>
 
+#include "../../lib/datatypes/PositionJSON.h"
+
 namespace oat {
 
 // Forward decl.
 class Position2D;
+class PositionList;
 
 class PositionReplier : public PositionSocket {
 public:
@@ -45,7 +48,15 @@ private:
     zmq::context_t context_ {1};
     zmq::socket_t replier_;
 
-    void sendPosition(const oat::Position2D& position) override;
+    // Reused for each sample
+    oat::PositionJSON json_;
+
+    void sendPosition(const oat::Position2D &position) override;
+    void sendPositions(const oat::PositionList &positions) override;
+
+    // Send a Position2D or PositionList
+    template <typename T>
+    void send(const T &position);
 };
 
 }      /* namespace oat */
@@ -24,6 +24,7 @@
 #include "../../lib/datatypes/Position2D.h"
 #include "../../lib/shmemdf/Sink.h"
 #include "../../lib/shmemdf/Source.h"
+#include "../../lib/utility/TOMLSanitize.h"
 
 namespace oat {
 
@@ -34,13 +35,40 @@ PositionSocket::PositionSocket(const std::string &position_source_address)
     // Nothing
 }
 
+po::options_description PositionSocket::baseOptions(void) const
+{
+    po::options_description base_opts;
+
+    // Common program options
+    base_opts.add_options()
+        ("list",
+         "If set, the SOURCE holds lists of positions, as published by "
+         "position detectors that detect several objects, and each list is "
+         "sent as a single message.")
+        ;
+
+    return base_opts;
+}
+
+void PositionSocket::applyBaseConfiguration(
+    const po::variables_map &vm, const config::OptionTable &config_table)
+{
+    // Lists
+    oat::config::getValue<bool>(vm, config_table, "list", send_lists_);
+}
+
 bool PositionSocket::connectToNode()
 {
     // Establish our a slot in the node 
-    position_source_.touch(position_source_address_);
+    if (send_lists_)
+        list_source_.touch(position_source_address_);
+    else
+        position_source_.touch(position_source_address_);
 
     // Wait for synchronous start with sink when it binds its node
-    if (position_source_.connect() != SourceState::CONNECTED)
+    auto rc = send_lists_ ? list_source_.connect()
+                          : position_source_.connect();
+    if (rc != SourceState::CONNECTED)
         return false;
 
     return true;
@@ -48,6 +76,29 @@ bool PositionSocket::connectToNode()
 
 int PositionSocket::process()
 {
+    if (send_lists_) {
+
+        // START CRITICAL SECTION //
+        ////////////////////////////
+        node_state_ = list_source_.wait();
+        if (node_state_ == oat::NodeState::END)
+            return 1;
+
+        // Clone the shared list
+        internal_list_ = *list_source_.retrieve();
+
+        // Tell sink it can continue
+        list_source_.post();
+
+        ////////////////////////////
+        //  END CRITICAL SECTION  //
+
+        sendPositions(internal_list_);
+        traceSent(internal_list_.sample());
+
+        return 0;
+    }
+
     // START CRITICAL SECTION //
     ////////////////////////////
     node_state_ = position_source_.wait();
@@ -65,9 +116,18 @@ int PositionSocket::process()
 
     // Send the newly acquired position
     sendPosition(internal_position_);
+    traceSent(internal_position_.sample());
 
     // Sink was not at END state
     return 0;
 }
 
+void PositionSocket::traceSent(oat::Sample sample) const
+{
+    if (Profiler *p = Profiler::current()) {
+        sample.stamp(statsNow());
+        p->traceSample(sample);
+    }
+}
+
 } /* namespace oat */
@@ -28,6 +28,7 @@
 #include "../../lib/base/Component.h"
 #include "../../lib/base/Configurable.h"
 #include "../../lib/datatypes/Position2D.h"
+#include "../../lib/datatypes/PositionList.h"
 #include "../../lib/shmemdf/Sink.h"
 #include "../../lib/shmemdf/Source.h"
 
@@ -50,17 +51,38 @@ public:
     std::string name(void) const override { return name_; }
 
 protected:
+    /**
+     * @brief Options common to all position sockets.
+     */
+    po::options_description baseOptions(void) const;
+
+    /**
+     * @brief Apply options common to all position sockets.
+     */
+    void applyBaseConfiguration(const po::variables_map &vm,
+                                const config::OptionTable &config_table);
+
     /**
      * Send the position via specified IO protocol.
      * @param Position to serve.
      */
     virtual void sendPosition(const oat::Position2D &position) = 0;
 
+    /**
+     * Send a list of positions via specified IO protocol.
+     * @param positions Positions to serve.
+     */
+    virtual void sendPositions(const oat::PositionList &positions) = 0;
+
 private:
     // Component Interface
     bool connectToNode(void) override;
     int process(void) override;
 
+    // Sockets are where samples leave the pipeline, so the time that a sample
+    // is sent is the last stamp of its latency trace
+    void traceSent(oat::Sample sample) const;
+
     // Position Socket name
     const std::string name_;
 
@@ -70,7 +92,12 @@ private:
     oat::Source<oat::Position2D> position_source_;
 
     // The current, internally allocated position
-    oat::Position2D internal_position_ {"internal"};
+    oat::Position2D internal_position_;
+
+    // Position list SOURCE, used instead of the above if send_lists_ is true
+    bool send_lists_ {false};
+    oat::Source<oat::PositionList> list_source_;
+    oat::PositionList internal_list_;
 };
 
 }      /* namespace oat */
@@ -25,6 +25,7 @@
 #include <rapidjson/rapidjson.h>
 
 #include "../../lib/datatypes/Position2D.h"
+#include "../../lib/datatypes/PositionList.h"
 #include "../../lib/utility/TOMLSanitize.h"
 
 namespace oat {
@@ -39,7 +40,7 @@ UDPPositionClient::UDPPositionClient(const std::string &position_source_address)
 po::options_description UDPPositionClient::options() const
 {
     // Update CLI options
-    po::options_description local_opts;
+    po::options_description local_opts(baseOptions());
     local_opts.add_options()
         ("host,h", po::value<std::string>(),
          "Host IP address of remote device to send positions to. For "
@@ -55,6 +56,8 @@ po::options_description UDPPositionClient::options() const
 void UDPPositionClient::applyConfiguration(
     const po::variables_map &vm, const config::OptionTable &config_table)
 {
+    applyBaseConfiguration(vm, config_table);
+
     // Host
     std::string host;
     oat::config::getValue<std::string>(
@@ -77,7 +80,8 @@ void UDPPositionClient::applyConfiguration(
 }
 
 // Each position is sent in a single UDP packet
-void UDPPositionClient::sendPosition(const oat::Position2D &current_position)
+template <typename T>
+void UDPPositionClient::send(const T &current_position)
 {
     rapidjson::Writer < rapidjson::SocketWriteStream
                       < UDPSocket, UDPEndpoint > > udp_writer_ {*udp_stream_};
@@ -89,4 +93,14 @@ void UDPPositionClient::sendPosition(const oat::Position2D &current_position)
     udp_stream_->Flush();
 }
 
+void UDPPositionClient::sendPosition(const oat::Position2D &position)
+{
+    send(position);
+}
+
+void UDPPositionClient::sendPositions(const oat::PositionList &positions)
+{
+    send(positions);
+}
+
 } /* namespace oat */
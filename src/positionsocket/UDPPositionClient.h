@@ -32,6 +32,7 @@ namespace oat {
 
 // Forward decl.
 class Position2D;
+class PositionList;
 
 class UDPPositionClient : public PositionSocket {
 
@@ -58,7 +59,12 @@ private:
     char buffer_[MAX_LENGTH]; // Buffer is flushed after each position read
     std::unique_ptr<SocketWriter> udp_stream_;
 
-    void sendPosition(const oat::Position2D& position) override;
+    void sendPosition(const oat::Position2D &position) override;
+    void sendPositions(const oat::PositionList &positions) override;
+
+    // Send a Position2D or PositionList
+    template <typename T>
+    void send(const T &position);
 };
 
 }      /* namespace oat */
@@ -24,6 +24,7 @@
 #include <rapidjson/rapidjson.h>
 
 #include "../../lib/datatypes/Position2D.h"
+#include "../../lib/datatypes/PositionList.h"
 
 #include "SocketWriteStream.h"
 #include "UDPPositionServer.h"
@@ -43,7 +44,8 @@ UDPPositionServer::UDPPositionServer(const std::string &position_source_address,
 
 }
 
-void UDPPositionServer::sendPosition(const oat::Position2D& current_position) {
+template <typename T>
+void UDPPositionServer::send(const T &current_position) {
 
     rapidjson::Writer < rapidjson::SocketWriteStream
                       < UDPSocket, UDPEndpoint > > udp_writer_ {*udp_stream_};
@@ -59,11 +61,21 @@ void UDPPositionServer::sendPosition(const oat::Position2D& current_position) {
     /*size_t length = */ socket_.receive_from(
         boost::asio::buffer(rx_buffer_, MAX_LENGTH), endpoint_);
 
-    current_position.Serialize(udp_writer_);
+    oat::serializePosition(current_position, udp_writer_);
 
     // Flush the stream after each Serialization call so that each UDP packet
     // corresponds to a single position value
     udp_stream_->Flush();
 }
 
+void UDPPositionServer::sendPosition(const oat::Position2D &position)
+{
+    send(position);
+}
+
+void UDPPositionServer::sendPositions(const oat::PositionList &positions)
+{
+    send(positions);
+}
+
 } /* namespace oat */
\ No newline at end of file
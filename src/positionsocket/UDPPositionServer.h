@@ -32,6 +32,7 @@ namespace oat {
 
 // Forward decl.
 class Position2D;
+class PositionList;
 
 class UDPPositionServer : public PositionSocket {
 
@@ -69,7 +70,12 @@ private:
      * @param position
      * @param sample
      */
-    void sendPosition(const oat::Position2D& position) override;
+    void sendPosition(const oat::Position2D &position) override;
+    void sendPositions(const oat::PositionList &positions) override;
+
+    // Send a Position2D or PositionList
+    template <typename T>
+    void send(const T &position);
 
 };
 
@@ -93,4 +93,13 @@ void FrameWriter::push(void )
         throw std::runtime_error(OVERRUN_MSG);
 }
 
+void FrameWriter::push(size_t slot)
+{
+    // The queue shares the held frame's data, so release the slot's
+    // reference rather than reusing its buffer for a later sample
+    if (!buffer_.push(oat::Frame(held_[slot])))
+        throw std::runtime_error(OVERRUN_MSG);
+    held_[slot].release();
+}
+
 } /* namespace oat */
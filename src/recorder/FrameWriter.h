@@ -22,6 +22,8 @@
 
 #include "Writer.h"
 
+#include <vector>
+
 #include <boost/lockfree/spsc_queue.hpp>
 #include <opencv2/videoio.hpp>
 
@@ -44,12 +46,15 @@ public:
     {
         return source_.retrieve()->sample_period_sec();
     }
-    oat::NodeState wait() override { return source_.wait(); }
-    void post(void) override { source_.post(); }
+    oat::Sample sample() override { return source_.retrieve()->sample(); }
+    oat::SourceSync &source() override { return source_; }
 
     void initialize(const std::string &path) override;
     void write(void) override;
     void push(void) override;
+    void setHoldSlots(size_t n) override { held_.resize(n); }
+    void hold(size_t slot) override { held_[slot] = source_.clone(); }
+    void push(size_t slot) override;
     void deleteFile() override
     {
         if (!path_.empty())
@@ -61,6 +66,10 @@ private:
         = boost::lockfree::spsc_queue<oat::Frame, blf::capacity<BUFFER_SIZE>>;
     SPSCBuffer buffer_;
 
+    // Frames awaiting alignment. Only pixel data is written, so these are
+    // plain matrices.
+    std::vector<cv::Mat> held_;
+
     // Video writer and required parameters
     std::string path_ {""};
     int fourcc_ {0}; // Default to uncompressed
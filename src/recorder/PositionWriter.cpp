@@ -27,7 +27,8 @@
 
 namespace oat {
 
-PositionWriter::~PositionWriter()
+template <typename T>
+PositionWriter<T>::~PositionWriter()
 {
     if (use_binary_ && fd_ != nullptr) {
         auto n = std::to_string(completed_writes_);
@@ -40,7 +41,8 @@ PositionWriter::~PositionWriter()
     }
 }
 
-void PositionWriter::configure(const oat::config::OptionTable &t,
+template <typename T>
+void PositionWriter<T>::configure(const oat::config::OptionTable &t,
                                const po::variables_map &vm)
 {
     // File overwrite
@@ -53,7 +55,8 @@ void PositionWriter::configure(const oat::config::OptionTable &t,
     oat::config::getValue(vm, t, "concise-file", concise_file_);
 }
 
-void PositionWriter::initialize(const std::string &path) 
+template <typename T>
+void PositionWriter<T>::initialize(const std::string &path) 
 {
     if (use_binary_)
         initializeBinary(path);
@@ -61,7 +64,8 @@ void PositionWriter::initialize(const std::string &path)
         initializeJSON(path);
 }
 
-void PositionWriter::initializeBinary(const std::string &path)
+template <typename T>
+void PositionWriter<T>::initializeBinary(const std::string &path)
 {
     auto path_ =  path + ".npy";
 
@@ -78,11 +82,17 @@ void PositionWriter::initializeBinary(const std::string &path)
     assert(fd_);
 
     // Write header
-    auto header = getNumpyHeader(oat::Position2D::NPY_DTYPE);
+    auto header = getNumpyHeader(T::NPY_DTYPE);
     fwrite(header.data(), 1, header.size(), fd_);
+
+    // Records are packed in batches so that nothing is allocated while
+    // writing
+    batch_.resize(BATCH_SIZE);
+    pack_.resize(BATCH_SIZE * T::NPY_DTYPE_BYTES);
 }
 
-void PositionWriter::initializeJSON(const std::string &path)
+template <typename T>
+void PositionWriter<T>::initializeJSON(const std::string &path)
 {
     auto path_ =  path + ".json";
 
@@ -137,28 +147,45 @@ void PositionWriter::initializeJSON(const std::string &path)
     json_writer_.StartArray();
 }
 
-void PositionWriter::write() {
-
-    oat::Position2D p("");
+template <typename T>
+void PositionWriter<T>::write() {
 
-    while (buffer_.pop(p)) {
+    if (use_binary_) {
 
-        if (use_binary_) {
-            //std::cout << "Dummy write.\n";
-            auto pack = oat::packPosition(p);
-            fwrite(pack.data(), 1, pack.size(), fd_);
-        } else {
-            oat::serializePosition(p, json_writer_, !concise_file_);
+        size_t n;
+        while ((n = buffer_.pop(batch_.data(), batch_.size())) > 0) {
+            oat::packPositions(batch_.data(), n, pack_.data());
+            fwrite(pack_.data(), T::NPY_DTYPE_BYTES, n, fd_);
+            completed_writes_ += n;
         }
 
+        return;
+    }
+
+    T p;
+
+    while (buffer_.pop(p)) {
+        oat::serializePosition(p, json_writer_, !concise_file_);
         completed_writes_++;
     }
 }
 
-void PositionWriter::push() {
+template <typename T>
+void PositionWriter<T>::push() {
 
     if (!buffer_.push(source_.clone()))
         throw std::runtime_error(OVERRUN_MSG);
 }
 
+template <typename T>
+void PositionWriter<T>::push(size_t slot) {
+
+    if (!buffer_.push(held_[slot]))
+        throw std::runtime_error(OVERRUN_MSG);
+}
+
+// Explicit instantiations
+template class PositionWriter<oat::Position2D>;
+template class PositionWriter<oat::PositionList>;
+
 } /* namespace oat */
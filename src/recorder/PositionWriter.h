@@ -22,16 +22,24 @@
 
 #include "Writer.h"
 
+#include <vector>
+
 #include <boost/lockfree/spsc_queue.hpp>
 #include <rapidjson/filewritestream.h>
 #include <rapidjson/prettywriter.h>
 
 #include "../../lib/datatypes/Position2D.h"
+#include "../../lib/datatypes/PositionList.h"
 #include "../../lib/utility/FileFormat.h"
 
 namespace oat {
 namespace blf = boost::lockfree;
 
+/**
+ * @brief Writes positions to a JSON or numpy file.
+ * @tparam T Position2D, or PositionList for multi-object detectors.
+ */
+template <typename T>
 class PositionWriter : public Writer{
 public:
     using Writer::Writer;
@@ -47,12 +55,15 @@ public:
         return source_.retrieve()->sample_period_sec();
     }
 
-    oat::NodeState wait() override { return source_.wait(); }
-    void post(void) override { source_.post(); }
+    oat::Sample sample() override { return source_.retrieve()->sample(); }
+    oat::SourceSync &source() override { return source_; }
 
     void initialize(const std::string &path) override;
     void write(void) override;
     void push(void) override;
+    void setHoldSlots(size_t n) override { held_.resize(n); }
+    void hold(size_t slot) override { held_[slot] = source_.clone(); }
+    void push(size_t slot) override;
     void deleteFile() override
     {
         if (!path_.empty())
@@ -60,7 +71,7 @@ public:
     }
 
 private:
-    using SPSCBuffer = boost::lockfree::spsc_queue<oat::Position2D,
+    using SPSCBuffer = boost::lockfree::spsc_queue<T,
                                                    blf::capacity<BUFFER_SIZE>>;
     /**
      * @brief Determines if indeterminate position data fields should be
@@ -71,6 +82,7 @@ private:
 
     std::string path_ {""};
     SPSCBuffer buffer_;
+    std::vector<T> held_; //!< Positions awaiting alignment
 
     //// Timestamp clock
     //std::chrono::system_clock clock_;
@@ -89,10 +101,13 @@ private:
     // Binary-specific
     void initializeBinary(const std::string &path);
     bool use_binary_ {false};
+    static constexpr size_t BATCH_SIZE {64};
+    std::vector<T> batch_; //!< Positions popped from buffer_ at once
+    std::vector<char> pack_; //!< Their binary records
     static constexpr int header_prefix_size_ {10};
     static constexpr int shape_end_byte_ {10};
 
-    oat::Source<Position2D> source_;
+    oat::Source<T> source_;
 };
 
 }      /* namespace oat */
@@ -62,6 +62,10 @@ po::options_description Recorder::options() const
         ("position-sources,p", po::value< std::vector<std::string> >()->multitoken(),
         "The names of the POSITION SOURCES that supply object positions "
         "to be recorded.")
+        ("position-list-sources,l", po::value< std::vector<std::string> >()->multitoken(),
+        "The names of the POSITION SOURCES that supply lists of object "
+        "positions, as published by position detectors that detect several "
+        "objects, to be recorded.")
         ("filename,n", po::value<std::string>(),
         "The base file name. If not specified, defaults to the SOURCE "
         "name.")
@@ -97,6 +101,8 @@ po::options_description Recorder::options() const
          "detected or not, potentially complicating file parsing.")
         ;
 
+    local_opts.add(oat::config::syncOptions());
+
     return local_opts;
 }
 
@@ -123,7 +129,20 @@ void Recorder::applyConfiguration(const po::variables_map &vm,
         oat::config::checkForDuplicateSources(addrs);
 
         for (auto &a : addrs)
-            writers_.emplace_back(oat::make_unique<PositionWriter>(a));
+            writers_.emplace_back(
+                oat::make_unique<PositionWriter<oat::Position2D>>(a));
+    }
+
+    if (vm.count("position-list-sources")) {
+
+        auto addrs = vm["position-list-sources"].as<
+            std::vector<std::string> >();
+
+        oat::config::checkForDuplicateSources(addrs);
+
+        for (auto &a : addrs)
+            writers_.emplace_back(
+                oat::make_unique<PositionWriter<oat::PositionList>>(a));
     }
 
     if (writers_.size() == 0)
@@ -142,12 +161,18 @@ void Recorder::applyConfiguration(const po::variables_map &vm,
     // Date
     oat::config::getValue(vm, config_table, "date", prepend_timestamp_);
 
+    // Alignment of samples across SOURCES
+    sync_config_ = getSyncConfig(vm, config_table);
+
     // Writer specific options
     for (auto &w : writers_)
         w->configure(config_table, vm);
 
     // Start the recording thread
-    writer_thread_ = std::thread( [this] { writeLoop(); } );
+    writer_thread_ = std::thread( [this] {
+        scheduleHelperThread();
+        writeLoop();
+    });
 }
 
 bool Recorder::connectToNode()
@@ -161,12 +186,20 @@ bool Recorder::connectToNode()
         if (w->connect() != SourceState::CONNECTED)
             return false;
         all_ts.push_back(w->sample_period_sec());
+        sync_sources_.push_back(&w->source());
     }
 
     // Examine sample period of sources to make sure they are the same
     if (!oat::checkSamplePeriods(all_ts, sample_rate_hz_))
         std::cerr << oat::Warn(oat::inconsistentSampleRateWarning(sample_rate_hz_));
 
+    if (sync_config_.key != oat::SyncKey::NONE && writers_.size() > 1) {
+        sync_ = oat::make_unique<oat::SampleSynchronizer>(writers_.size(),
+                                                          sync_config_);
+        for (auto &w : writers_)
+            w->setHoldSlots(sync_->window());
+    }
+
     // Setup file, etc
     initializeRecording();
 
@@ -175,25 +208,44 @@ bool Recorder::connectToNode()
 
 int Recorder::process()
 {
-    bool source_eof = false;
-
-    // Read sources, push samples to write buffers
-    for (auto &w : writers_) {
+    oat::NodeState state;
+
+    if (sync_) {
+
+        // Hold samples until they are matched with those of the other
+        // sources, even when paused, so that alignment is kept
+        state = oat::waitAll(sync_sources_, [this](size_t i) {
+            const size_t slot = sync_->push(i, writers_[i]->sample());
+            if (slot != oat::SampleSynchronizer::NO_SLOT)
+                writers_[i]->hold(slot);
+        });
+
+        // Push each complete tuple to the write buffers
+        while (sync_->pop(aligned_)) {
+            if (record_on_) {
+                for (size_t i = 0; i < writers_.size(); i++)
+                    writers_[i]->push(aligned_[i]);
+                files_have_data_ = true;
+            }
+        }
 
-        // START CRITICAL SECTION //
-        ////////////////////////////
-        source_eof |= w->wait() == oat::NodeState::END;
+        if (sync_->warningDue())
+            std::cerr << oat::Warn(oat::misalignedSourcesWarning(*sync_));
 
-        if (record_on_ && !source_eof) {
-           w->push();
-           files_have_data_ = true;
-        }
+    } else {
 
-        w->post();
-        ////////////////////////////
-        //  END CRITICAL SECTION  //
+        // Read sources, push samples to write buffers. Each source is posted
+        // as soon as its sample has been pushed.
+        state = oat::waitAll(sync_sources_, [this](size_t i) {
+            if (record_on_) {
+                writers_[i]->push();
+                files_have_data_ = true;
+            }
+        });
     }
 
+    const bool source_eof = state == oat::NodeState::END;
+
     // Notify the writer thread that there are new queued samples
     writer_condition_variable_.notify_one();
 
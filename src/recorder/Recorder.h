@@ -96,6 +96,12 @@ private:
 
     // Writers (each owns its SOURCE)
     std::vector<std::unique_ptr<Writer>> writers_;
+    std::vector<oat::SourceSync *> sync_sources_; //!< Sources for waitAll()
+
+    // Sample alignment across writers. Unused if the sync key is NONE.
+    oat::SyncConfig sync_config_;
+    std::unique_ptr<oat::SampleSynchronizer> sync_;
+    std::vector<size_t> aligned_;
 
     // File-writer threading
     std::thread writer_thread_;
@@ -28,6 +28,7 @@
 #include <rapidjson/filewritestream.h>
 #include <rapidjson/prettywriter.h>
 
+#include "../../lib/datatypes/Sample.h"
 #include "../../lib/shmemdf/Node.h"
 #include "../../lib/shmemdf/Source.h"
 #include "../../lib/utility/FileFormat.h"
@@ -58,9 +59,9 @@ public:
     // Stuff for manipulating held source
     virtual void touch(void) = 0;
     virtual oat::SourceState connect(void) = 0;
-    virtual oat::NodeState wait(void) = 0;
-    virtual void post(void) = 0;
+    virtual oat::SourceSync &source(void) = 0;
     virtual double sample_period_sec(void) = 0;
+    virtual oat::Sample sample(void) = 0;
 
     /**
      * @brief Create and initialize recording file. Must be called
@@ -73,6 +74,22 @@ public:
      */
     virtual void push(void) = 0;
 
+    /**
+     * @brief Set the number of slots in which samples awaiting alignment
+     * with other writers' samples are held.
+     */
+    virtual void setHoldSlots(size_t n) = 0;
+
+    /**
+     * @brief Copy the current sample into a hold slot.
+     */
+    virtual void hold(size_t slot) = 0;
+
+    /**
+     * @brief Push a held sample onto the write queue
+     */
+    virtual void push(size_t slot) = 0;
+
     /**
      * @brief Flush internal sample buffer to file.
      */
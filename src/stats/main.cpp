@@ -0,0 +1,341 @@
+//******************************************************************************
+//* File:   oat stats main.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//****************************************************************************
+
+#include "OatConfig.h" // Generated by CMake
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dirent.h>
+#include <unistd.h>
+
+#include <boost/program_options.hpp>
+#include <boost/interprocess/managed_shared_memory.hpp>
+
+#include "../../lib/shmemdf/Node.h"
+#include "../../lib/utility/IOFormat.h"
+
+namespace po = boost::program_options;
+namespace bip = boost::interprocess;
+
+// Global via extern in Globals.h
+namespace oat { volatile sig_atomic_t quit = 0; }
+
+// Copy of the telemetry of a single node
+struct NodeSnapshot {
+
+    struct Slot {
+        size_t index;
+        int64_t pid;
+        bool blocking;
+        uint64_t behind;
+        oat::HistogramSnapshot wait, hold, latency;
+    };
+
+    uint64_t time_ns;
+    oat::NodeState state;
+    uint64_t writes;
+    int64_t sink_pid;
+    uint64_t evictions;
+    uint64_t dropped;
+    oat::HistogramSnapshot sink_wait, sink_hold, last_read;
+    std::vector<Slot> slots;
+};
+
+void printUsage(po::options_description options) {
+    std::cout << "Usage: stats [INFO]\n"
+              << "   or: stats [NAMES] [CONFIGURATION]\n"
+              << "Display live telemetry of the shared memory nodes specified "
+              << "by NAMES, or of\nall nodes if NAMES is not given.\n\n"
+              << options << "\n";
+}
+
+// Node names of all shared memory segments on this host
+std::vector<std::string> liveNodes() {
+
+    std::vector<std::string> names;
+    const std::string suffix = "_node";
+
+    DIR *dir = opendir("/dev/shm");
+    if (dir == nullptr)
+        return names;
+
+    while (struct dirent *entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name.size() > suffix.size()
+            && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0)
+            names.push_back(name.substr(0, name.size() - suffix.size()));
+    }
+    closedir(dir);
+
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+// Attach read-only to a node and copy its telemetry
+bool takeSnapshot(const std::string &name, NodeSnapshot &snap) {
+
+    try {
+        bip::managed_shared_memory shmem(bip::open_read_only,
+                                         (name + "_node").c_str());
+        const oat::Node *node =
+            shmem.find<oat::Node>(typeid(oat::Node).name()).first;
+        if (node == nullptr)
+            return false;
+
+        snap.time_ns = oat::statsNow();
+        snap.state = node->sink_state();
+        snap.writes = node->write_number();
+        snap.sink_pid = node->sink_stats.pid;
+        snap.evictions = node->sink_stats.evictions;
+        snap.dropped = node->sink_stats.dropped;
+        snap.sink_wait = node->sink_stats.wait.snapshot();
+        snap.sink_hold = node->sink_stats.hold.snapshot();
+        snap.last_read = node->sink_stats.last_read.snapshot();
+
+        const oat::Node::mask_t blocking = node->blocking_slots();
+        for (auto m = node->source_slots(); m; m &= m - 1) {
+
+            const size_t i = __builtin_ctzll(m);
+            const auto &s = node->source_stats[i];
+            snap.slots.push_back({i,
+                                  node->slot_pid(i),
+                                  (blocking >> i & 1) != 0,
+                                  node->reads_behind(i),
+                                  s.wait.snapshot(),
+                                  s.hold.snapshot(),
+                                  s.latency.snapshot()});
+        }
+
+    } catch (const bip::interprocess_exception &) {
+        return false; // Node was removed
+    }
+
+    return true;
+}
+
+std::string stateName(oat::NodeState state) {
+
+    switch (state) {
+        case oat::NodeState::END: return "END";
+        case oat::NodeState::UNDEFINED: return "UNBOUND";
+        case oat::NodeState::SINK_BOUND: return "BOUND";
+        case oat::NodeState::ERROR: return "ERROR";
+    }
+
+    return "?";
+}
+
+// Print the change in a node's telemetry between two snapshots
+void printNode(const std::string &name,
+               const NodeSnapshot &prev,
+               const NodeSnapshot &curr) {
+
+    const double dt = (curr.time_ns - prev.time_ns) / 1e9;
+    const auto sink_wait = curr.sink_wait - prev.sink_wait;
+    const auto sink_hold = curr.sink_hold - prev.sink_hold;
+    const auto last_read = curr.last_read - prev.last_read;
+    const double sink_blocked = sink_wait.total_ns / 1e9 / dt;
+
+    std::printf("%-16s %-8s %7lld %10.1f %8.1f%% %11.1f %9.0f/%-9.0f %7llu %9.1f\n",
+                name.c_str(),
+                stateName(curr.state).c_str(),
+                static_cast<long long>(curr.sink_pid),
+                (curr.writes - prev.writes) / dt,
+                100.0 * sink_blocked,
+                sink_hold.mean_us(),
+                last_read.percentile_us(0.5),
+                last_read.percentile_us(0.99),
+                static_cast<unsigned long long>(curr.evictions),
+                (curr.dropped - prev.dropped) / dt);
+
+    // When the sink is mostly blocked, the blocking source that holds each
+    // ring slot the longest is holding up the pipeline
+    size_t slowest = oat::Node::MAX_SLOTS;
+    double slowest_hold = 0.0;
+
+    std::vector<std::pair<NodeSnapshot::Slot, NodeSnapshot::Slot>> slots;
+    for (const auto &c : curr.slots) {
+        for (const auto &p : prev.slots) {
+            if (p.index == c.index && p.pid == c.pid) {
+                slots.emplace_back(p, c);
+                const auto hold = c.hold - p.hold;
+                if (c.blocking && sink_blocked > 0.5
+                    && hold.mean_us() > slowest_hold) {
+                    slowest = c.index;
+                    slowest_hold = hold.mean_us();
+                }
+            }
+        }
+    }
+
+    for (const auto &s : slots) {
+
+        const auto &p = s.first;
+        const auto &c = s.second;
+        const auto wait = c.wait - p.wait;
+        const auto hold = c.hold - p.hold;
+        const auto latency = c.latency - p.latency;
+
+        std::printf("  %-4zu %7lld %-4s %10.1f %7llu %8.1f%% %11.1f/%-9.0f %9.0f%s\n",
+                    c.index,
+                    static_cast<long long>(c.pid),
+                    c.blocking ? "B" : "NB",
+                    latency.count() / dt,
+                    static_cast<unsigned long long>(c.behind),
+                    100.0 * wait.total_ns / 1e9 / dt,
+                    hold.mean_us(),
+                    hold.percentile_us(0.99),
+                    latency.percentile_us(0.99),
+                    c.index == slowest ? "  <- holding up sink" : "");
+    }
+}
+
+int main(int argc, char *argv[]) {
+
+    std::vector<std::string> names;
+    size_t interval_ms {1000};
+    size_t count {0};
+
+    try {
+
+        po::options_description options("INFO");
+        options.add_options()
+            ("help", "Produce help message.")
+            ("version,v", "Print version information.")
+            ;
+
+        po::options_description config("CONFIGURATION");
+        config.add_options()
+            ("interval,i", po::value<size_t>(),
+             "Refresh interval in milliseconds. Defaults to 1000.")
+            ("count,n", po::value<size_t>(),
+             "Number of refreshes before exiting. Defaults to 0, which "
+             "refreshes until interrupted.")
+            ;
+
+        po::options_description hidden("HIDDEN OPTIONS");
+        hidden.add_options()
+            ("names", po::value< std::vector<std::string> >(),
+            "The names of the nodes to display.")
+            ;
+
+        po::positional_options_description positional_options;
+        positional_options.add("names", -1);
+
+        po::options_description all_options("ALL");
+        all_options.add(options).add(config).add(hidden);
+
+        po::options_description visible_options("OPTIONS");
+        visible_options.add(options).add(config);
+
+        po::variables_map variable_map;
+        po::store(po::command_line_parser(argc, argv)
+                .options(all_options)
+                .positional(positional_options)
+                .run(),
+                variable_map);
+        po::notify(variable_map);
+
+        // Use the parsed options
+        if (variable_map.count("help")) {
+            printUsage(visible_options);
+            return 0;
+        }
+
+        if (variable_map.count("version")) {
+            std::cout << "Oat Stats version "
+                      << Oat_VERSION_MAJOR
+                      << "."
+                      << Oat_VERSION_MINOR
+                      << "\n";
+            std::cout << "Written by Jonathan P. Newman in the MWL@MIT.\n";
+            std::cout << "Licensed under the GPL3.0.\n";
+            return 0;
+        }
+
+        if (variable_map.count("interval"))
+            interval_ms = std::max<size_t>(variable_map["interval"].as<size_t>(), 1);
+
+        if (variable_map.count("count"))
+            count = variable_map["count"].as<size_t>();
+
+        if (variable_map.count("names"))
+            names = variable_map["names"].as< std::vector<std::string> >();
+
+    } catch (std::exception& e) {
+        std::cerr << oat::Error(e.what()) << "\n";
+        return -1;
+    } catch (...) {
+        std::cerr << oat::Error("Exception of unknown type.\n");
+        return -1;
+    }
+
+    const bool clear_screen = isatty(fileno(stdout));
+    std::map<std::string, NodeSnapshot> prev;
+
+    for (size_t n = 0; count == 0 || n <= count; n++) {
+
+        std::map<std::string, NodeSnapshot> curr;
+        for (const auto &name : names.empty() ? liveNodes() : names) {
+            NodeSnapshot snap;
+            if (takeSnapshot(name, snap))
+                curr.emplace(name, std::move(snap));
+        }
+
+        // The first pass only establishes a baseline
+        if (n > 0) {
+
+            if (clear_screen)
+                std::printf("\033[2J\033[H");
+
+            std::printf("%-16s %-8s %7s %10s %9s %11s %19s %7s %9s\n",
+                        "NODE", "STATE", "PID", "WRITES/s", "BLOCKED",
+                        "HOLD(us)", "LAST READ p50/p99", "EVICTED", "DROPPED/s");
+            std::printf("  %-4s %7s %-4s %10s %7s %9s %21s %9s\n",
+                        "SLOT", "PID", "MODE", "READS/s", "BEHIND", "WAITING",
+                        "HOLD(us) avg/p99", "LAT p99");
+
+            for (const auto &c : curr) {
+                auto p = prev.find(c.first);
+                if (p != prev.end())
+                    printNode(c.first, p->second, c.second);
+            }
+
+            if (curr.empty())
+                std::printf("No nodes found.\n");
+
+            std::fflush(stdout);
+        }
+
+        prev = std::move(curr);
+
+        if (count == 0 || n < count)
+            std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+    }
+
+    return 0;
+}
@@ -51,8 +51,9 @@ Viewer<T>::~Viewer()
 template <typename T>
 bool Viewer<T>::connectToNode()
 {
-    // Establish our a slot in the node
-    source_.touch(source_address_);
+    // Viewers should never hold up the sink, so they do not take a slot in
+    // the node and always show the most recent sample.
+    source_.touch(source_address_, oat::SourceMode::LATEST);
 
     // Wait for synchronous start with sink when it binds the node
     if (source_.connect() != SourceState::CONNECTED)
@@ -64,6 +65,16 @@ bool Viewer<T>::connectToNode()
 template <typename T>
 int Viewer<T>::process()
 {
+    // The source copies the most recent sample each time it wait()s, so only
+    // wait once the minimum update period has passed and the display thread
+    // is ready for a new sample
+    Milliseconds duration
+        = std::chrono::duration_cast<Milliseconds>(Clock::now() - tock_);
+    if (duration <= min_update_period_ms || !display_complete_) {
+        std::this_thread::sleep_for(Milliseconds(1));
+        return 0;
+    }
+
     // START CRITICAL SECTION //
     ////////////////////////////
 
@@ -71,14 +82,7 @@ int Viewer<T>::process()
     if (source_.wait() == oat::NodeState::END)
         return 1;
 
-    // Figure out the time since we last updated the viewer
-    Milliseconds duration
-        = std::chrono::duration_cast<Milliseconds>(Clock::now() - tock_);
-    bool refresh_needed = duration > min_update_period_ms && display_complete_;
-
-    // Clone the shared frame if needed
-    if (refresh_needed)
-        source_.copyTo(sample_);
+    source_.copyTo(sample_);
 
     // Tell sink it can continue
     source_.post();
@@ -86,13 +90,10 @@ int Viewer<T>::process()
     ////////////////////////////
     //  END CRITICAL SECTION  //
 
-    // If the minimum update period has passed, and display thread is not busy,
-    // show the new sample on the display thread. This prevents GUI updates
+    // Show the new sample on the display thread. This prevents GUI updates
     // from holding up more important upstream processing.
-    if (refresh_needed) {
-        display_cv_.notify_one();
-        tock_ = Clock::now();
-    }
+    display_cv_.notify_one();
+    tock_ = Clock::now();
 
     // Sink was not at END state
     return 0;
@@ -101,6 +102,8 @@ int Viewer<T>::process()
 template <typename T>
 void Viewer<T>::processAsync()
 {
+    bool scheduled = false;
+
     while (running_) {
 
         std::unique_lock<std::mutex> lk(display_mutex_);
@@ -111,6 +114,13 @@ void Viewer<T>::processAsync()
         if (!running_)
             break;
 
+        // This thread starts before the component is configured, so its
+        // scheduling is applied once samples start arriving
+        if (!scheduled) {
+            scheduleHelperThread();
+            scheduled = true;
+        }
+
         display_complete_ = false;
         display(sample_); // Implemented in concrete class
         display_complete_ = true;
@@ -1,3 +1,3 @@
-oat framefilt bsub raw flt &
+oat framefilt bsub raw flt --stripes ${2:-1} &
 sleep 1
 time oat frameserve test raw -f $1 -c test.toml test
@@ -1,3 +1,3 @@
-oat framefilt mask raw flt -c test.toml framefilt-mask &
+oat framefilt mask raw flt -c test.toml framefilt-mask --stripes ${2:-1} &
 osleep 1
 time oat frameserve test raw -f $1 -c test.toml test
@@ -1,3 +1,3 @@
-oat posidet hsv raw pos &
+oat posidet hsv raw pos --stripes ${2:-1} &
 sleep 1
 time oat frameserve test raw -f $1 -c test.toml test
@@ -0,0 +1,163 @@
+//******************************************************************************
+//* File:   FramePool_test.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+
+#include <opencv2/core.hpp>
+
+#include "../../lib/datatypes/FramePool.h"
+
+// Count heap allocations made while counting_ is set. OpenCV allocates
+// matrix data with malloc() or posix_memalign(), and everything else uses
+// operator new.
+static std::atomic<bool> counting_ {false};
+static std::atomic<size_t> allocations_ {0};
+
+static void countAllocation()
+{
+    if (counting_.load(std::memory_order_relaxed))
+        allocations_++;
+}
+
+void *operator new(size_t n)
+{
+    countAllocation();
+    if (void *p = std::malloc(n == 0 ? 1 : n))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+#ifdef __GLIBC__
+extern "C" {
+
+void *__libc_malloc(size_t);
+void *__libc_memalign(size_t, size_t);
+
+void *malloc(size_t n)
+{
+    countAllocation();
+    return __libc_malloc(n);
+}
+
+int posix_memalign(void **p, size_t alignment, size_t n)
+{
+    countAllocation();
+    *p = __libc_memalign(alignment, n);
+    return *p == nullptr ? ENOMEM : 0;
+}
+
+} // extern "C"
+#endif
+
+// Test outline
+//
+//### Processing loops draw temporaries from a FramePool
+//- Given a FramePool and a loop that needs a color and a grey temporary
+//    - When the loop has run once
+//        - Then, later iterations shall not allocate
+//        - Then, a released buffer shall be reused
+//    - When all buffers are in use
+//        - Then, acquire() shall throw
+//    - When the loop has run once and the pool is grown
+//        - Then, two loops can run at once
+
+const int rows {48};
+const int cols {64};
+
+SCENARIO ("Processing loops draw temporaries from a FramePool.", "[FramePool]") {
+
+    GIVEN ("A FramePool and a loop that needs a color and a grey temporary") {
+
+        oat::FramePool pool(2);
+        cv::Mat source(rows, cols, CV_8UC3);
+
+        auto iteration = [&] {
+            auto color = pool.acquire(rows, cols, CV_8UC3);
+            source.copyTo(color.frame());
+            auto grey = pool.acquire(rows, cols, CV_8UC1, oat::PIX_GREY);
+            grey.frame().data[0] = color.frame().data[0];
+        };
+
+        WHEN ("The loop has run once") {
+
+            iteration();
+            const auto warm = pool.allocations();
+
+            allocations_ = 0;
+            counting_ = true;
+            for (int i = 0; i < 100; i++)
+                iteration();
+            counting_ = false;
+
+            THEN ("Later iterations shall not allocate") {
+                REQUIRE( warm == 2 );
+                REQUIRE( pool.allocations() == warm );
+                REQUIRE( allocations_ == 0 );
+            }
+
+            THEN ("A released buffer shall be reused") {
+                uint8_t *data = nullptr;
+                {
+                    auto a = pool.acquire(rows, cols, CV_8UC1);
+                    data = a.frame().data;
+                }
+                auto b = pool.acquire(rows, cols, CV_8UC1);
+                REQUIRE( b.frame().data == data );
+                REQUIRE( b.frame().rows == rows );
+                REQUIRE( b.frame().cols == cols );
+                REQUIRE( b.frame().type() == CV_8UC1 );
+            }
+        }
+
+        WHEN ("All buffers are in use") {
+
+            auto a = pool.acquire(rows, cols, CV_8UC3);
+            auto b = pool.acquire(rows, cols, CV_8UC3);
+
+            THEN ("acquire() shall throw") {
+                REQUIRE_THROWS( pool.acquire(rows, cols, CV_8UC3); );
+                REQUIRE_THROWS( pool.acquire(rows, cols, CV_8UC1); );
+            }
+        }
+
+        WHEN ("The loop has run once and the pool is grown") {
+
+            iteration();
+            pool.reserve(4);
+
+            THEN ("Two loops can run at once") {
+                auto a = pool.acquire(rows, cols, CV_8UC3);
+                auto b = pool.acquire(rows, cols, CV_8UC1);
+                auto c = pool.acquire(rows, cols, CV_8UC3);
+                auto d = pool.acquire(rows, cols, CV_8UC1);
+                REQUIRE( pool.capacity() == 4 );
+                REQUIRE( pool.allocations() == 4 );
+                REQUIRE_THROWS( pool.acquire(rows, cols, CV_8UC1); );
+            }
+        }
+    }
+}
@@ -58,3 +58,171 @@ SCENARIO ("Sample period comparisons with epsilon tolerance.", "[Helpers]") {
         }
     }
 }
+
+// Sample with a given count and time
+oat::Sample makeSample(const uint64_t count, const int64_t usec)
+{
+    oat::Sample s;
+    for (uint64_t i = 0; i < count; i++)
+        s.incrementCount(std::chrono::microseconds(usec));
+    return s;
+}
+
+SCENARIO ("Samples from several sources are aligned by a synchronizer.", "[Helpers]") {
+
+    GIVEN ("A synchronizer matching two sources by sample count.") {
+
+        oat::SyncConfig config;
+        config.key = oat::SyncKey::COUNT;
+        config.window = 4;
+        oat::SampleSynchronizer sync(2, config);
+
+        // Payloads stored at the slots returned by push()
+        std::vector<std::vector<uint64_t>> held(2, std::vector<uint64_t>(4));
+        auto push = [&](size_t i, uint64_t count) {
+            const size_t slot = sync.push(i, makeSample(count, 0));
+            if (slot != oat::SampleSynchronizer::NO_SLOT)
+                held[i][slot] = count;
+            return slot != oat::SampleSynchronizer::NO_SLOT;
+        };
+
+        std::vector<size_t> slots;
+
+        WHEN ("Both sources deliver the same samples.") {
+
+            push(0, 1);
+            push(1, 1);
+
+            THEN ("The samples are emitted as a tuple.") {
+                REQUIRE (sync.pop(slots));
+                REQUIRE (held[0][slots[0]] == 1);
+                REQUIRE (held[1][slots[1]] == 1);
+                REQUIRE (!sync.pop(slots));
+                REQUIRE (sync.discarded() == 0);
+            }
+        }
+
+        WHEN ("Only one source has delivered a sample.") {
+
+            push(0, 1);
+
+            THEN ("No tuple is emitted.") {
+                REQUIRE (!sync.pop(slots));
+                REQUIRE (sync.discarded() == 0);
+            }
+        }
+
+        WHEN ("One source skips a sample.") {
+
+            push(0, 1);
+            push(0, 2);
+            push(0, 3);
+            push(1, 1);
+            push(1, 3);
+
+            THEN ("The unmatched sample is counted and later samples stay aligned.") {
+                REQUIRE (sync.pop(slots));
+                REQUIRE (held[0][slots[0]] == 1);
+                REQUIRE (held[1][slots[1]] == 1);
+                REQUIRE (sync.pop(slots));
+                REQUIRE (held[0][slots[0]] == 3);
+                REQUIRE (held[1][slots[1]] == 3);
+                REQUIRE (!sync.pop(slots));
+                REQUIRE (sync.mismatches() == 1);
+            }
+        }
+
+        WHEN ("A discard leaves one source ahead of the others.") {
+
+            push(0, 2);
+            push(1, 1);
+            push(1, 3);
+
+            THEN ("No tuple is emitted until the heads match.") {
+                REQUIRE (!sync.pop(slots));
+                REQUIRE (sync.mismatches() == 2);
+                push(0, 3);
+                REQUIRE (sync.pop(slots));
+                REQUIRE (held[0][slots[0]] == 3);
+                REQUIRE (held[1][slots[1]] == 3);
+            }
+        }
+
+        WHEN ("One source repeats a sample.") {
+
+            const bool first = push(0, 1);
+            const bool repeat = push(0, 1);
+            push(1, 1);
+
+            THEN ("The repeat is discarded.") {
+                REQUIRE (first);
+                REQUIRE (!repeat);
+                REQUIRE (sync.duplicates() == 1);
+                REQUIRE (sync.pop(slots));
+                REQUIRE (!sync.pop(slots));
+            }
+        }
+
+        WHEN ("One source runs further ahead than the window.") {
+
+            for (uint64_t c = 1; c <= 6; c++)
+                push(0, c);
+            push(1, 5);
+
+            THEN ("The oldest samples are dropped and the rest still match.") {
+                REQUIRE (sync.dropped() == 2);
+                REQUIRE (sync.pop(slots));
+                REQUIRE (held[0][slots[0]] == 5);
+                REQUIRE (held[1][slots[1]] == 5);
+                REQUIRE (sync.mismatches() == 2);
+            }
+        }
+
+        WHEN ("The number of discarded samples grows.") {
+
+            std::vector<uint64_t> due;
+            for (uint64_t c = 1; c <= 9; c++) {
+                push(0, c);
+                push(0, c); // Duplicate
+                if (sync.warningDue())
+                    due.push_back(sync.discarded());
+            }
+
+            THEN ("Warnings are due at powers of two.") {
+                REQUIRE (due == (std::vector<uint64_t>{1, 2, 4, 8}));
+            }
+        }
+    }
+
+    GIVEN ("A synchronizer matching two sources by time within 500 usec.") {
+
+        oat::SyncConfig config;
+        config.key = oat::SyncKey::MICROSECONDS;
+        config.tolerance = 500;
+        oat::SampleSynchronizer sync(2, config);
+        std::vector<size_t> slots;
+
+        WHEN ("The sources' sample times differ by less than the tolerance.") {
+
+            sync.push(0, makeSample(1, 100000));
+            sync.push(1, makeSample(1, 100400));
+
+            THEN ("The samples are emitted as a tuple.") {
+                REQUIRE (sync.pop(slots));
+            }
+        }
+
+        WHEN ("The sources' sample times differ by more than the tolerance.") {
+
+            sync.push(0, makeSample(1, 100000));
+            sync.push(1, makeSample(1, 133333));
+            sync.push(0, makeSample(2, 133500));
+
+            THEN ("The older sample is discarded and the next one matches.") {
+                REQUIRE (sync.pop(slots));
+                REQUIRE (slots[0] == 1);
+                REQUIRE (sync.mismatches() == 1);
+            }
+        }
+    }
+}
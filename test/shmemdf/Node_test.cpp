@@ -20,6 +20,10 @@
 #define CATCH_CONFIG_MAIN
 #include <catch.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 #include "../../lib/shmemdf/Node.h"
 
 // Global via extern in Globals.h
@@ -76,3 +80,506 @@ SCENARIO ("Nodes can accept up to Node::NUM_SLOTS sources.", "[Node]") {
         }
     }
 }
+
+SCENARIO ("Nodes can be resized to accept up to Node::MAX_SLOTS sources.", "[Node]") {
+
+    GIVEN ("A fresh Node") {
+
+        oat::Node node;
+        const size_t num_slots = oat::Node::NUM_SLOTS;
+        const size_t max_slots = oat::Node::MAX_SLOTS;
+        REQUIRE (node.num_slots() == num_slots);
+
+        WHEN ("the number of slots is set to 0 or more than Node::MAX_SLOTS") {
+
+            THEN ("The Node shall throw") {
+                REQUIRE_THROWS( node.set_num_slots(0); );
+                REQUIRE_THROWS( node.set_num_slots(oat::Node::MAX_SLOTS + 1); );
+            }
+        }
+
+        WHEN ("the number of slots is set to Node::MAX_SLOTS") {
+
+            node.set_num_slots(oat::Node::MAX_SLOTS);
+
+            THEN ("The Node shall accept sources until the Node::MAX_SLOTS+1'th") {
+                size_t idx;
+                for (size_t i = 0; i <= oat::Node::MAX_SLOTS; i++) {
+                    if (i < oat::Node::MAX_SLOTS) {
+                        REQUIRE (node.acquireSlot(idx) == 0);
+                        REQUIRE (idx == i);
+                    } else {
+                        REQUIRE (node.acquireSlot(idx) < 0);
+                    }
+                }
+                REQUIRE (node.source_ref_count() == max_slots);
+            }
+
+            THEN ("each source shall be woken by a write") {
+                size_t idx;
+                for (size_t i = 0; i < oat::Node::MAX_SLOTS; i++)
+                    node.acquireSlot(idx);
+
+                node.notifySinkWriteComplete();
+
+                for (size_t i = 0; i < oat::Node::MAX_SLOTS; i++)
+                    REQUIRE (node.read_barrier(i).try_wait());
+            }
+        }
+
+        WHEN ("more sources are attached than the requested number of slots") {
+
+            size_t idx;
+            for (size_t i = 0; i < 4; i++)
+                node.acquireSlot(idx);
+
+            THEN ("The Node shall throw and keep its number of slots") {
+                REQUIRE_THROWS( node.set_num_slots(3); );
+                REQUIRE (node.num_slots() == num_slots);
+            }
+        }
+    }
+}
+
+SCENARIO ("Nodes hold a ring of up to Node::MAX_RING_DEPTH slots.", "[Node]") {
+
+    GIVEN ("A fresh Node") {
+
+        oat::Node node;
+        REQUIRE (node.ring_depth() == 1);
+
+        WHEN ("the ring depth is set to 0 or more than Node::MAX_RING_DEPTH") {
+
+            THEN ("The Node shall throw") {
+                REQUIRE_THROWS( node.set_ring_depth(0); );
+                REQUIRE_THROWS( node.set_ring_depth(oat::Node::MAX_RING_DEPTH + 1); );
+            }
+        }
+
+        WHEN ("the ring depth is set after a write") {
+
+            node.notifySinkWriteComplete();
+
+            THEN ("The Node shall throw") {
+                REQUIRE_THROWS( node.set_ring_depth(2); );
+            }
+        }
+    }
+
+    GIVEN ("A Node with ring depth 3 and a single blocking source") {
+
+        oat::Node node;
+        node.set_ring_depth(3);
+
+        size_t idx;
+        node.acquireSlot(idx);
+
+        WHEN ("the sink writes 3 times without the source reading") {
+
+            for (int i = 0; i < 3; i++) {
+                REQUIRE (node.writeSlotAvailable());
+                node.notifySinkWriteComplete();
+            }
+
+            THEN ("the next ring slot shall be unavailable to the sink") {
+                REQUIRE (node.write_index() == 0);
+                REQUIRE_FALSE (node.writeSlotAvailable());
+            }
+
+            THEN ("the source shall read each ring slot in order") {
+                for (size_t i = 0; i < 3; i++) {
+                    REQUIRE (node.read_index(idx) == i);
+                    node.notifySourceReadComplete(idx);
+                }
+            }
+
+            THEN ("the oldest ring slot shall become available once it is read") {
+                node.notifySourceReadComplete(idx);
+                REQUIRE (node.writeSlotAvailable());
+            }
+
+            THEN ("the source shall be told to wake the sink only if the sink is waiting") {
+                REQUIRE (node.announceSinkWait());
+                REQUIRE (node.notifySourceReadComplete(idx));
+                REQUIRE_FALSE (node.announceSinkWait());
+            }
+
+            THEN ("the ring shall become available if the source leaves") {
+                node.releaseSlot(idx);
+                REQUIRE (node.writeSlotAvailable());
+            }
+        }
+    }
+
+    GIVEN ("A Node with ring depth 2 and a single non-blocking source") {
+
+        oat::Node node;
+        node.set_ring_depth(2);
+
+        size_t idx;
+        node.acquireSlot(idx, false);
+
+        WHEN ("the sink writes 5 times without the source reading") {
+
+            for (int i = 0; i < 5; i++) {
+                REQUIRE (node.writeSlotAvailable());
+                node.notifySinkWriteComplete();
+            }
+
+            THEN ("the source shall catch up to the most recent write") {
+                REQUIRE (node.read_barrier(idx).try_wait());
+                node.catchUp(idx);
+                REQUIRE_FALSE (node.read_barrier(idx).try_wait());
+                REQUIRE (node.read_index(idx) == 0);
+                REQUIRE_FALSE (node.notifySourceReadComplete(idx));
+            }
+        }
+    }
+}
+
+SCENARIO ("Nodes let observers check copies of the most recent write.", "[Node]") {
+
+    GIVEN ("A Node with ring depth 1 and a completed write") {
+
+        oat::Node node;
+        node.notifySinkWriteBegin();
+        node.notifySinkWriteComplete();
+        const uint64_t n = node.write_number();
+
+        WHEN ("the sink has not started another write") {
+            THEN ("a copy of the most recent write shall be valid") {
+                REQUIRE (node.snapshotValid(n));
+            }
+        }
+
+        WHEN ("the sink starts another write") {
+            node.notifySinkWriteBegin();
+            THEN ("a copy of the most recent write shall be invalid") {
+                REQUIRE_FALSE (node.snapshotValid(n));
+            }
+        }
+    }
+
+    GIVEN ("A Node with ring depth 3 and a completed write") {
+
+        oat::Node node;
+        node.set_ring_depth(3);
+        node.notifySinkWriteBegin();
+        node.notifySinkWriteComplete();
+        const uint64_t n = node.write_number();
+
+        WHEN ("the sink writes the other ring slots") {
+
+            for (int i = 0; i < 2; i++) {
+                node.notifySinkWriteBegin();
+                node.notifySinkWriteComplete();
+            }
+
+            THEN ("a copy of the first write shall be valid") {
+                REQUIRE (node.snapshotValid(n));
+            }
+
+            AND_WHEN ("the sink starts to overwrite the first write's slot") {
+                node.notifySinkWriteBegin();
+                THEN ("a copy of the first write shall be invalid") {
+                    REQUIRE_FALSE (node.snapshotValid(n));
+                }
+            }
+        }
+    }
+}
+
+SCENARIO ("Nodes keep read telemetry.", "[Node]") {
+
+    GIVEN ("A Node with ring depth 2, a blocking and a non-blocking source") {
+
+        oat::Node node;
+        node.set_ring_depth(2);
+
+        size_t b_idx, nb_idx;
+        node.acquireSlot(b_idx);
+        node.acquireSlot(nb_idx, false);
+
+        REQUIRE (node.source_slots() == 3);
+        REQUIRE (node.blocking_slots() == 1);
+
+        WHEN ("the sink writes twice") {
+
+            node.notifySinkWriteComplete();
+            node.notifySinkWriteComplete();
+
+            THEN ("each source shall be two reads behind") {
+                REQUIRE (node.reads_behind(b_idx) == 2);
+                REQUIRE (node.reads_behind(nb_idx) == 2);
+            }
+
+            AND_WHEN ("each source reads once") {
+
+                node.notifySourceReadComplete(b_idx);
+                node.notifySourceReadComplete(nb_idx);
+
+                THEN ("each source's read latency shall be recorded") {
+                    REQUIRE (node.reads_behind(b_idx) == 1);
+                    REQUIRE (node.source_stats[b_idx].latency.snapshot().count() == 1);
+                    REQUIRE (node.source_stats[nb_idx].latency.snapshot().count() == 1);
+                }
+
+                THEN ("only the blocking source's read shall count as the last read") {
+                    REQUIRE (node.sink_stats.last_read.snapshot().count() == 1);
+                }
+
+                AND_WHEN ("a new source takes the blocking source's slot") {
+
+                    node.releaseSlot(b_idx);
+                    size_t idx;
+                    node.acquireSlot(idx);
+
+                    THEN ("the slot's telemetry shall be cleared") {
+                        REQUIRE (idx == b_idx);
+                        REQUIRE (node.reads_behind(idx) == 0);
+                        REQUIRE (node.source_stats[idx].latency.snapshot().count() == 0);
+                    }
+                }
+            }
+        }
+    }
+}
+
+SCENARIO ("Nodes keep each process's telemetry on its own cache lines.", "[Node]") {
+
+    GIVEN ("A Node") {
+
+        oat::Node node;
+        const char *base = reinterpret_cast<const char *>(&node);
+        auto offset = [base](const void *member) {
+            return static_cast<const char *>(member) - base;
+        };
+
+        THEN ("the sink's and each source's telemetry shall start a whole number of cache lines into the node") {
+            REQUIRE (offset(&node.sink_stats) % 64 == 0);
+            for (size_t i = 0; i < oat::Node::MAX_SLOTS; i++)
+                REQUIRE (offset(&node.source_stats[i]) % 64 == 0);
+            REQUIRE (offset(&node.write_barrier) % 64 == 0);
+            REQUIRE (offset(&node.write_barrier) - offset(&node.sink_stats)
+                     >= static_cast<std::ptrdiff_t>(sizeof(node.sink_stats)
+                                                    + sizeof(node.source_stats)));
+        }
+    }
+}
+
+SCENARIO ("LatencyHistograms bin durations by powers of two.", "[Node]") {
+
+    GIVEN ("A LatencyHistogram") {
+
+        oat::LatencyHistogram hist;
+
+        WHEN ("durations of 0.5, 3, 3, 3 and 1000 usec are added") {
+
+            hist.add(500);
+            for (int i = 0; i < 3; i++)
+                hist.add(3000);
+            hist.add(1000000);
+
+            auto s = hist.snapshot();
+
+            THEN ("the count, mean and percentiles shall match") {
+                REQUIRE (s.count() == 5);
+                REQUIRE (s.total_ns == 1009500);
+                REQUIRE (s.percentile_us(0.1) == 1.0);
+                REQUIRE (s.percentile_us(0.5) == 4.0);
+                REQUIRE (s.percentile_us(1.0) == 1024.0);
+            }
+
+            THEN ("a later snapshot minus this one shall hold only later durations") {
+                hist.add(3000);
+                auto d = hist.snapshot() - s;
+                REQUIRE (d.count() == 1);
+                REQUIRE (d.total_ns == 3000);
+                REQUIRE (d.mean_us() == 3.0);
+            }
+        }
+
+        WHEN ("a very long duration is added") {
+
+            hist.add(3600ull * 1000000000ull);
+
+            THEN ("it shall fall in the last bin") {
+                const size_t last = oat::HistogramSnapshot::NUM_BINS - 1;
+                REQUIRE (hist.snapshot().bins[last] == 1);
+            }
+        }
+    }
+}
+
+SCENARIO ("Nodes evict sources that hold up the sink.", "[Node]") {
+
+    GIVEN ("A Node with a blocking source that has not read the last write") {
+
+        oat::Node node;
+
+        size_t idx;
+        node.acquireSlot(idx);
+        node.notifySinkWriteComplete();
+
+        REQUIRE (node.slot_pid(idx) == getpid());
+        REQUIRE_FALSE (node.writeSlotAvailable());
+
+        WHEN ("the source's process is alive and no deadline is given") {
+
+            THEN ("the source shall not be evicted") {
+                REQUIRE (node.evictStaleReaders(0) == 0);
+                REQUIRE_FALSE (node.writeSlotAvailable());
+            }
+        }
+
+        WHEN ("the source has not posted for longer than the deadline") {
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            const size_t evicted = node.evictStaleReaders(1000000);
+
+            THEN ("the source shall be made non-blocking") {
+                REQUIRE (evicted == 1);
+                REQUIRE (node.sink_stats.evictions == 1);
+                REQUIRE (node.writeSlotAvailable());
+                REQUIRE (node.blocking_slots() == 0);
+                REQUIRE (node.source_ref_count() == 1);
+            }
+
+            THEN ("the source shall find out a single time") {
+                REQUIRE (node.acknowledgeEviction(idx));
+                REQUIRE_FALSE (node.acknowledgeEviction(idx));
+            }
+        }
+
+        WHEN ("the source posted within the deadline") {
+
+            node.heartbeat(idx);
+
+            THEN ("the source shall not be evicted") {
+                REQUIRE (node.evictStaleReaders(1000000000) == 0);
+                REQUIRE_FALSE (node.writeSlotAvailable());
+            }
+        }
+    }
+}
+
+SCENARIO ("Nodes do not wait for sources that leave during a write.", "[Node]") {
+
+    GIVEN ("A Node with a sink that writes whenever it may") {
+
+        oat::Node node;
+        std::atomic<bool> done {false};
+
+        WHEN ("blocking sources repeatedly attach and leave without reading") {
+
+            std::thread sink([&] {
+                while (!done) {
+                    if (node.writeSlotAvailable())
+                        node.notifySinkWriteComplete();
+                }
+            });
+
+            size_t idx;
+            for (int i = 0; i < 200000; i++) {
+                node.acquireSlot(idx);
+                node.releaseSlot(idx);
+            }
+
+            done = true;
+            sink.join();
+
+            THEN ("the sink shall not be left waiting for a departed source") {
+                REQUIRE (node.source_ref_count() == 0);
+                REQUIRE (node.writeSlotAvailable());
+            }
+        }
+    }
+}
+
+SCENARIO ("Drop-oldest nodes protect a slot that a source is catching up to.", "[Node]") {
+
+    GIVEN ("A drop-oldest Node with ring depth 2 and a source that read the "
+           "first write") {
+
+        oat::Node node;
+        node.set_ring_depth(2);
+        node.set_backpressure(oat::BackpressurePolicy::DROP_OLDEST);
+
+        size_t idx;
+        node.acquireSlot(idx);
+
+        node.notifySinkWriteComplete();
+        node.catchUp(idx);
+        node.notifySourceReadComplete(idx);
+
+        // The sink completes two more writes and starts the fourth, which
+        // leaves the source's read cursor two writes behind
+        node.notifySinkWriteComplete();
+        node.notifySinkWriteComplete();
+        REQUIRE_FALSE (node.writeSlotBlocked());
+        node.notifySinkWriteBegin();
+
+        WHEN ("the source is preempted while catching up until the sink "
+              "completes the fourth write and starts the fifth") {
+
+            // The sink cannot see the new read cursor yet
+            bool blocked = true;
+            node.catchUp(idx, [&] {
+                node.notifySinkWriteComplete();
+                blocked = node.writeSlotBlocked();
+                node.notifySinkWriteBegin();
+            });
+
+            THEN ("the source shall not read the slot that the sink writes") {
+                REQUIRE_FALSE (blocked);
+                REQUIRE (node.read_index(idx) != node.write_index());
+            }
+        }
+    }
+}
+
+SCENARIO ("Nodes one slot deep protect the slot that a non-blocking source reads.", "[Node]") {
+
+    GIVEN ("A Node with ring depth 1, a non-blocking source and a "
+           "completed write") {
+
+        oat::Node node;
+
+        size_t idx;
+        node.acquireSlot(idx, false);
+        node.notifySinkWriteComplete();
+
+        WHEN ("the sink starts the next write while the source catches up") {
+
+            // The sink checked for readers before the source marked its
+            // read. Then it waits for readers like Sink<T>::wait(). The
+            // source calls the hook again once it has stood aside.
+            REQUIRE_FALSE (node.writeSlotBlocked());
+            std::thread sink;
+            node.catchUp(idx, [&] {
+                if (sink.joinable())
+                    return;
+                sink = std::thread([&] {
+                    node.notifySinkWriteBegin();
+                    while (node.writeSlotRaced()) {
+                        while (node.writeSlotBlocked())
+                            std::this_thread::yield();
+                        node.notifySinkWriteBegin();
+                    }
+                    node.notifySinkWriteComplete();
+                });
+                while (node.snapshotValid(node.write_number()))
+                    std::this_thread::yield();
+            });
+            sink.join();
+
+            THEN ("the source shall wait for the write and read it") {
+                REQUIRE (node.write_number() == 2);
+                REQUIRE (node.read_index(idx) == 0);
+                REQUIRE (node.writeSlotBlocked());
+                REQUIRE_FALSE (node.notifySourceReadComplete(idx));
+                REQUIRE_FALSE (node.writeSlotBlocked());
+            }
+        }
+    }
+}
@@ -0,0 +1,156 @@
+//******************************************************************************
+//* File:   PositionJSON_test.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include "../../lib/datatypes/PositionJSON.h"
+#include "../../lib/datatypes/PositionList.h"
+
+// Test outline
+//
+//### Positions serialize to the same JSON as rapidjson::Writer
+//- Given positions with every combination of valid fields and awkward values
+//    - When they are serialized concisely and verbosely
+//        - Then, the output is byte-identical to serializePosition()
+//    - When a list of them is serialized
+//        - Then, the output is byte-identical to serializePosition()
+//    - When a long list follows a short one
+//        - Then, the reused buffer holds only the last serialization
+
+// Reference serialization
+template <typename T>
+std::string rapidJSON(const T &p, bool verbose)
+{
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    oat::serializePosition(p, writer, verbose);
+    return std::string(buffer.GetString(), buffer.GetSize());
+}
+
+static std::vector<oat::Position2D> positions()
+{
+    const double values[] = {0.0,
+                             -0.0,
+                             1.0,
+                             -2.5,
+                             0.1,
+                             1.0 / 3.0,
+                             123456.789012345,
+                             1e-7,
+                             -4.2e21,
+                             1e300,
+                             std::numeric_limits<double>::quiet_NaN(),
+                             std::numeric_limits<double>::infinity()};
+    const char *regions[]
+        = {"", "North", "\"q\\\"", "a\tb\nc\x01", "012345678"};
+
+    oat::Sample sample;
+    sample.incrementCount(oat::Sample::Microseconds(1234567));
+
+    std::vector<oat::Position2D> ps;
+    const size_t n = sizeof(values) / sizeof(values[0]);
+    for (size_t i = 0; i < 16 * n; i++) {
+
+        oat::Position2D p;
+        p.set_sample(sample);
+        p.position_valid = i & 1;
+        p.velocity_valid = i & 2;
+        p.heading_valid = i & 4;
+        p.region_valid = i & 8;
+
+        p.position.x = values[i % n];
+        p.position.y = values[(i + 1) % n];
+        p.velocity.x = values[(i + 2) % n];
+        p.velocity.y = values[(i + 3) % n];
+        p.heading.x = values[(i + 5) % n];
+        p.heading.y = values[(i + 7) % n];
+
+        std::strncpy(p.region, regions[i % 5], sizeof(p.region));
+
+        ps.push_back(p);
+        sample.incrementCount(oat::Sample::Microseconds(1234567 + i * 33));
+    }
+
+    return ps;
+}
+
+SCENARIO ("Positions serialize to the same JSON as rapidjson::Writer.", "[PositionJSON]") {
+
+    GIVEN ("Positions with every combination of valid fields and awkward values") {
+
+        const auto ps = positions();
+
+        WHEN ("They are serialized concisely and verbosely") {
+
+            THEN ("The output is byte-identical to serializePosition()") {
+                for (bool verbose : {false, true}) {
+                    oat::PositionJSON json(verbose);
+                    for (const auto &p : ps) {
+                        json.serialize(p);
+                        REQUIRE( json.str() == rapidJSON(p, verbose) );
+                    }
+                }
+            }
+        }
+
+        WHEN ("A list of them is serialized") {
+
+            oat::PositionList list;
+            for (uint32_t i = 0; i < oat::PositionList::MAX_SIZE; i++)
+                list.push_back(ps[i * 3], i * 1000003);
+
+            THEN ("The output is byte-identical to serializePosition()") {
+                for (bool verbose : {false, true}) {
+                    oat::PositionJSON json(verbose);
+                    json.serialize(list);
+                    REQUIRE( json.str() == rapidJSON(list, verbose) );
+                }
+
+                oat::PositionList empty;
+                oat::PositionJSON json;
+                json.serialize(empty);
+                REQUIRE( json.str() == rapidJSON(empty, false) );
+            }
+        }
+
+        WHEN ("A long list follows a short one") {
+
+            oat::PositionList list;
+            oat::PositionJSON json;
+            json.serialize(ps[0]);
+            for (uint32_t i = 0; i < oat::PositionList::MAX_SIZE; i++)
+                list.push_back(ps[i], i);
+            json.serialize(list);
+            json.serialize(ps[1]);
+
+            THEN ("The reused buffer holds only the last serialization") {
+                REQUIRE( json.str() == rapidJSON(ps[1], false) );
+            }
+        }
+    }
+}
@@ -0,0 +1,248 @@
+//******************************************************************************
+//* File:   PositionList_test.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../../lib/datatypes/PositionList.h"
+#include "../../lib/shmemdf/Sink.h"
+#include "../../lib/shmemdf/Source.h"
+
+const std::string node_addr = "test";
+
+// Global via extern in Globals.h
+namespace oat { volatile sig_atomic_t quit = 0; }
+
+// Test outline
+//
+//### Position lists hold a fixed number of positions
+//- Given an empty list with a sample
+//    - When positions are appended
+//        - Then, they take the list's sample and keep their ids
+//        - Then, positions beyond the list's capacity are discarded
+//    - When the list is copied
+//        - Then, the copy holds the same positions and ids
+//
+//### Positions pack into binary records laid out as their dtype
+//- Given a position and a list holding it twice
+//    - When the position is packed
+//        - Then, each field is at the offset given by the dtype
+//    - When an array of positions is packed at once
+//        - Then, each record is the same as if it was packed alone
+//    - When the list is packed
+//        - Then, used entries hold the positions and unused ones are invalid
+//
+//### Position lists can be shared between a sink and a source
+//- Given a Sink<PositionList> and a connected Source<PositionList>
+//    - When the sink writes a list of three positions
+//        - Then, the source reads the same list
+
+SCENARIO ("Position lists hold a fixed number of positions.", "[PositionList]") {
+
+    GIVEN ("An empty list with a sample") {
+
+        oat::Sample sample;
+        sample.incrementCount(oat::Sample::Microseconds(1000));
+
+        oat::PositionList list;
+        list.set_sample(sample);
+        REQUIRE( list.empty() );
+
+        oat::Position2D p;
+        p.position_valid = true;
+
+        WHEN ("Positions are appended") {
+
+            for (uint32_t i = 0; i < 3; i++) {
+                p.position.x = i;
+                REQUIRE( list.push_back(p, 10 + i) );
+            }
+
+            THEN ("They take the list's sample and keep their ids") {
+                REQUIRE( list.size() == 3 );
+                for (size_t i = 0; i < list.size(); i++) {
+                    REQUIRE( list.id(i) == 10 + i );
+                    REQUIRE( list[i].position.x == i );
+                    REQUIRE( list[i].sample_count() == 1 );
+                    REQUIRE( list[i].sample_usec() == 1000 );
+                }
+            }
+
+            THEN ("Positions beyond the list's capacity are discarded") {
+                const size_t max_size = oat::PositionList::MAX_SIZE;
+                while (list.size() < max_size)
+                    REQUIRE( list.push_back(p, 0) );
+                REQUIRE_FALSE( list.push_back(p, 0) );
+                REQUIRE( list.size() == max_size );
+            }
+        }
+
+        WHEN ("The list is copied") {
+
+            p.position.y = 7;
+            list.push_back(p, 3);
+            list.push_back(p, 5);
+
+            oat::PositionList copy;
+            copy = list;
+
+            THEN ("The copy holds the same positions and ids") {
+                REQUIRE( copy.size() == 2 );
+                REQUIRE( copy.id(0) == 3 );
+                REQUIRE( copy.id(1) == 5 );
+                REQUIRE( copy[1].position.y == 7 );
+                REQUIRE( copy[1].position_valid );
+                REQUIRE( copy.sample_usec() == 1000 );
+            }
+        }
+    }
+}
+
+// Field of a packed record at the offset given by the dtype
+template <typename F>
+F field(const char *record, const char *dtype, const char *name)
+{
+    F f;
+    std::memcpy(&f, record + oat::npy::offset(dtype, name), sizeof(f));
+    return f;
+}
+
+SCENARIO ("Positions pack into binary records laid out as their dtype.", "[PositionList]") {
+
+    GIVEN ("A position and a list holding it twice") {
+
+        const char *dtype = oat::Position2D::NPY_DTYPE;
+        const size_t bytes = oat::Position2D::NPY_DTYPE_BYTES;
+
+        oat::Sample sample;
+        sample.incrementCount(oat::Sample::Microseconds(2000));
+
+        oat::Position2D p;
+        p.set_sample(sample);
+        p.position_valid = true;
+        p.position.x = 1.5;
+        p.position.y = -2.5;
+        p.heading_valid = true;
+        p.heading.y = 1.0;
+        std::strcpy(p.region, "North");
+
+        oat::PositionList list;
+        list.set_sample(sample);
+        list.push_back(p, 4);
+        list.push_back(p, 9);
+
+        WHEN ("The position is packed") {
+
+            std::vector<char> r(bytes);
+            oat::packPosition(p, r.data());
+
+            THEN ("Each field is at the offset given by the dtype") {
+                REQUIRE( field<uint64_t>(r.data(), dtype, "tick") == 1 );
+                REQUIRE( field<uint64_t>(r.data(), dtype, "usec") == 2000 );
+                REQUIRE( field<int8_t>(r.data(), dtype, "pos_ok") == 1 );
+                REQUIRE( field<double>(r.data(), dtype, "pos_xy") == 1.5 );
+                REQUIRE( field<int8_t>(r.data(), dtype, "vel_ok") == 0 );
+                REQUIRE( field<int8_t>(r.data(), dtype, "head_ok") == 1 );
+                REQUIRE( std::string(r.data() + oat::npy::offset(dtype, "reg"))
+                         == "North" );
+
+                double y;
+                std::memcpy(&y, r.data() + oat::npy::offset(dtype, "pos_xy")
+                            + sizeof(double), sizeof(y));
+                REQUIRE( y == -2.5 );
+            }
+        }
+
+        WHEN ("An array of positions is packed at once") {
+
+            const oat::Position2D ps[3] = {p, oat::Position2D(), p};
+            std::vector<char> batch(3 * bytes), single(bytes);
+            oat::packPositions(ps, 3, batch.data());
+
+            THEN ("Each record is the same as if it was packed alone") {
+                for (size_t i = 0; i < 3; i++) {
+                    oat::packPosition(ps[i], single.data());
+                    REQUIRE( std::memcmp(batch.data() + i * bytes,
+                                         single.data(), bytes) == 0 );
+                }
+            }
+        }
+
+        WHEN ("The list is packed") {
+
+            std::vector<char> r(oat::PositionList::NPY_DTYPE_BYTES);
+            oat::packPosition(list, r.data());
+
+            oat::PackedPositionList packed;
+            std::memcpy(&packed, r.data(), sizeof(packed));
+
+            THEN ("Used entries hold the positions and unused ones are invalid") {
+                REQUIRE( packed.tick == 1 );
+                REQUIRE( packed.n == 2 );
+                REQUIRE( packed.ids[1] == 9 );
+                REQUIRE( packed.positions[1].pos_ok == 1 );
+                REQUIRE( packed.positions[1].pos_xy[1] == -2.5 );
+                REQUIRE( packed.positions[2].pos_ok == 0 );
+                REQUIRE( packed.ids[2] == 0 );
+            }
+        }
+    }
+}
+
+SCENARIO ("Position lists can be shared between a sink and a source.", "[PositionList]") {
+
+    GIVEN ("A Sink<PositionList> and a connected Source<PositionList>") {
+
+        oat::Sink<oat::PositionList> sink;
+        sink.bind(node_addr);
+        oat::PositionList *shared = sink.retrieve();
+
+        oat::Source<oat::PositionList> source;
+        source.touch(node_addr);
+        source.connect();
+
+        WHEN ("The sink writes a list of three positions") {
+
+            oat::PositionList list;
+            oat::Position2D p;
+            for (uint32_t i = 0; i < 3; i++) {
+                p.position.x = i;
+                list.push_back(p, i);
+            }
+
+            REQUIRE( sink.wait() );
+            *shared = list;
+            sink.post();
+
+            THEN ("The source reads the same list") {
+                source.wait();
+                const oat::PositionList read = source.clone();
+                source.post();
+
+                REQUIRE( read.size() == 3 );
+                REQUIRE( read.id(2) == 2 );
+                REQUIRE( read[2].position.x == 2 );
+            }
+        }
+    }
+}
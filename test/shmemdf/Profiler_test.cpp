@@ -0,0 +1,292 @@
+//******************************************************************************
+//* File:   Profiler_test.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "../../lib/base/Profiler.h"
+#include "../../lib/shmemdf/Sink.h"
+#include "../../lib/shmemdf/Source.h"
+
+const std::string node_addr = "test";
+
+// Global via extern in Globals.h
+namespace oat { volatile sig_atomic_t quit = 0; }
+
+// Test outline
+//
+//### Profile histograms bin durations to within a few percent
+//- Given durations spread over many orders of magnitude
+//    - Then, each falls in a bin whose edges contain it
+//    - Then, bins are contiguous
+//- Given a histogram of 1000 durations
+//    - Then, percentiles are within a bin of the exact value
+//
+//### Profilers split iterations into stages
+//- Given a profiled thread with a Sink<int> and a connected Source<int>
+//    - When each iteration reads, computes and writes
+//        - Then, each stage is counted once per iteration
+//        - Then, time spent between wait() and post() is a critical section
+//        - Then, the stages add up to the iteration
+//    - When the thread is not profiled
+//        - Then, nothing is recorded
+//
+//### Samples carry a latency trace
+//- Given a sample
+//    - When it is stamped more times than the trace holds
+//        - Then, the last stamp is kept
+//    - When its count is incremented
+//        - Then, the trace is cleared
+//- Given two sinks of a type that carries a sample, connected by a source
+//    - When a sample is published by both, the second on a profiled thread
+//        - Then, each sink added one stamp
+//        - Then, the profiler has the latency of the hop between them
+
+SCENARIO ("Profile histograms bin durations to within a few percent.", "[Profiler]") {
+
+    GIVEN ("Durations spread over many orders of magnitude") {
+
+        const uint64_t ns[] = {0, 1, 15, 16, 17, 31, 32, 100, 999, 1000,
+                               123456, 1000000, 987654321, 10000000000ull};
+
+        const size_t num_bins = oat::ProfileHistogram::NUM_BINS;
+
+        THEN ("Each falls in a bin whose edges contain it") {
+            for (auto n : ns) {
+                const size_t b = oat::ProfileHistogram::bin(n);
+                REQUIRE( b < num_bins );
+                REQUIRE( oat::ProfileHistogram::lower_ns(b) <= n );
+                REQUIRE( n < oat::ProfileHistogram::upper_ns(b) );
+                REQUIRE( oat::ProfileHistogram::upper_ns(b)
+                         - oat::ProfileHistogram::lower_ns(b)
+                         <= 1 + n / 16 );
+            }
+        }
+
+        THEN ("Bins are contiguous") {
+            for (size_t b = 0; b + 1 < num_bins; b++)
+                REQUIRE( oat::ProfileHistogram::upper_ns(b)
+                         == oat::ProfileHistogram::lower_ns(b + 1) );
+        }
+    }
+
+    GIVEN ("A histogram of 1000 durations") {
+
+        oat::ProfileHistogram h;
+        for (uint64_t i = 1; i <= 1000; i++)
+            h.add(i * 1000);
+
+        THEN ("Percentiles are within a bin of the exact value") {
+            REQUIRE( h.count() == 1000 );
+            REQUIRE( h.max_ns() == 1000000 );
+            REQUIRE( h.total_ns() == 500500000 );
+            REQUIRE( h.percentile_ns(0.5) >= 500000 );
+            REQUIRE( h.percentile_ns(0.5) <= 500000 + 500000 / 16 );
+            REQUIRE( h.percentile_ns(0.99) >= 990000 );
+            REQUIRE( h.percentile_ns(0.99) <= 1000000 );
+            REQUIRE( h.percentile_ns(1.0) == 1000000 );
+        }
+    }
+}
+
+SCENARIO ("Profilers split iterations into stages.", "[Profiler]") {
+
+    GIVEN ("A profiled thread with a Sink<int> and a connected Source<int>") {
+
+        oat::Sink<int> sink;
+        sink.bind(node_addr + "_in");
+
+        oat::Source<int> source;
+        source.touch(node_addr + "_in");
+        source.connect();
+
+        oat::Sink<int> out;
+        out.bind(node_addr + "_out");
+
+        oat::Profiler profiler;
+        const auto ms = std::chrono::milliseconds(1);
+
+        WHEN ("Each iteration reads, computes and writes") {
+
+            oat::Profiler::set_current(&profiler);
+
+            for (int i = 0; i < 4; i++) {
+
+                // Not part of the profiled component
+                oat::Profiler::set_current(nullptr);
+                REQUIRE( sink.wait() );
+                *sink.retrieve() = i;
+                sink.post();
+                oat::Profiler::set_current(&profiler);
+
+                profiler.beginIteration();
+
+                source.wait();
+                const int v = *source.retrieve();
+                std::this_thread::sleep_for(ms);
+                source.post();
+
+                std::this_thread::sleep_for(2 * ms);
+
+                REQUIRE( out.wait() );
+                *out.retrieve() = v;
+                std::this_thread::sleep_for(ms);
+                out.post();
+
+                profiler.endIteration();
+            }
+
+            oat::Profiler::set_current(nullptr);
+
+            THEN ("Each stage is counted once per iteration") {
+                for (size_t s = 0; s < oat::Profiler::NUM_STAGES; s++)
+                    REQUIRE( profiler.stage(static_cast<oat::Profiler::Stage>(s))
+                             .count() == 4 );
+                REQUIRE( profiler.iterations().count() == 4 );
+            }
+
+            THEN ("Time spent between wait() and post() is a critical section") {
+                REQUIRE( profiler.stage(oat::Profiler::SOURCE_CRITICAL).total_ns() >= 4000000 );
+                REQUIRE( profiler.stage(oat::Profiler::COMPUTE).total_ns() >= 8000000 );
+                REQUIRE( profiler.stage(oat::Profiler::SINK_CRITICAL).total_ns() >= 4000000 );
+            }
+
+            THEN ("The stages add up to the iteration") {
+                uint64_t total = 0;
+                for (size_t s = 0; s < oat::Profiler::NUM_STAGES; s++)
+                    total += profiler.stage(static_cast<oat::Profiler::Stage>(s))
+                             .total_ns();
+                REQUIRE( total == profiler.iterations().total_ns() );
+
+                const std::string json = profiler.toJSON("test");
+                REQUIRE( json.find("\"source_critical\":{\"count\":4") != std::string::npos );
+            }
+        }
+
+        WHEN ("The thread is not profiled") {
+
+            REQUIRE( sink.wait() );
+            sink.post();
+            source.wait();
+            source.post();
+
+            THEN ("Nothing is recorded") {
+                REQUIRE( profiler.iterations().count() == 0 );
+                REQUIRE( profiler.stage(oat::Profiler::SOURCE_WAIT).count() == 0 );
+            }
+        }
+    }
+}
+
+// Shared type that carries a sample
+struct Stamped {
+    oat::Sample &sample() { return sample_; }
+    oat::Sample sample_;
+};
+
+SCENARIO ("Samples carry a latency trace.", "[Profiler]") {
+
+    GIVEN ("A sample") {
+
+        oat::Sample sample;
+        const size_t max_stamps = oat::Sample::MAX_STAMPS;
+
+        WHEN ("It is stamped more times than the trace holds") {
+
+            for (uint64_t i = 0; i < max_stamps + 2; i++)
+                sample.stamp(1000 + 10 * i);
+
+            THEN ("The last stamp is kept") {
+                REQUIRE( sample.num_stamps() == max_stamps );
+                REQUIRE( sample.stamp_ns(0) == 1000 );
+                REQUIRE( sample.stamp_ns(1) == 1010 );
+                REQUIRE( sample.stamp_ns(max_stamps - 1)
+                         == 1000 + 10 * (max_stamps + 1) );
+            }
+        }
+
+        WHEN ("Its count is incremented") {
+
+            sample.stamp(1000);
+            sample.incrementCount();
+
+            THEN ("The trace is cleared") {
+                REQUIRE( sample.num_stamps() == 0 );
+            }
+        }
+    }
+
+    GIVEN ("Two sinks of a type that carries a sample, connected by a source") {
+
+        oat::Sink<Stamped> first;
+        first.bind(node_addr);
+
+        oat::Source<Stamped> source;
+        source.touch(node_addr);
+        source.connect();
+
+        oat::Sink<Stamped> second;
+        second.bind(node_addr + "2");
+
+        WHEN ("A sample is published by both, the second on a profiled thread") {
+
+            const auto ms = std::chrono::milliseconds(2);
+
+            REQUIRE( first.wait() );
+            first.retrieve()->sample().incrementCount();
+            first.post();
+
+            source.wait();
+            const oat::Sample sample = source.retrieve()->sample_;
+            source.post();
+
+            std::this_thread::sleep_for(ms);
+
+            oat::Profiler profiler;
+            oat::Profiler::set_current(&profiler);
+            REQUIRE( second.wait() );
+            second.retrieve()->sample_ = sample;
+            second.post();
+            oat::Profiler::set_current(nullptr);
+
+            const oat::Sample &out = second.retrieve()->sample_;
+
+            THEN ("Each sink added one stamp") {
+                REQUIRE( sample.num_stamps() == 1 );
+                REQUIRE( out.num_stamps() == 2 );
+                REQUIRE( out.stamp_ns(1) - out.stamp_ns(0) >= 2000000 );
+            }
+
+            THEN ("The profiler has the latency of the hop between them") {
+                REQUIRE( profiler.hop(0).count() == 1 );
+                REQUIRE( profiler.endToEnd().count() == 1 );
+                REQUIRE( profiler.endToEnd().total_ns()
+                         == out.stamp_ns(1) - out.stamp_ns(0) );
+
+                const std::string json = profiler.toJSON("test");
+                REQUIRE( json.find("\"latency\":{\"end_to_end\":{\"count\":1")
+                         != std::string::npos );
+            }
+        }
+    }
+}
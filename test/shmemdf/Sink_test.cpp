@@ -20,11 +20,15 @@
 #define CATCH_CONFIG_MAIN
 #include <catch.hpp>
 
+#include <chrono>
+#include <fstream>
+#include <future>
 #include <string>
 
 #include "../../lib/datatypes/Color.h"
 #include "../../lib/shmemdf/SharedFrameHeader.h"
 #include "../../lib/shmemdf/Sink.h"
+#include "../../lib/shmemdf/Source.h"
 
 const std::string node_addr = "test";
 
@@ -106,6 +110,19 @@ SCENARIO ("Sinks must bind() before waiting or posting.", "[Sink]") {
     }
 }
 
+SCENARIO ("Sinks set the maximum number of sources before binding.", "[Sink]") {
+
+        oat::Sink<int> sink;
+
+        REQUIRE_THROWS( sink.set_max_sources(0); );
+        REQUIRE_THROWS( sink.set_max_sources(oat::Node::MAX_SLOTS + 1); );
+        REQUIRE_NOTHROW( sink.set_max_sources(oat::Node::MAX_SLOTS); );
+
+        INFO ("The sink binds a node");
+        sink.bind(node_addr);
+        REQUIRE_THROWS( sink.set_max_sources(oat::Node::MAX_SLOTS); );
+}
+
 SCENARIO ("Sinks cannot bind() to the same node more than once.", "[Source]") {
 
         oat::Sink<int> sink;
@@ -155,7 +172,7 @@ SCENARIO ("Sink<SharedFrameHeader> must bind() before waiting, posting, or alloc
     GIVEN ("A single Sink<SharedFrameHeader>") {
 
         oat::Sink<oat::Frame> sink;
-        cv::Mat mat;
+        oat::Frame * frame {nullptr};
         size_t cols {100};
         size_t rows {100};
         int type {1};
@@ -178,7 +195,443 @@ SCENARIO ("Sink<SharedFrameHeader> must bind() before waiting, posting, or alloc
         WHEN ("When the sink calls retrieve() before binding a segment") {
 
             THEN ("The the sink shall throw") {
-                REQUIRE_THROWS( mat = sink.retrieve(cols, rows, type, color); );
+                REQUIRE_THROWS( frame = sink.retrieve(cols, rows, type, color); );
+            }
+        }
+    }
+}
+
+SCENARIO ("Sink<SharedFrameHeader> can write frames in place.", "[Sink, SharedFrameHeader]") {
+
+    GIVEN ("A bound Sink<Frame> with ring depth 2 and a connected Source<Frame>") {
+
+        const size_t rows {10};
+        const size_t cols {10};
+
+        oat::Sink<oat::Frame> sink;
+        sink.bind(node_addr, rows * cols, 2);
+        sink.retrieve(rows, cols, CV_8UC1, oat::PIX_GREY);
+
+        oat::Source<oat::Frame> source;
+        source.touch(node_addr);
+        source.connect();
+
+        WHEN ("The sink writes to an acquired frame and commits it") {
+
+            oat::Frame * frame = sink.acquire();
+            frame->data[0] = 42;
+            sink.commit();
+
+            THEN ("The source reads the frame with an incremented sample count") {
+                source.wait();
+                REQUIRE( source.retrieve()->data[0] == 42 );
+                REQUIRE( source.retrieve()->sample_count() == 1 );
+                source.post();
+            }
+        }
+
+        WHEN ("The sink replaces the acquired frame's data and commits upstream sample info") {
+
+            oat::Frame * frame = sink.acquire();
+            cv::Mat other(rows, cols, CV_8UC1);
+            other.data[0] = 7;
+            static_cast<cv::Mat &>(*frame) = other;
+
+            oat::Sample sample;
+            sample.incrementCount();
+            sample.incrementCount();
+            sink.commit(sample);
+
+            THEN ("The data is copied into shared memory and the sample info is propagated") {
+                source.wait();
+                REQUIRE( source.retrieve()->data[0] == 7 );
+                REQUIRE( source.retrieve()->sample_count() == 2 );
+                source.post();
+            }
+        }
+
+        WHEN ("The sink replaces the acquired frame with one of the wrong size") {
+
+            oat::Frame * frame = sink.acquire();
+            static_cast<cv::Mat &>(*frame) = cv::Mat(rows / 2, cols, CV_8UC1);
+
+            THEN ("The sink shall throw on commit") {
+                REQUIRE_THROWS( sink.commit(); );
+            }
+        }
+    }
+}
+
+SCENARIO ("Sink<SharedFrameHeader> can hold its frame ring in a separate file.", "[Sink, SharedFrameHeader]") {
+
+    GIVEN ("A Sink<Frame> with its frame ring in /dev/shm") {
+
+        const size_t rows {10};
+        const size_t cols {10};
+        const std::string ring_file = "/dev/shm/" + node_addr + "_ring";
+
+        auto sink = std::unique_ptr<oat::Sink<oat::Frame>>(new oat::Sink<oat::Frame>());
+        sink->set_huge_page_dir("/dev/shm");
+        sink->set_lock_ring(true);
+        sink->bind(node_addr, rows * cols, 2);
+        sink->retrieve(rows, cols, CV_8UC1, oat::PIX_GREY);
+
+        WHEN ("The sink has bound") {
+            THEN ("Ring memory options cannot be changed") {
+                REQUIRE_THROWS( sink->set_huge_page_dir("/dev/shm"); );
+                REQUIRE_THROWS( sink->set_lock_ring(false); );
+            }
+        }
+
+        WHEN ("A source connects and the sink writes a frame") {
+
+            auto source = std::unique_ptr<oat::Source<oat::Frame>>(new oat::Source<oat::Frame>());
+            source->touch(node_addr);
+            source->connect();
+
+            oat::Frame * frame = sink->acquire();
+            frame->data[0] = 42;
+            sink->commit();
+
+            THEN ("The source reads the frame from the ring file") {
+                REQUIRE( access(ring_file.c_str(), F_OK) == 0 );
+                source->wait();
+                REQUIRE( source->retrieve()->data[0] == 42 );
+                source->post();
+            }
+
+            AND_WHEN ("The sink and source are destroyed") {
+
+                sink.reset();
+                source.reset();
+
+                THEN ("The ring file is removed") {
+                    REQUIRE( access(ring_file.c_str(), F_OK) != 0 );
+                }
+            }
+        }
+    }
+}
+
+SCENARIO ("Sink<SharedFrameHeader> can bind a node in process memory.", "[Sink, SharedFrameHeader]") {
+
+    GIVEN ("A Sink<Frame> bound to a local node") {
+
+        const size_t rows {10};
+        const size_t cols {10};
+        const std::string local_addr = "test_local";
+        const std::string shm_file = "/dev/shm/" + local_addr + "_node";
+
+        oat::makeNodeLocal(local_addr);
+
+        auto sink = std::unique_ptr<oat::Sink<oat::Frame>>(new oat::Sink<oat::Frame>());
+        sink->bind(local_addr, rows * cols, 2);
+        sink->retrieve(rows, cols, CV_8UC1, oat::PIX_GREY);
+
+        WHEN ("A source connects and the sink writes a frame") {
+
+            auto source = std::unique_ptr<oat::Source<oat::Frame>>(new oat::Source<oat::Frame>());
+            source->touch(local_addr);
+            source->connect();
+
+            oat::Frame * frame = sink->acquire();
+            frame->data[0] = 42;
+            sink->commit();
+
+            THEN ("The source reads the frame, and there is no shared memory") {
+                REQUIRE( access(shm_file.c_str(), F_OK) != 0 );
+                source->wait();
+                REQUIRE( source->retrieve()->data[0] == 42 );
+                source->post();
+            }
+
+            AND_WHEN ("The sink and source are destroyed") {
+
+                sink.reset();
+                source.reset();
+
+                THEN ("Another sink can bind the address") {
+                    oat::Sink<oat::Frame> sink2;
+                    REQUIRE_NOTHROW( sink2.bind(local_addr, rows * cols, 2); );
+                }
+            }
+        }
+    }
+}
+
+SCENARIO ("Sink<Frame> replaces a frame ring file left by a crashed sink.", "[Sink, SharedFrameHeader]") {
+
+    GIVEN ("A frame ring file left in the huge page directory") {
+
+        const std::string ring_path = "/dev/shm/" + node_addr + "_ring";
+        std::ofstream(ring_path) << "stale";
+
+        WHEN ("A Sink<Frame> binds with its ring in that directory") {
+
+            oat::Sink<oat::Frame> sink;
+            sink.set_huge_page_dir("/dev/shm");
+            sink.bind(node_addr, 100);
+
+            THEN ("The sink shall create its ring in place of the file") {
+                REQUIRE_NOTHROW( sink.retrieve(10, 10, CV_8UC1, oat::PIX_GREY) );
+            }
+        }
+
+        ::unlink(ring_path.c_str());
+    }
+}
+
+SCENARIO ("Sinks drop samples according to their backpressure policy.", "[Sink, SharedFrameHeader]") {
+
+    GIVEN ("A Sink<Frame> and a connected Source<Frame> that has yet to read") {
+
+        const size_t rows {10};
+        const size_t cols {10};
+
+        oat::Sink<oat::Frame> sink;
+        oat::Source<oat::Frame> source;
+
+        auto bind = [&](oat::BackpressurePolicy policy, size_t depth) {
+            sink.set_backpressure(policy);
+            sink.bind(node_addr, rows * cols, depth);
+            sink.retrieve(rows, cols, CV_8UC1, oat::PIX_GREY);
+            source.touch(node_addr);
+            source.connect();
+        };
+
+        auto write = [&](uint8_t value) {
+            oat::Frame * frame = sink.acquire();
+            frame->data[0] = value;
+            sink.commit();
+        };
+
+        auto dropped = [&]() {
+            auto shmem = oat::NodeSegment::open(node_addr + "_node");
+            return shmem.find<oat::Node>(typeid(oat::Node).name())
+                ->sink_stats.dropped.load();
+        };
+
+        WHEN ("The policy is drop-newest and the sink writes three frames") {
+
+            bind(oat::BackpressurePolicy::DROP_NEWEST, 1);
+            write(1);
+            write(2);
+            write(3);
+
+            THEN ("The sink never reports that it would block") {
+                REQUIRE_FALSE( sink.wouldBlock() );
+            }
+
+            THEN ("The source reads the first frame and the others are counted as dropped") {
+                REQUIRE( dropped() == 2 );
+                source.wait();
+                REQUIRE( source.retrieve()->data[0] == 1 );
+                REQUIRE( source.retrieve()->sample_count() == 1 );
+                source.post();
+            }
+
+            AND_WHEN ("The source has read and the sink writes again") {
+
+                source.wait();
+                source.post();
+                write(4);
+
+                THEN ("The dropped frames appear as a gap in the sample count") {
+                    source.wait();
+                    REQUIRE( source.retrieve()->data[0] == 4 );
+                    REQUIRE( source.retrieve()->sample_count() == 4 );
+                    source.post();
+                }
+            }
+        }
+
+        WHEN ("The policy is block and the sink has filled the ring") {
+
+            bind(oat::BackpressurePolicy::BLOCK, 2);
+            write(1);
+            REQUIRE_FALSE( sink.wouldBlock() );
+            write(2);
+
+            THEN ("The sink reports that it would block until the source reads") {
+                REQUIRE( sink.wouldBlock() );
+                source.wait();
+                source.post();
+                REQUIRE_FALSE( sink.wouldBlock() );
+            }
+        }
+
+        WHEN ("The policy is drop-oldest and the sink writes past the end of the ring") {
+
+            bind(oat::BackpressurePolicy::DROP_OLDEST, 2);
+            write(1);
+            write(2);
+            write(3);
+
+            THEN ("The source skips to the most recent frame") {
+                REQUIRE( dropped() == 1 );
+                source.wait();
+                REQUIRE( source.retrieve()->data[0] == 3 );
+                REQUIRE( source.retrieve()->sample_count() == 3 );
+                source.post();
+            }
+        }
+
+        WHEN ("The policy is drop-oldest and the source is reading the ring slot that the sink would overwrite") {
+
+            bind(oat::BackpressurePolicy::DROP_OLDEST, 2);
+            write(1);
+            source.wait();
+            write(2);
+            auto overwrite = std::async(std::launch::async, [&] { write(3); });
+
+            THEN ("The sink waits until the source has read") {
+                REQUIRE( overwrite.wait_for(std::chrono::milliseconds(50))
+                         != std::future_status::ready );
+                REQUIRE( source.retrieve()->data[0] == 1 );
+                source.post();
+                REQUIRE( overwrite.wait_for(std::chrono::seconds(1))
+                         == std::future_status::ready );
+                source.wait();
+                REQUIRE( source.retrieve()->data[0] == 3 );
+                source.post();
+            }
+        }
+
+        WHEN ("The policy is drop-oldest and the ring is one frame deep") {
+
+            THEN ("The sink cannot bind") {
+                REQUIRE_THROWS( bind(oat::BackpressurePolicy::DROP_OLDEST, 1) );
+            }
+        }
+
+        WHEN ("The sink has bound") {
+
+            bind(oat::BackpressurePolicy::BLOCK, 1);
+
+            THEN ("The policy cannot be changed") {
+                REQUIRE_THROWS( sink.set_backpressure(oat::BackpressurePolicy::DROP_NEWEST); );
+            }
+        }
+    }
+
+    GIVEN ("A Sink<int> with the drop-newest policy and a connected Source<int>") {
+
+        oat::Sink<int> sink;
+        sink.set_backpressure(oat::BackpressurePolicy::DROP_NEWEST);
+        sink.bind(node_addr);
+
+        oat::Source<int> source;
+        source.touch(node_addr);
+        source.connect();
+
+        WHEN ("The sink writes while the source has yet to read") {
+
+            REQUIRE( sink.wait() );
+            *sink.retrieve() = 1;
+            sink.post();
+
+            THEN ("The sink's wait() tells it to discard the sample") {
+                REQUIRE( !sink.wait() );
+                source.wait();
+                REQUIRE( *source.retrieve() == 1 );
+                source.post();
+                REQUIRE( sink.wait() );
+                sink.post();
+            }
+        }
+    }
+
+    GIVEN ("A Sink<Frame> with the block policy and ring depth 2, and a "
+           "non-blocking Source<Frame>") {
+
+        const size_t rows {10};
+        const size_t cols {10};
+
+        oat::Sink<oat::Frame> sink;
+        sink.bind(node_addr, rows * cols, 2);
+        sink.retrieve(rows, cols, CV_8UC1, oat::PIX_GREY);
+
+        oat::Source<oat::Frame> source;
+        source.touch(node_addr, oat::SourceMode::NON_BLOCKING);
+        source.connect();
+
+        auto write = [&](uint8_t value) {
+            oat::Frame * frame = sink.acquire();
+            frame->data[0] = value;
+            sink.commit();
+        };
+
+        WHEN ("The source is reading the ring slot that the sink would overwrite") {
+
+            write(1);
+            source.wait();
+            write(2);
+            auto overwrite = std::async(std::launch::async, [&] { write(3); });
+
+            THEN ("The sink waits until the source has read") {
+                REQUIRE( overwrite.wait_for(std::chrono::milliseconds(50))
+                         != std::future_status::ready );
+                REQUIRE( source.retrieve()->data[0] == 1 );
+                source.post();
+                REQUIRE( overwrite.wait_for(std::chrono::seconds(1))
+                         == std::future_status::ready );
+                source.wait();
+                REQUIRE( source.retrieve()->data[0] == 3 );
+                source.post();
+            }
+        }
+
+        WHEN ("The source is not reading") {
+
+            write(1);
+            write(2);
+            write(3);
+
+            THEN ("The sink does not wait for it") {
+                source.wait();
+                REQUIRE( source.retrieve()->data[0] == 3 );
+                source.post();
+            }
+        }
+    }
+
+    GIVEN ("A Sink<int> with the drop-oldest policy") {
+
+        oat::Sink<int> sink;
+        sink.set_backpressure(oat::BackpressurePolicy::DROP_OLDEST);
+
+        THEN ("The sink cannot bind, because its shared object is not a ring") {
+            REQUIRE_THROWS( sink.bind(node_addr) );
+        }
+    }
+
+    GIVEN ("A Sink<int> with the block policy and a connected Source<int>") {
+
+        oat::Sink<int> sink;
+        sink.bind(node_addr);
+
+        oat::Source<int> source;
+        source.touch(node_addr);
+        source.connect();
+
+        WHEN ("The sink waits for the source to read and quit is set") {
+
+            REQUIRE( sink.wait() );
+            *sink.retrieve() = 1;
+            sink.post();
+
+            oat::quit = 1;
+            const bool write = sink.wait();
+            oat::quit = 0;
+
+            THEN ("The sink's wait() tells it not to write") {
+                REQUIRE( !write );
+                source.wait();
+                REQUIRE( *source.retrieve() == 1 );
+                source.post();
+                REQUIRE( sink.wait() );
+                sink.post();
+                REQUIRE( source.write_number() == 2 );
             }
         }
     }
@@ -20,6 +20,8 @@
 #define CATCH_CONFIG_MAIN
 #include <catch.hpp>
 
+#include <chrono>
+#include <future>
 #include <string>
 
 #include "../../lib/shmemdf/SharedFrameHeader.h"
@@ -214,5 +216,283 @@ SCENARIO ("Connected sources can retrieve shared objects to mutate them.", "[Sou
     }
 }
 
+SCENARIO ("Sources read metadata published by the sink when it binds.", "[Source]") {
+
+    GIVEN ("A Sink<int> that publishes a double as metadata") {
+
+        oat::Sink<int> sink;
+        REQUIRE_NOTHROW( sink.set_metadata(2.5); );
+        sink.bind(node_addr);
+
+        oat::Source<int> source;
+        source.touch(node_addr);
+
+        WHEN ("The source calls metadata() before connecting") {
+            THEN ("The source shall throw") {
+                REQUIRE_THROWS( source.metadata<double>(); );
+            }
+        }
+
+        WHEN ("The source calls metadata() after connecting") {
+
+            source.connect();
+
+            THEN ("The source shall see the sink's metadata") {
+                REQUIRE( source.metadata<double>() != nullptr );
+                REQUIRE( *source.metadata<double>() == 2.5 );
+            }
+
+            THEN ("Metadata of another type shall not be found") {
+                REQUIRE( source.metadata<float>() == nullptr );
+            }
+        }
+
+        WHEN ("The sink sets metadata after binding") {
+            THEN ("The sink shall throw") {
+                REQUIRE_THROWS( sink.set_metadata(1.0); );
+            }
+        }
+    }
+}
+
+SCENARIO ("Frame sources read the sink's frame ring in order.", "[Source, SharedFrameHeader]") {
+
+    GIVEN ("A Sink<Frame> with ring depth 3 and a connected Source<Frame>") {
+
+        const size_t rows {10};
+        const size_t cols {10};
+        const size_t depth {3};
+
+        oat::Sink<oat::Frame> sink;
+        sink.bind(node_addr, rows * cols, depth);
+        oat::Frame * frame = sink.retrieve(rows, cols, CV_8UC1, oat::PIX_GREY);
+
+        oat::Source<oat::Frame> source;
+        source.touch(node_addr);
+        source.connect();
+
+        WHEN ("The sink writes depth frames before the source reads") {
+
+            for (size_t i = 0; i < depth; i++) {
+                sink.wait();
+                frame->data[0] = i;
+                frame->incrementSampleCount();
+                sink.post();
+            }
+
+            THEN ("The source shall read each frame in the order it was written") {
+                for (size_t i = 0; i < depth; i++) {
+                    source.wait();
+                    REQUIRE( source.retrieve()->data[0] == i );
+                    REQUIRE( source.retrieve()->sample_count() == i + 1 );
+                    source.post();
+                }
+            }
+        }
+    }
+}
+
+SCENARIO ("Frame sources can borrow the shared frame without copying it.", "[Source, SharedFrameHeader]") {
+
+    GIVEN ("A Sink<Frame> and a connected Source<Frame>") {
+
+        const size_t rows {10};
+        const size_t cols {10};
+
+        oat::Sink<oat::Frame> sink;
+        sink.bind(node_addr, rows * cols);
+        oat::Frame * frame = sink.retrieve(rows, cols, CV_8UC1, oat::PIX_GREY);
+
+        oat::Source<oat::Frame> source;
+        source.touch(node_addr);
+        source.connect();
+
+        sink.wait();
+        frame->data[0] = 42;
+        sink.post();
+
+        WHEN ("The source borrows the frame") {
+
+            auto lease = source.borrow();
+
+            THEN ("The lease views the sink's frame in shared memory") {
+                REQUIRE( lease.node_state() == oat::NodeState::SINK_BOUND );
+                REQUIRE( lease.frame().data[0] == 42 );
+            }
+
+            THEN ("Releasing the lease completes the source's read") {
+                lease.release();
+                REQUIRE_NOTHROW( sink.wait() );
+                REQUIRE_THROWS( source.post() );
+            }
+        }
+
+        WHEN ("A lease goes out of scope") {
+
+            { auto lease = source.borrow(); }
+
+            THEN ("The source's read is complete") {
+                REQUIRE_NOTHROW( sink.wait() );
+                REQUIRE_THROWS( source.post() );
+            }
+        }
+    }
+}
+
+SCENARIO ("LATEST sources copy the most recent write without holding up the sink.", "[Source]") {
+
+    GIVEN ("A bound Sink<int> that accepts a single source") {
+
+        oat::Sink<int> sink;
+        sink.set_max_sources(1);
+        sink.bind(node_addr);
+        int * shared = sink.retrieve();
+
+        WHEN ("A blocking source and a LATEST source connect") {
+
+            oat::Source<int> source;
+            oat::Source<int> observer;
+
+            THEN ("The LATEST source shall not take a slot in the node") {
+                REQUIRE_NOTHROW([&]{ source.touch(node_addr);
+                    source.connect();
+                    observer.touch(node_addr, oat::SourceMode::LATEST);
+                    observer.connect(); }());
+            }
+        }
+
+        WHEN ("A LATEST source connects and the sink writes three times") {
+
+            oat::Source<int> observer;
+            observer.touch(node_addr, oat::SourceMode::LATEST);
+            observer.connect();
+
+            for (int i = 0; i < 3; i++) {
+                sink.wait();
+                *shared = i;
+                sink.post();
+            }
+
+            THEN ("The source shall read a private copy of the last write") {
+                REQUIRE( observer.wait() == oat::NodeState::SINK_BOUND );
+                REQUIRE( *observer.retrieve() == 2 );
+                REQUIRE( observer.retrieve() != shared );
+                observer.post();
+            }
+        }
+    }
+
+    GIVEN ("A LATEST source of a sink that stops in the middle of a write") {
+
+        oat::Sink<int> sink;
+        sink.bind(node_addr);
+        int * shared = sink.retrieve();
+
+        oat::Source<int> observer;
+        observer.touch(node_addr, oat::SourceMode::LATEST);
+        observer.connect();
+
+        sink.wait();
+        *shared = 1;
+        sink.post();
+        sink.wait();
+
+        WHEN ("The source waits with a timeout") {
+
+            oat::NodeState state;
+            THEN ("The source shall give up on the unfinished write") {
+                REQUIRE_FALSE( observer.tryWait(std::chrono::milliseconds(10),
+                                                state) );
+            }
+        }
+
+        WHEN ("The source waits and this process quits") {
+
+            auto waiting = std::async(std::launch::async, [&] {
+                return observer.wait();
+            });
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            oat::quit = 1;
+
+            THEN ("The source shall stop waiting") {
+                REQUIRE( waiting.wait_for(std::chrono::seconds(1))
+                         == std::future_status::ready );
+                oat::quit = 0;
+                observer.post();
+            }
+
+            oat::quit = 0;
+        }
+
+        WHEN ("The source waits and the sink completes the write") {
+
+            auto waiting = std::async(std::launch::async, [&] {
+                return observer.wait();
+            });
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            *shared = 2;
+            sink.post();
+
+            THEN ("The source shall copy the completed write") {
+                REQUIRE( waiting.wait_for(std::chrono::seconds(1))
+                         == std::future_status::ready );
+                REQUIRE( *observer.retrieve() == 2 );
+                observer.post();
+            }
+        }
+    }
+
+    GIVEN ("A bound sink of a type that is not trivially copyable") {
+
+        struct Counted {
+            Counted() = default;
+            Counted(const Counted &c) : value(c.value) { }
+            int value {0};
+        };
+
+        oat::Sink<Counted> sink;
+        sink.bind(node_addr);
+
+        WHEN ("A LATEST source of that type connects") {
+
+            oat::Source<Counted> observer;
+            observer.touch(node_addr, oat::SourceMode::LATEST);
+
+            THEN ("The source shall throw") {
+                REQUIRE_THROWS( observer.connect() );
+            }
+        }
+    }
+
+    GIVEN ("A Sink<Frame> with ring depth 2 and a LATEST Source<Frame>") {
+
+        const size_t rows {10};
+        const size_t cols {10};
+
+        oat::Sink<oat::Frame> sink;
+        sink.bind(node_addr, rows * cols, 2);
+        sink.retrieve(rows, cols, CV_8UC1, oat::PIX_GREY);
+
+        oat::Source<oat::Frame> observer;
+        observer.touch(node_addr, oat::SourceMode::LATEST);
+        observer.connect();
+
+        WHEN ("The sink writes five frames") {
+
+            for (int i = 0; i < 5; i++) {
+                oat::Frame * frame = sink.acquire();
+                frame->data[0] = i;
+                sink.commit();
+            }
+
+            THEN ("The source shall see the most recent frame and sample count") {
+                observer.wait();
+                REQUIRE( observer.retrieve()->data[0] == 4 );
+                REQUIRE( observer.retrieve()->sample_count() == 5 );
+                observer.post();
+            }
+        }
+    }
+}
 
 // TODO: specialization tests
@@ -0,0 +1,95 @@
+//******************************************************************************
+//* File:   Stripes_test.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <atomic>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include "../../lib/utility/Stripes.h"
+
+// Test outline
+//
+//### Striped kernels give the same result as whole frames
+//- Given a random binary frame whose height is not a multiple of the stripes
+//    - When it is processed in stripes
+//        - Then, every row is visited exactly once
+//        - Then, erosion and dilation match the whole frame, including at
+//          stripe borders
+//        - Then, processing in place is refused
+
+const int rows {479};
+const int cols {640};
+
+SCENARIO ("Striped kernels give the same result as whole frames.", "[Stripes]") {
+
+    GIVEN ("A random binary frame whose height is not a multiple of the stripes") {
+
+        cv::Mat noise(rows, cols, CV_8UC1), frame;
+        cv::randu(noise, 0, 256);
+        cv::threshold(noise, frame, 128, 255, cv::THRESH_BINARY);
+
+        // Even sizes have an off-center anchor
+        const cv::Mat kernel
+            = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(10, 10));
+
+        WHEN ("It is processed in stripes") {
+
+            THEN ("Every row is visited exactly once") {
+                std::atomic<int> visits[rows];
+                for (auto &v : visits)
+                    v = 0;
+
+                oat::forEachStripe(rows, 7, [&](const cv::Range &r) {
+                    for (int i = r.start; i < r.end; i++)
+                        visits[i]++;
+                });
+
+                int wrong = 0;
+                for (auto &v : visits)
+                    wrong += v != 1;
+                REQUIRE( wrong == 0 );
+            }
+
+            THEN ("Erosion and dilation match the whole frame, including at stripe borders") {
+                for (int stripes : {1, 2, 7, 64}) {
+
+                    cv::Mat whole, striped;
+                    cv::erode(frame, whole, kernel);
+                    oat::stripedMorphology(
+                        cv::MORPH_ERODE, frame, striped, kernel, stripes);
+                    REQUIRE( cv::countNonZero(whole != striped) == 0 );
+
+                    cv::dilate(frame, whole, kernel);
+                    oat::stripedMorphology(
+                        cv::MORPH_DILATE, frame, striped, kernel, stripes);
+                    REQUIRE( cv::countNonZero(whole != striped) == 0 );
+                }
+            }
+
+            THEN ("Processing in place is refused") {
+                REQUIRE_THROWS( oat::stripedMorphology(
+                    cv::MORPH_ERODE, frame, frame, kernel, 4); );
+            }
+        }
+    }
+}
@@ -24,6 +24,9 @@
 #include <future>
 #include <thread>
 
+#include <sys/wait.h>
+#include <unistd.h>
+
 #include "../../lib/shmemdf/Sink.h"
 #include "../../lib/shmemdf/Source.h"
 
@@ -72,6 +75,16 @@ namespace oat { volatile sig_atomic_t quit = 0; }
 //            3. A source connects
 //            4. The source attempts to enter the critical section
 //        - Then, the source shall block until the sink enters/exits the critical section
+//
+//### Sources that stop reading shall not stall the sink forever
+//- Given a sink and a blocking source in another process
+//    - When the source's process dies between wait() and post()
+//        - Then, the sink shall evict the source and keep writing
+//        - Then, the source shall only be evicted after a grace period
+//- Given a sink with a reader deadline and a blocking source
+//    - When the source stops posting for longer than the deadline
+//        - Then, the sink shall evict the source and keep writing
+//        - Then, the source shall become non-blocking
 
 using msec = std::chrono::milliseconds;
 const std::string node_addr = "test";
@@ -525,3 +538,167 @@ SCENARIO ("Sources attaching or detaching during source or sink wait() periods "
         }
     }
 }
+
+SCENARIO ("LATEST sources never see a frame that is being written.",
+          "[Sink, Source, Concurrency]") {
+
+    GIVEN ("A sink writing frames continuously and a LATEST source") {
+
+        const size_t rows {100};
+        const size_t cols {100};
+
+        oat::Sink<oat::Frame> sink;
+        sink.bind(node_addr, rows * cols);
+        sink.retrieve(rows, cols, CV_8UC1, oat::PIX_GREY);
+
+        oat::Source<oat::Frame> observer;
+        observer.touch(node_addr, oat::SourceMode::LATEST);
+        observer.connect();
+
+        std::atomic<bool> writing {true};
+        auto fut = std::async(std::launch::async, [&sink, &writing] {
+            while (writing) {
+                oat::Frame * frame = sink.acquire();
+                std::memset(frame->data,
+                            frame->sample_count() % 256,
+                            frame->total());
+                sink.commit();
+            }
+        });
+
+        WHEN ("The source reads while the sink writes") {
+
+            bool torn = false;
+            uint64_t last_count = 0;
+            bool counts_increase = true;
+
+            for (int i = 0; i < 50; i++) {
+                observer.wait();
+                const oat::Frame * frame = observer.retrieve();
+                for (size_t j = 0; j < frame->total(); j++)
+                    torn |= frame->data[j] != frame->data[0];
+                counts_increase &= frame->sample_count() > last_count;
+                last_count = frame->sample_count();
+                observer.post();
+            }
+
+            writing = false;
+            fut.wait();
+
+            THEN ("Each frame shall be consistent and newer than the last") {
+                REQUIRE_FALSE(torn);
+                REQUIRE(counts_increase);
+            }
+        }
+    }
+}
+
+SCENARIO ("Sources that stop reading shall not stall the sink forever.",
+          "[Sink, Source, Concurrency]") {
+
+    GIVEN ("A sink and a blocking source in another process") {
+
+        oat::Sink<int> sink;
+        sink.bind(node_addr);
+
+        int ready[2];
+        REQUIRE (pipe(ready) == 0);
+
+        pid_t child = fork();
+        if (child == 0) {
+
+            oat::Source<int> source;
+            source.touch(node_addr);
+            source.connect();
+
+            char c = 1;
+            if (write(ready[1], &c, 1) == 1)
+                source.wait();
+
+            // Die without posting
+            _exit(0);
+        }
+
+        char c;
+        REQUIRE (read(ready[0], &c, 1) == 1);
+        close(ready[0]);
+        close(ready[1]);
+
+        WHEN ("The source's process dies between wait() and post()") {
+
+            sink.wait();
+            sink.post();
+
+            REQUIRE (waitpid(child, nullptr, 0) == child);
+
+            THEN ("The sink shall evict the source and keep writing") {
+
+                auto fut = std::async(std::launch::async, [&sink] {
+                    sink.wait();
+                    sink.post();
+                });
+
+                REQUIRE (fut.wait_for(msec(3000)) == std::future_status::ready);
+            }
+
+            THEN ("The source shall only be evicted after a grace period") {
+
+                // Processes in another PID namespace also appear dead
+                auto shmem = oat::NodeSegment::open(node_addr + "_node");
+                auto node = shmem.find<oat::Node>(typeid(oat::Node).name());
+                REQUIRE (node->evictStaleReaders(0) == 0);
+
+                std::this_thread::sleep_for(msec(1100));
+                REQUIRE (node->evictStaleReaders(0) == 1);
+            }
+        }
+    }
+
+    GIVEN ("A sink with a reader deadline and a blocking source") {
+
+        oat::Sink<int> sink;
+        sink.set_reader_deadline(msec(50));
+        sink.bind(node_addr);
+        int *shared = sink.retrieve();
+
+        oat::Source<int> source;
+        source.touch(node_addr);
+        source.connect();
+
+        WHEN ("The source stops posting for longer than the deadline") {
+
+            sink.wait();
+            *shared = 1;
+            sink.post();
+
+            source.wait();
+
+            THEN ("The sink shall evict the source and keep writing") {
+
+                auto fut = std::async(std::launch::async, [&sink, shared] {
+                    sink.wait();
+                    *shared = 2;
+                    sink.post();
+                });
+
+                REQUIRE (fut.wait_for(msec(10)) != std::future_status::ready);
+                REQUIRE (fut.wait_for(msec(1000)) == std::future_status::ready);
+
+                AND_THEN ("The source shall become non-blocking") {
+
+                    source.post();
+
+                    for (int i = 3; i < 6; i++) {
+                        sink.wait();
+                        *shared = i;
+                        sink.post();
+                    }
+
+                    source.wait();
+                    REQUIRE (*source.retrieve() == 5);
+                    source.post();
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,127 @@
+//******************************************************************************
+//* File:   fanout_bench.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+// Node fan-out frame throughput benchmark.
+//
+// A single Sink<Frame> publishes 640x480 BGR frames to a node that is read by
+// 1 to Node::MAX_SLOTS blocking Source<Frame>'s, each on its own thread. The
+// sink copies an image into each acquired ring slot and each source copies
+// every frame it reads out of the ring, as a component that keeps frames
+// would. Reports the sink's frame throughput for each number of sources.
+//
+// Usage: fanout_bench [frames] [ring depth]
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "../../lib/datatypes/Frame.h"
+#include "../../lib/shmemdf/Sink.h"
+#include "../../lib/shmemdf/Source.h"
+
+// Global via extern in Globals.h
+namespace oat { volatile sig_atomic_t quit = 0; }
+
+using Clock = std::chrono::steady_clock;
+const std::string node_addr = "fanout_bench";
+
+const int rows {480};
+const int cols {640};
+const int type {CV_8UC3};
+
+static double framesPerSecond(const size_t num_sources,
+                              const uint64_t n,
+                              const size_t depth)
+{
+    std::vector<std::unique_ptr<oat::Source<oat::Frame>>> sources;
+    std::vector<std::thread> readers;
+
+    const cv::Mat image(rows, cols, type, cv::Scalar(10, 20, 30));
+
+    auto sink = std::unique_ptr<oat::Sink<oat::Frame>>(new oat::Sink<oat::Frame>());
+    sink->set_max_sources(num_sources);
+    sink->bind(node_addr, image.total() * image.elemSize(), depth);
+    sink->retrieve(rows, cols, type, oat::PIX_BGR);
+
+    for (size_t i = 0; i < num_sources; i++) {
+        sources.emplace_back(new oat::Source<oat::Frame>());
+        sources.back()->touch(node_addr);
+    }
+
+    for (auto &s : sources) {
+        auto src = s.get();
+        readers.emplace_back([src] {
+            src->connect();
+            oat::Frame copy;
+            while (src->wait() != oat::NodeState::END) {
+                src->copyTo(copy);
+                src->post();
+            }
+        });
+    }
+
+    auto tick = Clock::now();
+    for (uint64_t i = 0; i < n; i++) {
+        oat::Frame *frame = sink->acquire();
+        image.copyTo(*frame);
+        sink->commit();
+    }
+    auto tock = Clock::now();
+
+    // Sink ENDs the node and releases the readers
+    sink.reset();
+    for (auto &r : readers)
+        r.join();
+
+    std::chrono::duration<double> dt = tock - tick;
+    return n / dt.count();
+}
+
+int main(int argc, char *argv[])
+{
+    const uint64_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000;
+    const size_t depth = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 2;
+
+    const double mb_per_frame = rows * cols * CV_ELEM_SIZE(type) / 1e6;
+
+    std::cout << "Sources    Frames/sec    usec/frame   Read MB/sec\n";
+
+    for (size_t num_sources = 1; num_sources <= oat::Node::MAX_SLOTS;
+         num_sources *= 2) {
+
+        double fps = framesPerSecond(num_sources, n, depth);
+        std::cout << std::setw(7) << num_sources
+                  << std::fixed << std::setprecision(0)
+                  << std::setw(14) << fps
+                  << std::setprecision(2)
+                  << std::setw(14) << 1e6 / fps
+                  << std::setprecision(0)
+                  << std::setw(14) << fps * num_sources * mb_per_frame
+                  << std::endl;
+    }
+
+    return 0;
+}
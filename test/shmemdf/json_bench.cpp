@@ -0,0 +1,140 @@
+//******************************************************************************
+//* File:   json_bench.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+// Position JSON serialization throughput benchmark.
+//
+// Compares the per-sample path that the position sockets used to take
+// (before) with oat::PositionJSON (after):
+//
+//   before: a new rapidjson::StringBuffer and Writer per sample, then
+//           serializePosition()
+//   after:  one PositionJSON whose buffer is reused for every sample
+//
+// Both are run on single positions and on full PositionLists, in concise and
+// verbose mode, and reported in positions per second.
+//
+// Usage: json_bench [iterations]
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include "../../lib/datatypes/PositionJSON.h"
+#include "../../lib/datatypes/PositionList.h"
+
+using Clock = std::chrono::steady_clock;
+
+// Keeps the optimizer from discarding the output
+static size_t bytes_written {0};
+
+template <typename T>
+static void rapidJSON(const T &p, bool verbose)
+{
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    oat::serializePosition(p, writer, verbose);
+    bytes_written += buffer.GetSize();
+}
+
+template <typename T>
+static void positionJSON(oat::PositionJSON &json, const T &p)
+{
+    json.serialize(p);
+    bytes_written += json.size();
+}
+
+static double perSecond(const size_t n, const Clock::time_point &start)
+{
+    const std::chrono::duration<double> t = Clock::now() - start;
+    return n / t.count();
+}
+
+template <typename T>
+static void run(const std::string &name,
+                const std::vector<T> &ps,
+                const size_t positions_per_sample,
+                const size_t n,
+                const bool verbose)
+{
+    auto start = Clock::now();
+    for (size_t i = 0; i < n; i++)
+        rapidJSON(ps[i % ps.size()], verbose);
+    const double before = perSecond(n * positions_per_sample, start);
+
+    oat::PositionJSON json(verbose);
+    start = Clock::now();
+    for (size_t i = 0; i < n; i++)
+        positionJSON(json, ps[i % ps.size()]);
+    const double after = perSecond(n * positions_per_sample, start);
+
+    std::cout << std::left << std::setw(24) << name << std::right
+              << std::fixed << std::setprecision(0)
+              << std::setw(14) << before
+              << std::setw(14) << after
+              << std::setprecision(2)
+              << std::setw(10) << after / before << "\n";
+}
+
+int main(int argc, char *argv[])
+{
+    const size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+
+    // Positions with typical, full precision coordinates
+    oat::Sample sample;
+    std::vector<oat::Position2D> ps(64);
+    for (size_t i = 0; i < ps.size(); i++) {
+        sample.incrementCount(oat::Sample::Microseconds(i * 33333));
+        ps[i].set_sample(sample);
+        ps[i].position_valid = i % 8 != 0;
+        ps[i].velocity_valid = i % 2 == 0;
+        ps[i].heading_valid = i % 3 != 0;
+        ps[i].region_valid = i % 4 == 0;
+        ps[i].position.x = 320.0 + 100.0 / (i + 1);
+        ps[i].position.y = 240.0 - 3.0 * i / 7.0;
+        ps[i].velocity.x = 12.3456789 * i;
+        ps[i].velocity.y = -0.0625 * i;
+        ps[i].heading.x = 0.70710678118;
+        ps[i].heading.y = -0.70710678118;
+        std::strcpy(ps[i].region, i % 2 ? "North" : "SouthWest");
+    }
+
+    const size_t k = oat::PositionList::MAX_SIZE;
+    std::vector<oat::PositionList> ls(ps.size() / k);
+    for (size_t i = 0; i < ls.size(); i++) {
+        ls[i].set_sample(ps[i * k].sample());
+        for (size_t j = 0; j < k; j++)
+            ls[i].push_back(ps[i * k + j], j);
+    }
+
+    std::cout << "Positions per second         rapidjson  PositionJSON   speedup\n";
+
+    run("Position2D, concise", ps, 1, n, false);
+    run("Position2D, verbose", ps, 1, n, true);
+    run("PositionList, concise", ls, k, n / k, false);
+    run("PositionList, verbose", ls, k, n / k, true);
+
+    return bytes_written == 0;
+}
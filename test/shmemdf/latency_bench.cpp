@@ -0,0 +1,177 @@
+//******************************************************************************
+//* File:   latency_bench.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+// Node wait/post hand-off latency benchmark.
+//
+// Compares the 10 ms timed_wait polling loop that SourceBase/SinkBase used to
+// wait on Node semaphores (before) with oat::interruptibleWait (after).
+// Two latencies are measured:
+//
+//   1. Hand-off: time from the sink's post of a write to the source waking up.
+//   2. END: time from the sink ENDing to a waiting source returning.
+//
+// Usage: latency_bench [iterations]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/thread/thread_time.hpp>
+
+#include "../../lib/shmemdf/Interrupt.h"
+#include "../../lib/shmemdf/Node.h"
+
+// Global via extern in Globals.h
+namespace oat { volatile sig_atomic_t quit = 0; }
+
+using Clock = std::chrono::steady_clock;
+using semaphore = oat::Node::semaphore;
+
+// Previous SourceBase<T>::wait() implementation
+static void pollingWait(oat::Node &node, semaphore &s)
+{
+    auto timeout = boost::get_system_time() + boost::posix_time::milliseconds(10);
+    while (!s.timed_wait(timeout) && !oat::quit) {
+        timeout = boost::get_system_time() + boost::posix_time::milliseconds(10);
+        if (node.sink_state() == oat::NodeState::END)
+            break;
+    }
+}
+
+static void blockingWait(oat::Node &node, semaphore &s)
+{
+    if (node.sink_state() != oat::NodeState::END)
+        oat::interruptibleWait(s);
+}
+
+using WaitFn = void (*)(oat::Node &, semaphore &);
+
+static void report(const std::string &name, std::vector<double> &usec)
+{
+    std::sort(usec.begin(), usec.end());
+    auto pct = [&usec](double p) {
+        return usec[static_cast<size_t>(p * (usec.size() - 1))];
+    };
+
+    std::cout << std::left << std::setw(24) << name << std::right
+              << std::fixed << std::setprecision(1)
+              << std::setw(10) << usec.front()
+              << std::setw(10) << pct(0.5)
+              << std::setw(10) << pct(0.9)
+              << std::setw(10) << pct(0.99)
+              << std::setw(10) << usec.back() << "\n";
+}
+
+static std::vector<double> handOff(WaitFn wait_fn, const size_t n)
+{
+    oat::Node node;
+    size_t idx;
+    node.acquireSlot(idx);
+
+    std::vector<double> usec;
+    usec.reserve(n);
+    std::atomic<int64_t> t_post {0};
+
+    std::thread source([&] {
+        for (size_t i = 0; i < n; i++) {
+            wait_fn(node, node.read_barrier(idx));
+            auto t = Clock::now().time_since_epoch().count();
+            usec.push_back((t - t_post.load()) / 1e3);
+            if (node.notifySourceReadComplete(idx))
+                node.write_barrier.post();
+        }
+    });
+
+    for (size_t i = 0; i < n; i++) {
+        while (!node.writeSlotAvailable())
+            if (node.announceSinkWait())
+                wait_fn(node, node.write_barrier);
+        t_post = Clock::now().time_since_epoch().count();
+        node.notifySinkWriteComplete();
+    }
+
+    source.join();
+    return usec;
+}
+
+static std::vector<double> endWake(WaitFn wait_fn, const size_t n)
+{
+    std::vector<double> usec;
+    usec.reserve(n);
+
+    for (size_t i = 0; i < n; i++) {
+
+        oat::Node node;
+        size_t idx;
+        node.acquireSlot(idx);
+        node.set_sink_state(oat::NodeState::SINK_BOUND);
+
+        std::atomic<int64_t> t_end {0};
+        std::thread source([&] {
+            wait_fn(node, node.read_barrier(idx));
+            auto t = Clock::now().time_since_epoch().count();
+            usec.push_back((t - t_end.load()) / 1e3);
+        });
+
+        // Let the source start waiting
+        std::this_thread::sleep_for(std::chrono::microseconds(200 + i % 1000));
+
+        t_end = Clock::now().time_since_epoch().count();
+
+        // Before: sinks only changed state. After: sinks also post.
+        if (wait_fn == pollingWait)
+            node.set_sink_state(oat::NodeState::END);
+        else
+            node.notifySinkEnd();
+
+        source.join();
+    }
+
+    return usec;
+}
+
+int main(int argc, char *argv[])
+{
+    const size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+
+    std::cout << "Latency (usec)              min       p50       p90"
+                 "       p99       max\n";
+
+    auto poll_handoff = handOff(pollingWait, n);
+    report("hand-off, polling", poll_handoff);
+
+    auto block_handoff = handOff(blockingWait, n);
+    report("hand-off, blocking", block_handoff);
+
+    const size_t n_end = std::max<size_t>(n / 1000, 10);
+
+    auto poll_end = endWake(pollingWait, n_end);
+    report("END wake, polling", poll_end);
+
+    auto block_end = endWake(blockingWait, n_end);
+    report("END wake, blocking", block_end);
+
+    return 0;
+}
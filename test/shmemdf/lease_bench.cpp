@@ -0,0 +1,136 @@
+//******************************************************************************
+//* File:   lease_bench.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+// Source<Frame> copy vs. read lease benchmark.
+//
+// Compares reading a shared frame by copying it out of shared memory
+// (Source<Frame>::copyTo()) with reading it in place through a
+// Source<Frame>::ReadLease. Each read is followed by either no work or an
+// HSV-detector-style cv::inRange. Frames are 1 MP and 5 MP versions of
+// test/perf/beach-5MP.jpg. The sink and source share a thread so that only
+// the cost of the read is measured.
+//
+// Usage: lease_bench <path/to/beach-5MP.jpg> [frames]
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include "../../lib/datatypes/Frame.h"
+#include "../../lib/shmemdf/Sink.h"
+#include "../../lib/shmemdf/Source.h"
+
+// Global via extern in Globals.h
+namespace oat { volatile sig_atomic_t quit = 0; }
+
+using Clock = std::chrono::steady_clock;
+const std::string node_addr = "lease_bench";
+
+enum class Read { COPY, LEASE };
+
+static void work(const cv::Mat &frame, cv::Mat &mask, const bool threshold)
+{
+    if (threshold)
+        cv::inRange(frame, cv::Scalar(0, 0, 0), cv::Scalar(128, 128, 128), mask);
+}
+
+static double usecPerFrame(const cv::Mat &image,
+                           const Read read,
+                           const bool threshold,
+                           const size_t n)
+{
+    oat::Sink<oat::Frame> sink;
+    sink.bind(node_addr, image.total() * image.elemSize());
+    oat::Frame *shared_frame = sink.retrieve(
+        image.rows, image.cols, image.type(), oat::PIX_BGR);
+    image.copyTo(*shared_frame);
+
+    oat::Source<oat::Frame> source;
+    source.touch(node_addr);
+    source.connect();
+
+    oat::Frame internal_frame;
+    cv::Mat mask;
+
+    auto tick = Clock::now();
+    for (size_t i = 0; i < n; i++) {
+
+        sink.wait();
+        sink.post();
+
+        if (read == Read::COPY) {
+            source.wait();
+            source.copyTo(internal_frame);
+            source.post();
+            work(internal_frame, mask, threshold);
+        } else {
+            auto lease = source.borrow();
+            work(lease.frame(), mask, threshold);
+        }
+    }
+    auto tock = Clock::now();
+
+    return std::chrono::duration<double, std::micro>(tock - tick).count() / n;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2) {
+        std::cerr << "Usage: lease_bench <path/to/beach-5MP.jpg> [frames]\n";
+        return -1;
+    }
+
+    const cv::Mat mp5 = cv::imread(argv[1]);
+    if (mp5.empty()) {
+        std::cerr << "Could not read " << argv[1] << "\n";
+        return -1;
+    }
+
+    const size_t n = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000;
+
+    cv::Mat mp1;
+    const double scale = std::sqrt(1e6 / mp5.total());
+    cv::resize(mp5, mp1, cv::Size(), scale, scale, cv::INTER_AREA);
+
+    std::cout << "usec/frame              copy     lease\n";
+
+    for (const auto &img : {std::make_pair("1 MP", mp1),
+                            std::make_pair("5 MP", mp5)}) {
+        for (const bool threshold : {false, true}) {
+
+            double copy = usecPerFrame(img.second, Read::COPY, threshold, n);
+            double lease = usecPerFrame(img.second, Read::LEASE, threshold, n);
+
+            std::cout << std::left << std::setw(18)
+                      << std::string(img.first) + (threshold ? ", inRange" : "")
+                      << std::right << std::fixed << std::setprecision(1)
+                      << std::setw(10) << copy
+                      << std::setw(10) << lease << std::endl;
+        }
+    }
+
+    return 0;
+}
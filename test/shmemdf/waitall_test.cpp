@@ -0,0 +1,221 @@
+//******************************************************************************
+//* File:   waitall_test.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+
+#include "../../lib/shmemdf/Helpers.h"
+#include "../../lib/shmemdf/Sink.h"
+#include "../../lib/shmemdf/Source.h"
+#include "../../lib/shmemdf/Waker.h"
+
+// Global via extern in Globals.h
+namespace oat { volatile sig_atomic_t quit = 0; }
+
+// Test outline
+//
+//### waitAll() waits on several sources at once
+//- Given two sinks of different types, each with a blocking source
+//    - When waitAll() is called and only the second sink writes
+//        - Then, waitAll() shall block
+//        - Then, the second sink shall be released before the first writes
+//        - Then, waitAll() shall return once the first sink writes
+//    - When waitAll() is called with a timeout and only the first sink writes
+//        - Then, waitAll() shall time out having read and released the first
+//    - When the second sink ENDs during waitAll()
+//        - Then, waitAll() shall return END
+//
+//### Sinks post the Waker registered with a source
+//- Given a sink with a blocking source and a Waker
+//    - When the Waker is registered with the source and the sink writes
+//        - Then, the Waker shall be posted
+//    - When the Waker is registered and then unregistered
+//        - Then, the Waker shall not be posted
+//    - When the Waker is registered and the sink ENDs
+//        - Then, the Waker shall be posted
+
+using msec = std::chrono::milliseconds;
+const std::string addr_a = "test_a";
+const std::string addr_b = "test_b";
+
+SCENARIO ("waitAll() waits on several sources at once.",
+          "[Source, Helpers, Concurrency]") {
+
+    GIVEN ("Two sinks of different types, each with a blocking source") {
+
+        oat::Sink<int> sink_a;
+        auto sink_b = std::unique_ptr<oat::Sink<uint64_t>>(
+            new oat::Sink<uint64_t>());
+
+        sink_a.bind(addr_a);
+        sink_b->bind(addr_b);
+        int *shared_a = sink_a.retrieve();
+        uint64_t *shared_b = sink_b->retrieve();
+
+        oat::Source<int> source_a;
+        oat::Source<uint64_t> source_b;
+        source_a.touch(addr_a);
+        source_b.touch(addr_b);
+        source_a.connect();
+        source_b.connect();
+
+        std::vector<oat::SourceSync *> sources {&source_a, &source_b};
+        int a = 0;
+        uint64_t b = 0;
+        auto read = [&](size_t i) {
+            if (i == 0)
+                a = *source_a.retrieve();
+            else
+                b = *source_b.retrieve();
+        };
+
+        WHEN ("waitAll() is called and only the second sink writes") {
+
+            auto fut = std::async(std::launch::async, [&] {
+                return oat::waitAll(sources, read);
+            });
+
+            sink_b->wait();
+            *shared_b = 3;
+            sink_b->post();
+
+            THEN ("waitAll() shall block, but release the second sink before "
+                  "the first writes") {
+
+                // The second sink can only write again once its source posts
+                auto next_b = std::async(std::launch::async, [&] {
+                    sink_b->wait();
+                    *shared_b = 4;
+                    sink_b->post();
+                });
+
+                REQUIRE (next_b.wait_for(msec(100)) == std::future_status::ready);
+                REQUIRE (fut.wait_for(msec(0)) != std::future_status::ready);
+
+                sink_a.wait();
+                *shared_a = 1;
+                sink_a.post();
+
+                REQUIRE (fut.wait_for(msec(100)) == std::future_status::ready);
+                REQUIRE (fut.get() == oat::NodeState::SINK_BOUND);
+                REQUIRE (a == 1);
+                REQUIRE (b == 3);
+            }
+        }
+
+        WHEN ("waitAll() is called with a timeout and only the first sink writes") {
+
+            sink_a.wait();
+            *shared_a = 1;
+            sink_a.post();
+
+            auto state = oat::waitAll(sources, read, msec(20));
+
+            THEN ("waitAll() shall time out having read and released the first") {
+                REQUIRE (state == oat::NodeState::UNDEFINED);
+                REQUIRE (a == 1);
+                REQUIRE (b == 0);
+
+                auto next_a = std::async(std::launch::async, [&] {
+                    sink_a.wait();
+                    sink_a.post();
+                });
+                REQUIRE (next_a.wait_for(msec(100)) == std::future_status::ready);
+            }
+        }
+
+        WHEN ("The second sink ENDs during waitAll()") {
+
+            auto fut = std::async(std::launch::async, [&] {
+                return oat::waitAll(sources, read);
+            });
+
+            sink_a.wait();
+            *shared_a = 1;
+            sink_a.post();
+
+            std::this_thread::sleep_for(msec(5));
+            sink_b.reset();
+
+            THEN ("waitAll() shall return END") {
+                REQUIRE (fut.wait_for(msec(100)) == std::future_status::ready);
+                REQUIRE (fut.get() == oat::NodeState::END);
+                REQUIRE (a == 1);
+            }
+        }
+    }
+}
+
+SCENARIO ("Sinks post the Waker registered with a source.",
+          "[Source, Helpers]") {
+
+    GIVEN ("A sink with a blocking source and a Waker") {
+
+        auto sink = std::unique_ptr<oat::Sink<int>>(new oat::Sink<int>());
+        sink->bind(addr_a);
+
+        oat::Source<int> source;
+        source.touch(addr_a);
+        source.connect();
+
+        oat::Waker waker;
+        REQUIRE (waker.valid());
+
+        auto write = [&] {
+            sink->wait();
+            sink->post();
+        };
+
+        WHEN ("The Waker is registered with the source and the sink writes") {
+
+            REQUIRE (source.set_waker(waker.id()));
+            write();
+
+            THEN ("The Waker shall be posted") {
+                REQUIRE (waker.wait(msec(0)));
+            }
+        }
+
+        WHEN ("The Waker is registered and then unregistered") {
+
+            source.set_waker(waker.id());
+            source.set_waker(oat::Waker::NONE);
+            write();
+
+            THEN ("The Waker shall not be posted") {
+                REQUIRE (!waker.wait(msec(0)));
+            }
+        }
+
+        WHEN ("The Waker is registered and the sink ENDs") {
+
+            source.set_waker(waker.id());
+            sink.reset();
+
+            THEN ("The Waker shall be posted") {
+                REQUIRE (waker.wait(msec(0)));
+            }
+        }
+    }
+}